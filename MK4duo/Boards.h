@@ -141,3 +141,8 @@
  * SAMD21J18
  */
 #define BOARD_MINITRONICS_V2  2706    // Minitronics v2.0
+
+/**
+ * Linux native simulator
+ */
+#define BOARD_LINUX_NATIVE    9000    // Firmware as a host process, see src/platform/HAL_LINUX
@@ -88,6 +88,29 @@
  */
 #define BLOCK_BUFFER_SIZE 16
 
+/**
+ * Look-ahead window of the planner.
+ * A new block can raise the entry speed of the blocks planned before it.
+ * The planner goes back until an entry speed does not change, and never
+ * more than this number of blocks. With a big BLOCK_BUFFER_SIZE a window
+ * of 8-16 blocks keeps constant the time to plan a block, the older blocks
+ * keep the speed they already have.
+ * 0 for the whole buffer.
+ */
+#define PLANNER_LOOKAHEAD_WINDOW 0
+
+/**
+ * Integer trapezoid
+ * Compute the trapezoid of the blocks in 32 bit integer math. The junction
+ * and the entry and exit speeds of the blocks stay in float math.
+ * The result is the same of the float math within one step.
+ * The blocks faster than 65535 steps/s still use the float math.
+ * PLANNER_INTEGER_TRAPEZOID_CHECK runs both and reports any difference on the serial,
+ * for the native simulator (buildroot/bin/planner_equivalence).
+ */
+//#define PLANNER_INTEGER_TRAPEZOID
+//#define PLANNER_INTEGER_TRAPEZOID_CHECK
+
 /**
  * The ASCII buffer for receiving from the serial:
  * For Arduino DUE setting bufsize to 8.
@@ -167,13 +190,42 @@
  */
 //#define EMERGENCY_PARSER
 
+/**
+ * Binary stream mode (M576 S1), reported by M115 as BINARY_STREAM
+ * The host sends many commands in a frame with a CRC32 and it gets an "ok"
+ * for each frame, see feature/binary_stream/binary_stream.h.
+ * A bad frame gets the "Resend:" of the ASCII lines.
+ * With SD support M28 B1 uploads a file in the same frames, reported by M115
+ * as BINARY_UPLOAD, and M28 B1 R1 resumes it.
+ * The host can send BINARY_STREAM_WINDOW frames ahead of their "ok",
+ * without a flow control (a native USB has it) RX_BUFFER_SIZE must hold them.
+ * Spend BINARY_FRAME_SIZE + 11 bytes of SRAM, and 512 bytes more for
+ * the SD upload block with SD support.
+ */
+//#define BINARY_STREAM
+#define BINARY_STREAM_WINDOW 4
+#define BINARY_FRAME_SIZE 512
+
 /**
  * Spend 28 bytes of SRAM to optimize the GCode parser
  */
 //#define FASTER_GCODE_PARSER
 
 /**
- * Spend more bytes of SRAM to optimize the GCode execute
+ * Tokenize the GCode lines when they are queued, not when they run.
+ * The parameters are stored with the line, the values already converted,
+ * so seen and value don't scan the line and call strtod/strtol again.
+ * Lines with a string argument are still parsed as text.
+ * Spend 20 + 4 * GCODE_TOKEN_PARAMS bytes of SRAM for each BUFSIZE line.
+ * Requires FASTER_GCODE_PARSER
+ */
+//#define GCODE_TOKENIZER
+// Maximum parameters with a value in a tokenized line
+#define GCODE_TOKEN_PARAMS 8
+
+/**
+ * Spend more bytes of flash to optimize the GCode execute
+ * G and M codes are found in tables indexed by the code number, the index is in PROGMEM
  */
 //#define FASTER_GCODE_EXECUTE
 
@@ -80,6 +80,11 @@
 // Subsegment per line 10 - xxx
 #define DELTA_SEGMENTS_PER_LINE 20
 
+// Adaptive segmentation: the segments are as long as keep the towers within
+// this error (mm) of their curve, the segments above are the upper bound.
+// Long moves near the centre take a few segments. 0 for fixed segments.
+#define DELTA_SEGMENT_ERROR 0
+
 // NOTE: All following values for DELTA_* MUST be floating point,
 // so always have a decimal point in them.
 //
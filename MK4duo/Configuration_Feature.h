@@ -1364,6 +1364,18 @@
 // Use CRC checks and retries on the SD communication.
 //#define SD_CHECK_AND_RETRY
 
+//
+// SD CARD: BLOCK READ
+//
+// Read the printed file in blocks of 512 bytes, not one character at a time.
+// The line ends are searched in the block and the plain characters are
+// copied at once. Spend 512 bytes of SRAM for each block buffer.
+//#define SD_BLOCK_READ
+// Block buffers (2 to 16). While the planner or the command buffer is full
+// the idle loop loads the next blocks of the file ahead, so the card is not
+// read when the commands are wanted. 4 or more is good with slow cards.
+#define SD_READ_BUFFERS 2
+
 //
 // Show extended directory including file length.
 // Don't use this with Pronterface
@@ -1719,6 +1731,60 @@
 /***************************************************************************************/
 
 
+/***********************************************************************
+ ************************* Step port output ****************************
+ ***********************************************************************
+ *                                                                     *
+ * Only for Arduino DUE                                                *
+ * The step pins of the drivers are resolved to their port and bit     *
+ * when the driver pins are set, and a step pulse writes all the axes  *
+ * on a port at once. Faster steps, and the axes of a port step        *
+ * together. Not for DUAL X CARRIAGE or SQUARE WAVE STEPPING.          *
+ *                                                                     *
+ ***********************************************************************/
+//#define STEP_PORT_OUTPUT
+/***********************************************************************/
+
+
+/***********************************************************************
+ ************************ Deferred step pulse **************************
+ ***********************************************************************
+ *                                                                     *
+ * The stepper ISR does not wait for the end of a step pulse or for    *
+ * the next pulse of a double / quad step. Each edge is an event of    *
+ * the ISR at its time, and the CPU runs the planner and the serial    *
+ * in between. For drivers with a long MINIMUM STEPPER PULSE.          *
+ * An edge due sooner than the ISR window, 8us on AVR and 1us on DUE,  *
+ * runs at the end of the window, the pulse is never shorter.          *
+ * Not for LASER.                                                      *
+ *                                                                     *
+ ***********************************************************************/
+//#define DEFERRED_STEP_PULSE
+/***********************************************************************/
+
+
+/***********************************************************************
+ ************************** Step chunk queue ***************************
+ ***********************************************************************
+ *                                                                     *
+ * Only for 32 bit boards                                              *
+ * The main loop computes the speed of the next planned blocks and     *
+ * queues the step intervals in chunks, the stepper ISR takes them     *
+ * from there and does not compute the acceleration.                   *
+ *                                                                     *
+ * STEP_CHUNK_BUFFER_SIZE: Chunks, power of 2, 12 bytes each.          *
+ * STEP_CHUNK_BLOCKS:      Blocks queued ahead of the running one.     *
+ * STEP_CHUNK_MAX_ERROR:   Timer ticks a step can be off the computed  *
+ *                         time, 0 for the steps of the ISR.           *
+ *                                                                     *
+ ***********************************************************************/
+//#define STEP_CHUNK_QUEUE
+#define STEP_CHUNK_BUFFER_SIZE 128
+#define STEP_CHUNK_BLOCKS        4
+#define STEP_CHUNK_MAX_ERROR     2
+/***********************************************************************/
+
+
 /***********************************************************************
  ********************** Direction Stepper Delay ************************
  ***********************************************************************
@@ -1870,6 +1936,12 @@
 #define N_ARC_CORRECTION   25   // Number of intertpolated segments between corrections
 //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
 //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
+// Queue the arcs as arc blocks, one per quadrant, instead of the segments.
+// The planner plans the speed on the curve and the stepper cuts the chords
+// while it runs, within half a step of the arc, in fixed point with no FPU.
+// 32 bit cartesian only. With the leveling on, an arc out of the soft endstops
+// or a radius over 4194304 steps, the segments are used.
+//#define ARC_BLOCKS
 
 // Moves with fewer segments than this will be ignored and joined with the next movement
 #define MIN_STEPS_PER_SEGMENT 6
@@ -2094,6 +2166,20 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ******************************** Stepper profiler ***************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Time the stepper ISR phases, the ISR latency, the missed step deadlines, idle() and   *
+ * the temperature manager, to tell if a stuttering print is CPU, SD or serial bound.    *
+ * M353 reports, M353 S<seconds> auto reports every S seconds, M353 R resets.            *
+ * NOTE: Requires about 400 bytes of SRAM.                                               *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define STEPPER_PROFILER
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  *********************************** Debug Feature ***************************************
  *****************************************************************************************
@@ -74,6 +74,10 @@
 
 // Uncomment the following line to enable cubic bezier curve movement with the G5 code
 // #define G5_BEZIER
+// Uncomment the following line to plan the G5 curve as one curve: the chords join
+// without a corner, the curvature limits the speed and the chords are kept close
+// enough for the junction deviation or the jerk
+//#define G5_BEZIER_CURVE
 
 #define LASER_WATTS 40.0
 #define LASER_DIAMETER 0.1        // milimeters
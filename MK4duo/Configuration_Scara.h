@@ -84,6 +84,11 @@
 // If movement is choppy try lowering this value
 #define SCARA_SEGMENTS_PER_SECOND 100
 
+// Segments of a fixed time, the arm angles of a segment updated from the last one
+// with a small angle step and resynced with the exact transform every RESYNC segments
+//#define SCARA_INCREMENTAL_SEGMENTS
+#define SCARA_RESYNC_SEGMENTS 16
+
 // Precise lengths of inner (shoulder) and outer (elbow) support arms
 #define SCARA_LINKAGE_1 200 // mm
 #define SCARA_LINKAGE_2 200 // mm
@@ -106,6 +106,17 @@
 #define T9_R25    100000.0  // Resistance in Ohms @ 25°C
 #define T9_BETA     4036.0  // Beta Value (K)
 
+// Convert the thermistor readings (1-9) with a table built from the M305 parameters,
+// one lookup and one interpolation in place of the Steinhart-Hart equation.
+// The table has THERMISTOR_TABLE_STEPS points (1, 2, 4, 8 or 16) for each octave of the
+// reading from both ends of the range, the error is under 0.7C with 4 and under 0.2C with 8.
+// Each thermistor uses about 170 bytes of SRAM on AVR (4 steps) or 460 bytes on 32 bit (8 steps).
+//#define THERMISTOR_TABLE
+//#define THERMISTOR_TABLE_STEPS 8
+// Compute the tables of the stock thermistors 1-9 at compile time in flash and use no SRAM.
+// A thermistor set by M305 away from the stock parameters then uses the equation.
+//#define THERMISTOR_TABLE_PROGMEM
+
 // Enable this for support DHT sensor for temperature e Humidity DHT11, DHT21 or DHT22.
 //#define DHT_SENSOR
 // Set Type DHT 11 for DHT11, 21 for DHT21, 22 for DHT22
@@ -231,6 +242,23 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ************************** ADC continuous scan ************************
+ ***********************************************************************
+ *                                                                     *
+ * Only for Arduino DUE                                                *
+ * A timer starts a scan of the analog inputs 2000 times a second and  *
+ * the PDC stores the samples in RAM, the 1 ms tick does not read the  *
+ * ADC any more. It uses TC0 channel 2, no hardware PWM on pin 58, 92. *
+ * The temperature task averages all the samples of the full buffers.  *
+ * ADC_SCAN_SAMPLES are the samples of a buffer, 4 buffers in RAM.     *
+ *                                                                     *
+ ***********************************************************************/
+//#define ADC_SCAN
+#define ADC_SCAN_SAMPLES 256
+/***********************************************************************/
+
+
 /***********************************************************************
  ********************** PID Settings - HOTEND **************************
  ***********************************************************************
@@ -252,6 +280,14 @@
 // is more then PID FUNCTIONAL RANGE then the PID will be shut off and the heater will be set to min/max.
 #define PID_FUNCTIONAL_RANGE 10
 
+// The temperatures are read and the PID outputs computed PID_FREQUENCY times a second, 1 to 50 Hz.
+// Every heater keeps its own sample clock, the same Kp, Ki and Kd work at any rate.
+#define PID_FREQUENCY 10
+
+// Time constant (s) of the low-pass filter of the derivative term.
+// Longer is smoother, shorter reacts faster to a fan or a flow change.
+#define PID_DTERM_FILTER 1.0
+
 #define PID_AUTOTUNE_MENU // Add PID Autotune to the LCD "Temperature" menu to run M303 and apply the result.
 
 // this adds an experimental additional term to the heating power, proportional to the extrusion speed.
@@ -267,6 +303,32 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ***************** Model Predictive Control - HOTEND *******************
+ ***********************************************************************
+ *                                                                     *
+ * A thermal model of the hotend drives the heater in place of the     *
+ * PID. The output feeds forward the heat lost to the part cooling fan *
+ * and to the filament of the moves in the planner, so a fast move     *
+ * does not make the temperature sag.                                  *
+ * M306 U2 selects the model for a hotend.                             *
+ *                                                                     *
+ * Set the heater power, then "M303 H0 S210 M1 U1" identifies the rest *
+ * of the model but the filament heat and stores it in EEPROM.         *
+ *                                                                     *
+ ***********************************************************************/
+//#define MODEL_PREDICTIVE_CONTROL
+
+#define MODEL_HEATER_POWER  40.0    // (W) heater power at full PWM
+#define MODEL_CAPACITY      16.7    // (J/K) heat capacity of the hotend
+#define MODEL_LOSS           0.07   // (W/K) heat loss to the ambient
+#define MODEL_FAN_LOSS       0.1    // (W/K) more heat loss with the part cooling fan at full speed
+#define MODEL_FILAMENT_HEAT  0.0135 // (J/K) heat to melt a mm of filament, 1.75 mm. For 2.85 mm 0.036
+#define MODEL_RESPONSE       2.0    // (s) time constant of the sensor, the dead time of the hotend
+#define MODEL_AMBIENT_TEMP  25      // (degC)
+/***********************************************************************/
+
+
 /***********************************************************************
  ************************ PID Settings - BED ***************************
  ***********************************************************************
@@ -124,6 +124,8 @@
 #include "src/core/planner/planner.h"
 #include "src/core/endstop/endstops.h"
 #include "src/core/stepper/stepper.h"
+#include "src/core/stepper/stepper_profiler.h"
+#include "src/core/stepper/step_compressor.h"
 #include "src/core/heater/sensor/thermistor.h"
 #include "src/core/heater/heater.h"
 #include "src/core/temperature/temperature.h"
@@ -154,6 +156,7 @@
 
 // Feature modules
 #include "src/feature/emergency_parser/emergency_parser.h"
+#include "src/feature/binary_stream/binary_stream.h"
 #include "src/feature/probe/probe.h"
 #include "src/feature/bedlevel/bedlevel.h"
 #include "src/feature/babystep/babystep.h"
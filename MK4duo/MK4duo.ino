@@ -96,7 +96,7 @@
  * M25  - Pause SD print. (Requires SDSUPPORT)
  * M26  - Set SD position in bytes (M26 S12345). (Requires SDSUPPORT)
  * M27  - Report SD print status. With S[bool] set the SD status auto-report. (Requires SDSUPPORT) 
- * M28  - Start SD write (M28 filename.g). (Requires SDSUPPORT)
+ * M28  - Start SD write (M28 filename.g). B1 upload in binary frames, R1 resume the upload. (Requires SDSUPPORT and BINARY_STREAM for B)
  * M29  - Stop SD write. (Requires SDSUPPORT)
  * M30  - Delete file from SD (M30 filename.g). (Requires SDSUPPORT)
  * M31  - Get the time since the start of SD Print
@@ -292,6 +292,7 @@
  * M569 - Stepper driver control X[bool] Y[bool] Z[bool] T[extruders] E[bool] set direction,
  *          D[long] set direction delay, P[int] set minimum pulse, R[long] set maximum rate, Q[bool] Enable/Disable double/quad stepping.
  * M575 - Change serial baud rate P[Port index] B[Baudrate]
+ * M576 - Binary stream mode S[1 frames|0 ASCII lines] (Requires BINARY_STREAM)
  * M595 - Set AD595 or AD8495 O[offset] and S[gain]
  * M600 - Pause for filament change T[toolhead] X[pos] Y[pos] Z[relative lift]
  *        E[initial retract] U[Retract distance] L[Extrude distance] S[new temp] B[Number of beep]
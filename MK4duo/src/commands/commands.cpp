@@ -71,7 +71,7 @@ void Commands::advance_queue() {
   #if HAS_SD_SUPPORT
 
     if (card.isSaving()) {
-      gcode_t command = buffer_ring.peek();
+      gcode_t &command = buffer_ring.peek_front();
       if (is_M29(command.gcode)) {
         // M29 closes the file
         card.finishWrite();
@@ -102,7 +102,7 @@ void Commands::advance_queue() {
   #endif // !HAS_SD_SUPPORT
 
   // The buffer_ring may be reset by a command handler or by code invoked by idle() within a handler
-  buffer_ring.dequeue();
+  buffer_ring.release();
 
 }
 
@@ -290,7 +290,7 @@ Heater* Commands::get_target_heater() {
 /** Private Function */
 void Commands::ok_to_send() {
 
-  gcode_t tmp = buffer_ring.peek();
+  const gcode_t &tmp = buffer_ring.peek_front();
 
   if (tmp.s_port < 0 || !tmp.send_ok) return;
 
@@ -298,7 +298,7 @@ void Commands::ok_to_send() {
   SERIAL_STR(OK);
 
   #if ENABLED(ADVANCED_OK)
-    char* p = tmp.gcode;
+    const char* p = tmp.gcode;
     if (*p == 'N') {
       SERIAL_CHR(' ');
       SERIAL_CHR(*p++);
@@ -334,6 +334,20 @@ void Commands::get_serial() {
     }
   #endif
 
+  #if ENABLED(BINARY_STREAM)
+    // Nothing is read until the M576 queued switches the mode, unless it was cleared
+    if (binstream.hold) {
+      if (buffer_ring.isEmpty()) binstream.hold = false;
+      else return;
+    }
+
+    // The commands left of a frame and the frame timeout need no new byte
+    if (binstream.port >= 0) {
+      get_stream();
+      if (binstream.hold) return;
+    }
+  #endif
+
   /**
    * Loop while serial characters are incoming and the buffer_ring is not full
    */
@@ -346,6 +360,14 @@ void Commands::get_serial() {
       last_command_ms = millis();
       printer.max_inactivity_ms = millis();
 
+      #if ENABLED(BINARY_STREAM)
+        if (i == binstream.port) {
+          get_stream();
+          if (binstream.hold) return;
+          continue;
+        }
+      #endif
+
       if ((c = Com::serialRead(i)) < 0) continue;
 
       char serial_char = c;
@@ -408,41 +430,17 @@ void Commands::get_serial() {
           }
         #endif
 
-        // Movement commands alert when stopped
-        if (printer.isStopped()) {
-          char *gpos = strrchr(command, 'G');
-          if (gpos) {
-            switch (strtol(gpos + 1, nullptr, 10)) {
-              case 0:
-              case 1:
-              #if ENABLED(ARC_SUPPORT)
-                case 2:
-                case 3:
-              #endif
-              #if ENABLED(G5_BEZIER)
-                case 5:
-              #endif
-                SERIAL_LM(ER, MSG_ERR_STOPPED);
-                LCD_MESSAGEPGM(MSG_STOPPED);
-                break;
-            }
-          }
-        }
-
-        #if DISABLED(EMERGENCY_PARSER)
-          // If command was e-stop process now
-          if (strcmp(command, "M108") == 0) {
-            printer.setWaitForHeatUp(false);
-            #if ENABLED(ULTIPANEL)
-              printer.setWaitForUser(false);
-            #endif
-          }
-          if (strcmp(command, "M112") == 0) printer.kill(PSTR("M112"));
-          if (strcmp(command, "M410") == 0) printer.quickstop_stepper();
-        #endif
+        check_serial_line(command);
 
         // Add the command to the buffer_ring
         enqueue(serial_line_buffer[i], true, i);
+
+        #if ENABLED(BINARY_STREAM)
+          if (is_mode_switch(command)) {
+            binstream.hold = true;
+            return;
+          }
+        #endif
       }
       else if (serial_count[i] >= MAX_CMD_SIZE - 1) {
         // Keep fetching, but ignore normal characters beyond the max length
@@ -461,11 +459,166 @@ void Commands::get_serial() {
   }
 }
 
+#if ENABLED(BINARY_STREAM)
+
+  void Commands::get_stream() {
+
+    #if HAS_SD_SUPPORT
+      if (binstream.upload) {
+        get_upload();
+        return;
+      }
+    #endif
+
+    const int8_t port = binstream.port;
+
+    for (;;) {
+
+      switch (binstream.receive(gcode_last_N + 1)) {
+        case FRAME_NONE: return;
+        case FRAME_ERROR: gcode_line_error(binstream.error, port); return;
+        case FRAME_STALE: stream_ok(port); continue;
+        default: break;
+      }
+
+      // The commands of the frame, one line number each
+      const char * const payload = (const char*)binstream.payload();
+      const uint16_t length = binstream.length();
+      while (binstream.index < length) {
+
+        if (buffer_ring.isFull() || binstream.hold) return;
+
+        const char * const command = &payload[binstream.index];
+        binstream.index += strlen(command) + 1;
+        gcode_last_N++;
+
+        if (!*command) continue;
+
+        check_serial_line(command);
+
+        // Too long commands are cut as the lines
+        char * const gcode = buffer_ring.peek_back().gcode;
+        strncpy(gcode, command, MAX_CMD_SIZE - 1);
+        gcode[MAX_CMD_SIZE - 1] = '\0';
+        commit_command(false, port);
+
+        if (is_mode_switch(command)) binstream.hold = true;
+      }
+
+      binstream.release();
+      stream_ok(port);
+
+      if (binstream.hold) return;
+    }
+  }
+
+  void Commands::stream_ok(const int8_t port) {
+    SERIAL_PORT(port);
+    SERIAL_STR(OK);
+    SERIAL_MV(" N", gcode_last_N);
+    SERIAL_MV(" P", BLOCK_BUFFER_SIZE - planner.moves_planned() - 1);
+    SERIAL_MV(" B", BUFSIZE - buffer_ring.count());
+    SERIAL_EOL();
+    SERIAL_PORT(-1);
+  }
+
+  #if HAS_SD_SUPPORT
+
+    void Commands::get_upload() {
+
+      const int8_t port = binstream.port;
+
+      for (;;) {
+
+        switch (binstream.receive(card.upload_pos)) {
+          case FRAME_NONE:
+            // The host is gone, the file keeps what was written for a resume
+            if (binstream.idle(BINARY_UPLOAD_TIMEOUT)) {
+              card.finishUpload();
+              binstream.end_upload();
+            }
+            return;
+          case FRAME_ERROR:
+            // The file position to send again
+            SERIAL_PORT(port);
+            SERIAL_STR(ER);
+            SERIAL_STR(binstream.error);
+            SERIAL_EV(card.upload_pos);
+            while (Com::serialRead(port) != -1);
+            SERIAL_LV(RESEND, card.upload_pos);
+            SERIAL_PORT(-1);
+            return;
+          case FRAME_STALE:
+            SERIAL_PORT(port);
+            SERIAL_LMV(OK, " N", card.upload_pos);
+            SERIAL_PORT(-1);
+            continue;
+          default: break;
+        }
+
+        // The frame with no payload ends the file
+        const uint16_t length = binstream.length();
+        const bool failed = length && !card.upload(binstream.payload(), length);
+
+        binstream.release();
+
+        SERIAL_PORT(port);
+        if (!length || failed) card.finishUpload();
+        if (!failed) SERIAL_LMV(OK, " N", card.upload_pos);
+        SERIAL_PORT(-1);
+
+        if (!length || failed) {
+          binstream.end_upload();
+          return;
+        }
+      }
+    }
+
+  #endif // HAS_SD_SUPPORT
+
+#endif // BINARY_STREAM
+
+void Commands::check_serial_line(const char * const command) {
+
+  // Movement commands alert when stopped
+  if (printer.isStopped()) {
+    const char *gpos = strrchr(command, 'G');
+    if (gpos) {
+      switch (strtol(gpos + 1, nullptr, 10)) {
+        case 0:
+        case 1:
+        #if ENABLED(ARC_SUPPORT)
+          case 2:
+          case 3:
+        #endif
+        #if ENABLED(G5_BEZIER)
+          case 5:
+        #endif
+          SERIAL_LM(ER, MSG_ERR_STOPPED);
+          LCD_MESSAGEPGM(MSG_STOPPED);
+          break;
+      }
+    }
+  }
+
+  #if DISABLED(EMERGENCY_PARSER)
+    // If command was e-stop process now
+    if (strcmp(command, "M108") == 0) {
+      printer.setWaitForHeatUp(false);
+      #if ENABLED(ULTIPANEL)
+        printer.setWaitForUser(false);
+      #endif
+    }
+    if (strcmp(command, "M112") == 0) printer.kill(PSTR("M112"));
+    if (strcmp(command, "M410") == 0) printer.quickstop_stepper();
+  #endif
+
+}
+
 #if HAS_SD_SUPPORT
 
   void Commands::get_sdcard() {
 
-    static char sd_line_buffer[MAX_CMD_SIZE];
     static bool stop_buffering = false,
                 sd_comment_mode = false;
 
@@ -490,6 +643,26 @@ void Commands::get_serial() {
     uint16_t sd_count = 0;
     bool card_eof = card.eof();
     while (!buffer_ring.isFull() && !card_eof && !stop_buffering) {
+      // The line is read straight into the free slot of the buffer_ring
+      char * const sd_line_buffer = buffer_ring.peek_back().gcode;
+
+      #if ENABLED(SD_BLOCK_READ)
+        // The plain characters up to a line end, comment or stop are taken at once
+        const char *run;
+        const uint16_t len = card.get_run(run);
+        if (len) {
+          if (!sd_comment_mode && sd_count < MAX_CMD_SIZE - 1) {
+            const uint16_t count = MIN(len, uint16_t(MAX_CMD_SIZE - 1 - sd_count));
+            memcpy(&sd_line_buffer[sd_count], run, count);
+            sd_count += count;
+          }
+          card.skip(len);
+          last_command_ms = millis();
+          printer.max_inactivity_ms = millis();
+          continue;
+        }
+      #endif
+
       const int16_t n = card.get();
       char sd_char = (char)n;
       card_eof = card.eof();
@@ -499,13 +672,27 @@ void Commands::get_serial() {
           || sd_char == '\n'  || sd_char == '\r'
           || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
       ) {
+        if (sd_char == '#') stop_buffering = true;
+
+        sd_comment_mode = false; // for new command
+
+        // Queue the line before the end of file, that synchronizes and runs idle()
+        if (sd_count) {
+          sd_line_buffer[sd_count] = '\0'; // terminate string
+          sd_count = 0; // clear sd line buffer
+
+          commit_command(false, -2); // Port -2 for SD non answer and no send ok.
+
+          #if HAS_SD_RESTART
+            restart.cmd_sdpos = card.getIndex();
+          #endif
+        }
+
         if (card_eof) {
 
           card.printingHasFinished();
 
-          if (IS_SD_PRINTING())
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
+          if (!IS_SD_PRINTING()) {
             SERIAL_EM(MSG_FILE_PRINTED);
             #if ENABLED(PRINTER_EVENT_LEDS)
               LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
@@ -528,21 +715,6 @@ void Commands::get_serial() {
         else if (n == -1) {
           SERIAL_LM(ER, MSG_SD_ERR_READ);
         }
-        if (sd_char == '#') stop_buffering = true;
-
-        sd_comment_mode = false; // for new command
-
-        // Skip empty lines and comments
-        if (!sd_count) continue;
-
-        sd_line_buffer[sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
-
-        enqueue(sd_line_buffer, false, -2); // Port -2 for SD non answer and no send ok.
-
-        #if HAS_SD_RESTART
-          restart.cmd_sdpos = card.getIndex();
-        #endif
 
       }
       else if (sd_count >= MAX_CMD_SIZE - 1) {
@@ -564,7 +736,8 @@ void Commands::get_serial() {
 
 void Commands::process_next() {
 
-  gcode_t cmd = buffer_ring.peek();
+  // Parsed in place, the command stays in the buffer_ring until advance_queue() releases it
+  gcode_t &cmd = buffer_ring.peek_front();
 
   if (printer.debugEcho()) {
     SERIAL_PORT(cmd.s_port);
@@ -574,15 +747,19 @@ void Commands::process_next() {
   printer.reset_move_ms(); // Keep steppers powered
 
   // Parse the next command in the buffer_ring
-  parser.parse(cmd.gcode);
+  #if ENABLED(GCODE_TOKENIZER)
+    if (cmd.token.letter)
+      parser.load(cmd.gcode, cmd.token);
+    else
+  #endif
+      parser.parse(cmd.gcode);
   process_parsed();
 
 }
 
 void Commands::unknown_error() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(buffer_ring.peek_front().s_port);
   #endif
   SERIAL_SMV(ECHO, MSG_UNKNOWN_COMMAND, parser.command_ptr);
   SERIAL_CHR('"');
@@ -618,15 +795,22 @@ bool Commands::enqueue_one(const char * cmd) {
 
 bool Commands::enqueue(const char * cmd, bool say_ok/*=false*/, int8_t port/*=-2*/) {
   if (*cmd == ';' || buffer_ring.isFull()) return false;
-  gcode_t temp_cmd;
-  strcpy(temp_cmd.gcode, cmd);
-  temp_cmd.s_port = port;
-  temp_cmd.send_ok = say_ok;
+  strcpy(buffer_ring.peek_back().gcode, cmd);
+  commit_command(say_ok, port);
+  return true;
+}
+
+void Commands::commit_command(const bool say_ok, const int8_t port) {
+  gcode_t &command = buffer_ring.peek_back();
+  command.s_port = port;
+  command.send_ok = say_ok;
+  #if ENABLED(GCODE_TOKENIZER)
+    parser.tokenize(command.gcode, command.token);
+  #endif
   #if HAS_SD_RESTART
     restart.set_sdpos();
   #endif
-  buffer_ring.enqueue(temp_cmd);
-  return true;
+  buffer_ring.commit();
 }
 
 bool Commands::process_injected() {
@@ -675,25 +859,13 @@ void Commands::process_parsed(const bool say_ok/*=true*/) {
 
       case 'G': {
         const uint16_t code_num = parser.codenum;
-        G_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(GCode_Table) - 1;
 
         if (code_num <= 1) { // Execute directly the most common Gcodes
           EXECUTE_G0_G1(code_num);
         }
-        else if (WITHIN(code_num, GCode_Table[start].code, GCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (GCode_Table[middle].code == code_num) {
-              GCode_Table[middle].command(); // Command found, execute it
-              break;
-            }
-            else if (GCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
-          }
+        else if (code_num < GCODE_INDEX_SIZE) {
+          const gcode_index_t index = code_index_read(&GCode_Index.index[code_num]);
+          if (index != GCODE_INDEX_NONE) GCode_Table[index].command(); // Command found, execute it
         }
       }
       break;
@@ -704,7 +876,11 @@ void Commands::process_parsed(const bool say_ok/*=true*/) {
                     middle  = 0,
                     end     = COUNT(MCode_Table) - 1;
 
-        if (WITHIN(code_num, MCode_Table[start].code, MCode_Table[end].code)) {
+        if (code_num < MCODE_INDEX_SIZE) {
+          const mcode_index_t index = code_index_read(&MCode_Index.index[code_num]);
+          if (index != MCODE_INDEX_NONE) MCode_Table[index].command(); // Command found, execute it
+        }
+        else if (WITHIN(code_num, MCode_Table[start].code, MCode_Table[end].code)) {
           while (start <= end) {
             middle = (start + end) >> 1;
             if (MCode_Table[middle].code == code_num) {
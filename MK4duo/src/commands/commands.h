@@ -35,6 +35,9 @@ struct gcode_t {
   int8_t  s_port  = -1;         // Serial port for print information:
                                 //    -1 for all port
                                 //    -2 for SD or null port
+  #if ENABLED(GCODE_TOKENIZER)
+    gcode_token_t token;        // Tokenized when queued
+  #endif
 };
 
 class Commands {
@@ -49,10 +52,11 @@ class Commands {
      * GCode Command Buffer Ring
      * A simple ring buffer of BUFSIZE command strings.
      *
-     * Commands are copied into this buffer by the command injectors
-     * (immediate, serial, sd card) and they are processed sequentially by
-     * the main loop. The process_next function parses the next
-     * command and hands off execution to individual handler functions.
+     * Commands are written in place into the free slot of this buffer by
+     * the command injectors (immediate, serial, sd card) and they are
+     * processed sequentially by the main loop. The process_next function
+     * parses the next command in its slot and hands off execution to
+     * individual handler functions.
      */
     static Circular_Queue<gcode_t, BUFSIZE> buffer_ring;
 
@@ -187,6 +191,30 @@ class Commands {
      */
     static void get_serial();
 
+    #if ENABLED(BINARY_STREAM)
+      /**
+       * Queue the commands of the binary frames of the stream port,
+       * "ok" to the host for each frame queued.
+       */
+      static void get_stream();
+
+      // "ok" with the last line number and the free planner and buffer slots
+      static void stream_ok(const int8_t port);
+
+      #if HAS_SD_SUPPORT
+        /**
+         * Write the binary frames of the stream port to the SD file,
+         * "ok" to the host for each frame written.
+         */
+        static void get_upload();
+      #endif
+    #endif
+
+    /**
+     * Alert and emergency checks of a command from the serial
+     */
+    static void check_serial_line(const char * const command);
+
     /**
      * Get commands from the SD Card until the command buffer is full
      * or until the end of the file is reached. The special character '#'
@@ -219,6 +247,12 @@ class Commands {
      */
     static bool enqueue(const char * cmd, bool say_ok=false, int8_t port=-2);
 
+    /**
+     * Queue the command written in the free slot of the buffer_ring.
+     * The buffer_ring must not be full.
+     */
+    static void commit_command(const bool say_ok, const int8_t port);
+
     /**
      * Process the next "immediate" command
      */
@@ -236,6 +270,19 @@ class Commands {
       return strstr_P(cmd, PSTR("M29"));
     }
 
+    #if ENABLED(BINARY_STREAM)
+      /**
+       * Search M576 or M28 B command, they switch the serial mode
+       */
+      FORCE_INLINE static bool is_mode_switch(const char * const cmd) {
+        return strstr_P(cmd, PSTR("M576"))
+          #if HAS_SD_SUPPORT
+            || strstr_P(cmd, PSTR("M28 B"))
+          #endif
+        ;
+      }
+    #endif
+
 };
 
 extern Commands commands;
@@ -132,7 +132,7 @@ inline void gcode_M305(void) {
     }
   }
 
-  act->data.sensor.CalcDerivedParameters();
+  act->update_sensor();
 
 }
 
@@ -45,12 +45,22 @@
  *    F[int}    PWM frequency
  *    L[int]    Min temperature
  *    O[int]    Max temperature
- *    U[bool]   Use Pid/bang bang
+ *    U[int]    Use bang bang 0, Pid 1, Model 2 (only hotends with MODEL_PREDICTIVE_CONTROL)
  *    I[bool]   Hardware Inverted
  *    R[bool]   Thermal Protection
  *    P[int]    Heater Pin
  *    Q[bool]   PWM Hardware
  *
+ *   With MODEL_PREDICTIVE_CONTROL, the model of a hotend:
+ *
+ *    W[float]  Heater power, W
+ *    K[float]  Heat capacity, J/K
+ *    N[float]  Heat loss to the ambient, W/K
+ *    V[float]  More heat loss with the part cooling fan at full speed, W/K
+ *    E[float]  Heat of a mm of filament, J/K
+ *    D[float]  Sensor time constant, s
+ *    M[float]  Ambient temperature
+ *
  */
 inline void gcode_M306(void) {
 
@@ -60,7 +70,11 @@ inline void gcode_M306(void) {
 
   #if DISABLED(DISABLE_M503)
     // No arguments? Show M306 report.
-    if (!parser.seen("ABCFLO") && !parser.seen("UIRPQ")) {
+    if (!parser.seen("ABCFLO") && !parser.seen("UIRPQ")
+      #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+        && !parser.seen("WKNVEDM")
+      #endif
+    ) {
       act->print_M306();
       return;
     }
@@ -73,8 +87,20 @@ inline void gcode_M306(void) {
   act->data.maxtemp       = parser.intval('O', act->data.maxtemp);
   act->data.freq          = MIN(parser.intval('F', act->data.freq), MAX_PWM_FREQUENCY);
 
-  if (parser.seen('U'))
-    act->setUsePid(parser.value_bool());
+  if (parser.seen('U')) {
+    const uint8_t mode = parser.has_value() ? parser.value_byte() : 1;
+    #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+      if (mode == 2 && act->type != IS_HOTEND)
+        SERIAL_LM(ER, "?Model control (U2) is only for the hotends");
+      else {
+        act->setUseModel(mode == 2);
+        act->setUsePid(mode == 1);
+        act->restart_sample();
+      }
+    #else
+      act->setUsePid(mode == 1);
+    #endif
+  }
   if (parser.seen('I'))
     act->setHWinvert(parser.value_bool());
   if (parser.seen('Q'))
@@ -88,6 +114,19 @@ inline void gcode_M306(void) {
     act->data.pin = parser.value_pin();
   }
 
+  #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+    if (act->type == IS_HOTEND) {
+      model_data_t &model = act->data.model;
+      if (parser.seenval('W')) model.power          = MAX(parser.value_float(), 1.0f);
+      if (parser.seenval('K')) model.capacity       = MAX(parser.value_float(), 0.1f);
+      if (parser.seenval('N')) model.loss           = MAX(parser.value_float(), 0.0f);
+      if (parser.seenval('V')) model.fan_loss       = MAX(parser.value_float(), 0.0f);
+      if (parser.seenval('E')) model.filament_heat  = MAX(parser.value_float(), 0.0f);
+      if (parser.seenval('D')) model.response       = MAX(parser.value_float(), 0.0f);
+      if (parser.seenval('M')) model.ambient        = parser.value_float();
+    }
+  #endif
+
   act->data.pid.update();
 
 }
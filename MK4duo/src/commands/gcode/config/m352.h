@@ -81,4 +81,8 @@ inline void gcode_M352(void) {
     }
   }
 
+  #if ENABLED(STEP_PORT_OUTPUT)
+    stepper.init_step_ports();
+  #endif
+
 }
@@ -0,0 +1,52 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEPPER_PROFILER)
+
+#define CODE_M353
+
+/**
+ * M353: Stepper profiler - report the stepper ISR and main loop timing.
+ *
+ *  M353          - Report the figures since the last reset.
+ *  M353 R        - Reset the figures.
+ *  M353 S<sec>   - Auto report each S seconds, for the last S seconds. S0 to stop.
+ *
+ */
+inline void gcode_M353(void) {
+  if (parser.seen('R'))
+    profiler.reset();
+  else if (parser.seenval('S')) {
+    profiler.set_auto_report(parser.value_byte());
+    profiler.reset();
+  }
+  else
+    profiler.report();
+}
+
+#endif // STEPPER_PROFILER
@@ -40,6 +40,8 @@ inline void gcode_M44(void) {
     SERIAL_EMV("Number of G-codes available: ", (int)(COUNT(GCode_Table) + 2));
     SERIAL_MV("G-code table static memory consumption: ", (int)sizeof(GCode_Table));
     SERIAL_EM(" bytes.");
+    SERIAL_MV("G-code index static memory consumption: ", (int)sizeof(GCode_Index));
+    SERIAL_EM(" bytes.");
 
     SERIAL_EM("Complete list of G-codes available for this machine:");
     SERIAL_EM("G0");
@@ -53,6 +55,8 @@ inline void gcode_M44(void) {
     SERIAL_EMV("Number of M-codes available: ", (int)COUNT(MCode_Table));
     SERIAL_MV("M-code table static memory consumption: ", (int)sizeof(MCode_Table));
     SERIAL_EM(" bytes.");
+    SERIAL_MV("M-code index static memory consumption: ", (int)sizeof(MCode_Index));
+    SERIAL_EM(" bytes.");
 
     SERIAL_EM("Complete list of M-codes available for this machine:");
     for (M_CODE_TYPE index = 0; index < (COUNT(MCode_Table) - 1); index++) {
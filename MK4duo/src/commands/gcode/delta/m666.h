@@ -37,6 +37,7 @@
  *    R = Delta Radius
  *    S = Segments per Second
  *    L = Segments per Line
+ *    E = Segment error, 0 fixed Segments per Second
  *    A = Tower A: Diagonal Rod Adjust
  *    B = Tower B: Diagonal Rod Adjust
  *    C = Tower C: Diagonal Rod Adjust
@@ -68,6 +69,7 @@ inline void gcode_M666(void) {
   if (parser.seen('R')) mechanics.data.radius                   = parser.value_linear_units();
   if (parser.seen('S')) mechanics.data.segments_per_second      = parser.value_ushort();
   if (parser.seen('L')) mechanics.data.segments_per_line        = parser.value_byte();
+  if (parser.seen('E')) mechanics.data.segment_error            = parser.value_linear_units();
   if (parser.seen('A')) mechanics.data.diagonal_rod_adj[A_AXIS] = parser.value_linear_units();
   if (parser.seen('B')) mechanics.data.diagonal_rod_adj[B_AXIS] = parser.value_linear_units();
   if (parser.seen('C')) mechanics.data.diagonal_rod_adj[C_AXIS] = parser.value_linear_units();
@@ -82,6 +84,7 @@ inline void gcode_M666(void) {
 
   NOLESS(mechanics.data.segments_per_line, 10);
   NOMORE(mechanics.data.segments_per_line, 255);
+  NOLESS(mechanics.data.segment_error, 0);
 
   LOOP_XYZ(i) {
     if (parser.seen(axis_codes[i])) {
@@ -98,6 +98,7 @@
 // Debug Commands
 #include "debug/m43.h"
 #include "debug/m44_pre_table.h"          // Debug Code Info
+#include "debug/m353.h"                   // Stepper profiler
 #include "debug/m1000.h"                   // Debug GCODE Parser
 
 // Delta Commands
@@ -149,6 +150,7 @@
 #include "host/m530.h"                    // Enables explicit printing mode
 #include "host/m531.h"                    // Define filename being printed
 #include "host/m532_m73.h"                // Update current print state progress
+#include "host/m576.h"                     // Binary stream mode
 #include "host/m876.h"                    // Host Prompt Response
 
 // LCD Commands
@@ -266,6 +268,7 @@
   // Table for G and M code
   #include "table_gcode.h"
   #include "table_mcode.h"
+  #include "table_index.h"
 
   // Include m44 post define table for debugging
   #include "debug/m44_post_table.h"
@@ -116,6 +116,20 @@ inline void gcode_M115(void) {
     SERIAL_CAP("EMERGENCY_PARSER:0");
   #endif
 
+  // BINARY_STREAM (M576)
+  #if ENABLED(BINARY_STREAM)
+    SERIAL_CAP("BINARY_STREAM:1");
+  #else
+    SERIAL_CAP("BINARY_STREAM:0");
+  #endif
+
+  // BINARY_UPLOAD (M28 B1)
+  #if ENABLED(BINARY_STREAM) && HAS_SD_SUPPORT
+    SERIAL_CAP("BINARY_UPLOAD:1");
+  #else
+    SERIAL_CAP("BINARY_UPLOAD:0");
+  #endif
+
   // CHAMBER_TEMPERATURE (M141, M191)
   #if HAS_CHAMBERS
     SERIAL_CAP("CHAMBER_TEMPERATURE:1");
@@ -0,0 +1,69 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(BINARY_STREAM)
+
+#define CODE_M576
+
+/**
+ * M576: Binary stream mode
+ *
+ *  S1  Read the commands of this serial port in binary frames
+ *  S0  Read the commands as ASCII lines
+ *
+ *  The serial is not read from the M576 queued to its run,
+ *  the host can send the frames or the lines right after it.
+ *  Report "Stream:1 W<window> F<frame size>" or "Stream:0".
+ */
+inline void gcode_M576(void) {
+
+  const int8_t port = commands.buffer_ring.peek_front().s_port;
+
+  if (parser.seen('S')) {
+    if (!parser.value_bool())
+      binstream.stop();
+    else if (port >= 0)
+      binstream.start(port);
+    else
+      SERIAL_LM(ER, "M576 S1 needs a serial port");
+  }
+
+  binstream.hold = false;
+
+  SERIAL_PORT(port);
+  if (binstream.port >= 0) {
+    SERIAL_MV("Stream:1 W", int(BINARY_STREAM_WINDOW));
+    SERIAL_EMV(" F", int(BINARY_FRAME_SIZE));
+  }
+  else
+    SERIAL_EM("Stream:0");
+  SERIAL_PORT(-1);
+
+}
+
+#endif // BINARY_STREAM
@@ -33,6 +33,87 @@
   #define N_ARC_CORRECTION 1
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Queue the arc as arc blocks, a block for each quadrant of the circle,
+   * so the axes do not change direction within a block. The arc is not
+   * split closer than half a step to an axis of the circle.
+   *
+   * Return false to trace the segments, with the leveling on, with the
+   * arc out of the soft endstops, with a block too short or with a radius
+   * too long for the fixed point of the stepper.
+   */
+  static bool plan_arc_blocks(const float (&cart)[XYZE], const float (&center)[2], const float &radius,
+    const float &angular_travel, const float &mm_of_travel, const AxisEnum p_axis, const AxisEnum q_axis
+  ) {
+
+    #if HAS_LEVELING
+      if (bedlevel.flag.leveling_active) return false;
+    #endif
+
+    const float max_spm = MAX(mechanics.data.axis_steps_per_mm[p_axis], mechanics.data.axis_steps_per_mm[q_axis]);
+    if (radius * max_spm >= float(ARC_MAX_STEPS)) return false;
+
+    const float (&start)[XYZE] = mechanics.current_position;
+    const float quadrant    = RADIANS(90),
+                start_angle = ATAN2(start[q_axis] - center[1], start[p_axis] - center[0]),
+                end_angle   = start_angle + angular_travel,
+                // Closer to an axis than half a step, r * (1 - cos(a)) < 1/2 step
+                min_angle   = SQRT(1.0f / (radius * max_spm));
+
+    // End angles of the blocks, at most 4 axes crossed and the end
+    float block_angle[6];
+    uint8_t blocks = 0;
+    if (angular_travel > 0) {
+      for (float a = (FLOOR(start_angle / quadrant) + 1) * quadrant; a < end_angle - min_angle; a += quadrant)
+        if (a > start_angle + min_angle) block_angle[blocks++] = a;
+    }
+    else {
+      for (float a = (CEIL(start_angle / quadrant) - 1) * quadrant; a > end_angle + min_angle; a -= quadrant)
+        if (a < start_angle - min_angle) block_angle[blocks++] = a;
+    }
+    block_angle[blocks++] = end_angle;
+
+    // End positions of the blocks, the axes are monotonic within a block so the ends bound it
+    float block_end[6][XYZE];
+    for (uint8_t b = 0; b < blocks; b++) {
+      float (&pos)[XYZE] = block_end[b];
+      if (b < blocks - 1) {
+        const float part = (block_angle[b] - start_angle) / angular_travel;
+        LOOP_XYZE(i) pos[i] = start[i] + (cart[i] - start[i]) * part;
+        pos[p_axis] = center[0] + radius * cos(block_angle[b]);
+        pos[q_axis] = center[1] + radius * sin(block_angle[b]);
+      }
+      else
+        COPY_ARRAY(pos, cart);
+
+      float limited[XYZE];
+      COPY_ARRAY(limited, pos);
+      endstops.apply_motion_limits(limited);
+      LOOP_XYZ(i) if (limited[i] != pos[i]) return false;
+
+      const float (&prev)[XYZE] = b ? block_end[b - 1] : start;
+      if (ABS(pos[p_axis] - prev[p_axis]) * mechanics.data.axis_steps_per_mm[p_axis] < MIN_STEPS_PER_SEGMENT
+       && ABS(pos[q_axis] - prev[q_axis]) * mechanics.data.axis_steps_per_mm[q_axis] < MIN_STEPS_PER_SEGMENT
+      ) return false;
+    }
+
+    const float fr_mm_s = MMS_SCALED(mechanics.feedrate_mm_s);
+
+    for (uint8_t b = 0; b < blocks; b++) {
+      const float angle = block_angle[b] - (b ? block_angle[b - 1] : start_angle);
+      if (!planner.buffer_arc(block_end[b], b ? block_end[b - 1] : start, center, angle, p_axis, q_axis,
+        fr_mm_s, tools.extruder.active, mm_of_travel * angle / angular_travel)
+      ) break;
+    }
+
+    COPY_ARRAY(mechanics.current_position, cart);
+    return true;
+  }
+
+#endif // ARC_BLOCKS
+
 /**
  * Plan an arc in 2 dimensions
  *
@@ -41,6 +122,7 @@
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
  * options for G2/G3 arc generation. In future these options may be GCode tunable.
+ * With ARC_BLOCKS the arc is queued as arc blocks, if it may be.
  */
 void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t clockwise) {
 
@@ -93,6 +175,12 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
               mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
   if (mm_of_travel < 0.001f) return;
 
+  #if ENABLED(ARC_BLOCKS)
+    // Queue the arc as arc blocks, if it may be
+    const float center[2] = { center_P, center_Q };
+    if (plan_arc_blocks(cart, center, radius, angular_travel, mm_of_travel, p_axis, q_axis)) return;
+  #endif
+
   uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
   if (segments == 0) segments = 1;
 
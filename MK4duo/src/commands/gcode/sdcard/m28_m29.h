@@ -33,8 +33,44 @@
 
 /**
  * M28: Start SD Write
+ *
+ *  With BINARY_STREAM, before the file name:
+ *   B1   Upload the file in binary frames from this serial port
+ *   R1   Go on with the file on the card, report where with "Upload:<position>"
  */
-inline void gcode_M28(void) { card.startWrite(parser.string_arg, false); }
+inline void gcode_M28(void) {
+
+  #if ENABLED(BINARY_STREAM)
+
+    binstream.hold = false;
+
+    char *p = parser.string_arg;
+    bool binary = false, resume = false;
+    while ((p[0] == 'B' || p[0] == 'R') && NUMERIC(p[1])) {
+      if (p[0] == 'B') binary = p[1] > '0';
+      else resume = p[1] > '0';
+      p += 2;
+      while (*p == ' ') p++;
+    }
+
+    if (binary) {
+      const int8_t port = commands.buffer_ring.peek_front().s_port;
+      if (port < 0)
+        SERIAL_LM(ER, "M28 B1 needs a serial port");
+      else if (card.startUpload(p, resume)) {
+        binstream.start(port, true);
+        SERIAL_PORT(port);
+        SERIAL_MV("Upload:", card.upload_pos);
+        SERIAL_EMV(" F", int(BINARY_FRAME_SIZE));
+        SERIAL_PORT(-1);
+      }
+      return;
+    }
+
+  #endif
+
+  card.startWrite(parser.string_arg, false);
+}
 
 /**
  * M29: Stop SD Write
@@ -0,0 +1,109 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * table_index.h
+ *
+ * Dense index of GCode_Table and MCode_Table, built at compile time from
+ * the same tables. The code number is the position in the index, which
+ * holds the position of the command in its table, so a command is found
+ * with one load instead of a binary search.
+ *
+ * The M codes from MCODE_INDEX_LIMIT up (M1000, M9999) are few and far,
+ * they are still searched in MCode_Table.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#define MCODE_INDEX_LIMIT 1000
+
+// Positions of a table, 8 bit if the table is small enough
+template<bool WIDE> struct code_index_type { typedef uint8_t type; };
+template<> struct code_index_type<true> { typedef uint16_t type; };
+
+typedef code_index_type<(COUNT(GCode_Table) >= 0xFF)>::type gcode_index_t;
+typedef code_index_type<(COUNT(MCode_Table) >= 0xFF)>::type mcode_index_t;
+
+// Position of a code not in the table
+#define GCODE_INDEX_NONE  gcode_index_t(COUNT(GCode_Table))
+#define MCODE_INDEX_NONE  mcode_index_t(COUNT(MCode_Table))
+
+// Sequence 0...N-1 of code numbers, split in halves to keep the template depth low
+template<uint16_t... I> struct code_index_list {};
+
+template<class A, class B> struct code_index_concat;
+template<uint16_t... A, uint16_t... B>
+struct code_index_concat<code_index_list<A...>, code_index_list<B...>> {
+  typedef code_index_list<A..., uint16_t(sizeof...(A) + B)...> type;
+};
+
+template<uint16_t N> struct code_index_sequence {
+  typedef typename code_index_concat<typename code_index_sequence<N / 2>::type, typename code_index_sequence<N - N / 2>::type>::type type;
+};
+template<> struct code_index_sequence<0> { typedef code_index_list<> type; };
+template<> struct code_index_sequence<1> { typedef code_index_list<0> type; };
+
+template<typename T, uint16_t N> struct code_index_t {
+  T index[N];
+};
+
+// Binary search in the tables, at compile time
+constexpr gcode_index_t gcode_search(const uint16_t code, const uint16_t start, const uint16_t end) {
+  return start >= end                                   ? GCODE_INDEX_NONE
+       : GCode_Table[(start + end) >> 1].code == code  ? gcode_index_t((start + end) >> 1)
+       : GCode_Table[(start + end) >> 1].code < code   ? gcode_search(code, ((start + end) >> 1) + 1, end)
+                                                        : gcode_search(code, start, (start + end) >> 1);
+}
+
+constexpr mcode_index_t mcode_search(const uint16_t code, const uint16_t start, const uint16_t end) {
+  return start >= end                                   ? MCODE_INDEX_NONE
+       : MCode_Table[(start + end) >> 1].code == code  ? mcode_index_t((start + end) >> 1)
+       : MCode_Table[(start + end) >> 1].code < code   ? mcode_search(code, ((start + end) >> 1) + 1, end)
+                                                        : mcode_search(code, start, (start + end) >> 1);
+}
+
+// The index covers the codes up to the last one of the table, or the last below the limit
+constexpr uint16_t mcode_index_size(const uint16_t count) {
+  return !count ? 0
+       : MCode_Table[count - 1].code < MCODE_INDEX_LIMIT ? MCode_Table[count - 1].code + 1
+       : mcode_index_size(count - 1);
+}
+
+#define GCODE_INDEX_SIZE  (GCode_Table[COUNT(GCode_Table) - 1].code + 1)
+#define MCODE_INDEX_SIZE  mcode_index_size(COUNT(MCode_Table))
+
+template<uint16_t... I>
+constexpr code_index_t<gcode_index_t, sizeof...(I)> gcode_index(code_index_list<I...>) {
+  return { { gcode_search(I, 0, COUNT(GCode_Table))... } };
+}
+
+template<uint16_t... I>
+constexpr code_index_t<mcode_index_t, sizeof...(I)> mcode_index(code_index_list<I...>) {
+  return { { mcode_search(I, 0, COUNT(MCode_Table))... } };
+}
+
+constexpr code_index_t<gcode_index_t, GCODE_INDEX_SIZE> GCode_Index PROGMEM = gcode_index(code_index_sequence<GCODE_INDEX_SIZE>::type());
+constexpr code_index_t<mcode_index_t, MCODE_INDEX_SIZE> MCode_Index PROGMEM = mcode_index(code_index_sequence<MCODE_INDEX_SIZE>::type());
+
+FORCE_INLINE uint8_t  code_index_read(const uint8_t * const p)  { return pgm_read_byte(p); }
+FORCE_INLINE uint16_t code_index_read(const uint16_t * const p) { return pgm_read_word(p); }
@@ -41,6 +41,7 @@
  *    C[cycles]   minimum 3 (default 5)
  *    R[method]   0-3 (default 0)
  *    U[bool]     with a non-zero value will apply the result to current settings
+ *    M[bool]     identify the model of a hotend in place of the PID (MODEL_PREDICTIVE_CONTROL)
  *
  */
 inline void gcode_M303(void) {
@@ -60,6 +61,21 @@ inline void gcode_M303(void) {
     return;
   }
 
+  #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+    if (parser.boolval('M')) {
+      if (act->type != IS_HOTEND) {
+        SERIAL_LM(ER, "The model is only for hotends");
+        return;
+      }
+      SERIAL_MV("Model autotune Hotend:", act->data.ID);
+      SERIAL_MV(" Temp:", target);
+      if (store) SERIAL_MSG(" Apply into EEPROM");
+      SERIAL_EOL();
+      act->model_autotune(target, store);
+      return;
+    }
+  #endif
+
   SERIAL_EM(MSG_PID_AUTOTUNE_START);
   lcdui.reset_alert_level();
   LCD_MESSAGEPGM(MSG_PID_AUTOTUNE_START);
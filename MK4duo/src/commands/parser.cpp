@@ -58,6 +58,12 @@ uint16_t GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if ENABLED(GCODE_TOKENIZER)
+  const gcode_token_t *GCodeParser::command_token;
+  const gcode_value_t *GCodeParser::value_token;
+  bool GCodeParser::value_is_int;
+#endif
+
 // Create a global instance of the GCodeParser singleton
 GCodeParser parser;
 
@@ -78,6 +84,10 @@ void GCodeParser::reset() {
     codebits = 0;                     // No codes yet
     //ZERO(param);                    // No parameters (should be safe to comment out this line)
   #endif
+  #if ENABLED(GCODE_TOKENIZER)
+    command_token = nullptr;          // Parsed as text
+    value_token = nullptr;            // No token value
+  #endif
 }
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
@@ -247,6 +257,176 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if ENABLED(GCODE_TOKENIZER)
+
+  /**
+   * Tokenize a line as parse() does, converting the values once.
+   * The line is left to the text parser if it has a string argument
+   * for the M code, a parameter that is not A-Z, more than
+   * GCODE_TOKEN_PARAMS values or a value that doesn't fit an int32.
+   */
+  bool GCodeParser::tokenize(char * const text, gcode_token_t &token) {
+
+    token.letter = 0; // Parse as text
+
+    char *p = text;
+
+    // Skip spaces
+    while (*p == ' ') ++p;
+
+    // Skip N[-0-9] if included in the command line
+    if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
+      p += 2;                   // skip N[-0-9]
+      while (NUMERIC(*p)) ++p;  // skip [0-9]*
+      while (*p == ' ') ++p;    // skip [ ]*
+    }
+
+    token.command_offset = p - text;
+
+    // Get the command letter, which must be G, M, or T
+    const char letter = *p++;
+    if (letter != 'G' && letter != 'M' && letter != 'T') return false;
+
+    // The command ends before the asterisk and trailing whitespace,
+    // load() nullifies them as parse() does
+    const char *end = strchr(p, '*');
+    token.star_offset = 0;
+    if (end) {
+      const char *starpos = end - 1;
+      while (*starpos == ' ') --starpos;
+      token.star_offset = starpos + 1 - text;
+    }
+    else
+      end = p + strlen(p);
+
+    // Skip spaces to get the numeric part
+    while (*p == ' ') ++p;
+
+    // No command code number, or a MMU2 T?/Tx/Tc
+    if (!NUMERIC(*p)) return false;
+
+    // Get the code number - integer digits only
+    uint16_t num = 0;
+    do {
+      num *= 10, num += *p++ - '0';
+    } while (NUMERIC(*p));
+    token.codenum = num;
+
+    #if USE_GCODE_SUBCODES
+      token.subcode = 0;
+      if (*p == '.') {
+        p++;
+        while (NUMERIC(*p))
+          token.subcode *= 10, token.subcode += *p++ - '0';
+      }
+    #endif
+
+    // Skip all spaces to get to the first argument, or null
+    while (*p == ' ') ++p;
+
+    // String commands, the parameters are not scanned
+    if (letter == 'M') switch (num) {
+      case 23: case 28: case 30: case 32: case 117: case 118: case 928: return false;
+      default: break;
+    }
+
+    token.string_offset = 0;
+    token.codebits = token.valuebits = token.intbits = 0;
+
+    uint8_t count = 0;
+    while (p < end) {
+
+      const char code = *p++;
+
+      // Not A-Z, it would be the string_arg or a lowercase parameter
+      if (!WITHIN(code, 'A', 'Z')) return false;
+
+      while (*p == ' ') ++p;                    // skip spaces between parameters & values
+
+      const uint8_t ind = LETTER_BIT(code);
+      SBI32(token.codebits, ind);
+
+      if (p < end && valid_float(p)) {
+
+        // Index of the value, in letter order
+        uint8_t i = 0;
+        for (uint8_t b = 0; b < ind; b++) if (TEST32(token.valuebits, b)) i++;
+
+        // A new value makes room for itself, a repeated letter takes the last value
+        if (!TEST32(token.valuebits, ind)) {
+          if (count == GCODE_TOKEN_PARAMS) return false;
+          for (uint8_t n = count++; n > i; n--) token.value[n] = token.value[n - 1];
+          SBI32(token.valuebits, ind);
+        }
+
+        // Integers are stored as they are, value_long() gets the same of strtol()
+        const char * const digits = (*p == '-' || *p == '+') ? p + 1 : p;
+        uint8_t len = 0;
+        while (NUMERIC(digits[len])) len++;
+
+        if (len && digits[len] != '.') {
+          if (len > 9) return false;
+          token.value[i].l = strtol(p, NULL, 10);
+          SBI32(token.intbits, ind);
+        }
+        else {
+          const float f = text_float(p);
+          if (ABS(f) >= 2147483648.0f) return false;
+          token.value[i].f = f;
+          CBI32(token.intbits, ind);
+        }
+      }
+      else {
+
+        // A repeated letter without a value drops the last value, as parse() does
+        if (TEST32(token.valuebits, ind)) {
+          uint8_t i = 0;
+          for (uint8_t b = 0; b < ind; b++) if (TEST32(token.valuebits, b)) i++;
+          for (uint8_t n = i, c = --count; n < c; n++) token.value[n] = token.value[n + 1];
+          CBI32(token.valuebits, ind);
+          CBI32(token.intbits, ind);
+        }
+
+        if (!token.string_offset)               // No value? First time, keep as string_arg
+          token.string_offset = p - 1 - text;
+      }
+
+      if (!WITHIN(*p, 'A', 'Z')) {              // Another parameter right away?
+        while (p < end && DECIMAL_SIGNED(*p)) p++;  // Skip over the value section of a parameter
+        while (*p == ' ') ++p;                  // Skip over all spaces
+      }
+    }
+
+    token.letter = letter;
+    return true;
+  }
+
+  // Populate all fields from a tokenized line, as parse() would do
+  void GCodeParser::load(char * const text, const gcode_token_t &token) {
+
+    reset(); // No codes to report
+
+    if (token.star_offset) text[token.star_offset] = '\0';
+
+    command_ptr = text + token.command_offset;
+    command_letter = token.letter;
+    codenum = token.codenum;
+    #if USE_GCODE_SUBCODES
+      subcode = token.subcode;
+    #endif
+    if (token.string_offset) string_arg = text + token.string_offset;
+
+    codebits = token.codebits;
+    command_token = &token;
+
+    // Index of each value in the token, for seen()
+    uint8_t i = 0, ind = 0;
+    for (uint32_t bits = token.valuebits; bits; bits >>= 1, ind++)
+      if (bits & 1) param[ind] = i++;
+  }
+
+#endif // GCODE_TOKENIZER
+
 pin_t GCodeParser::value_pin() {
   const pin_t pin = (int8_t)value_int();
   return pin;
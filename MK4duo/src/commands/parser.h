@@ -29,6 +29,36 @@
 
 //#define DEBUG_GCODE_PARSER
 
+#if ENABLED(GCODE_TOKENIZER)
+
+  // Parameter value converted when the line is queued
+  union gcode_value_t {
+    float   f;
+    int32_t l;
+  };
+
+  /**
+   * Tokenized GCode line, kept with its text in the command buffer ring
+   * The offsets are from the start of the text, 0 for none
+   * letter is 0 if the line must be parsed as text
+   */
+  struct gcode_token_t {
+    char          letter;           // G, M, or T
+    uint8_t       command_offset,   // command_ptr, after the line number
+                  string_offset,    // string_arg
+                  star_offset;      // End of the command, before the checksum
+    uint16_t      codenum;          // 123
+    #if USE_GCODE_SUBCODES
+      uint8_t     subcode;          // .1
+    #endif
+    uint32_t      codebits,         // Parameters seen
+                  valuebits,        // Parameters with a value
+                  intbits;          // Values stored as int32
+    gcode_value_t value[GCODE_TOKEN_PARAMS]; // Values in letter order
+  };
+
+#endif
+
 /**
  * Parser Gcode
  *
@@ -36,6 +66,9 @@
  *  - FASTER_GCODE_PARSER:
  *    - Flags existing params (1 bit each)
  *    - Stores value offsets (1 byte each)
+ *  - GCODE_TOKENIZER:
+ *    - Tokenize a line when it is queued, converting the values once
+ *    - Load the tokenized line in place of parsing it
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
@@ -72,11 +105,17 @@ class GCodeParser {
 
     #if ENABLED(FASTER_GCODE_PARSER)
       static uint32_t codebits;   // Parameters pre-scanned
-      static uint8_t param[26];   // For A-Z, offsets into command args
+      static uint8_t param[26];   // For A-Z, offsets into command args or indexes of the token values
     #else
       static char *command_args;  // Args start here, for slow scan
     #endif
 
+    #if ENABLED(GCODE_TOKENIZER)
+      static const gcode_token_t *command_token;  // Loaded token, nullptr if parsed as text
+      static const gcode_value_t *value_token;    // Set by seen, used to fetch the token value
+      static bool value_is_int;                   // The token value is an int32
+    #endif
+
   public: /** Public Function */
 
     #if ENABLED(DEBUG_GCODE_PARSER)
@@ -124,6 +163,14 @@ class GCodeParser {
         const uint8_t ind = LETTER_BIT(c);
         if (ind >= COUNT(param)) return false; // Only A-Z
         const bool b = TEST32(codebits, ind);
+        #if ENABLED(GCODE_TOKENIZER)
+          if (b && command_token) {
+            const bool v = TEST32(command_token->valuebits, ind);
+            value_token = v ? &command_token->value[param[ind]] : (gcode_value_t*)NULL;
+            value_is_int = TEST32(command_token->intbits, ind);
+            return true;
+          }
+        #endif
         if (b) {
           char * const ptr = command_ptr + param[ind];
           value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
@@ -196,35 +243,65 @@ class GCodeParser {
     // This uses 54 bytes of SRAM to speed up seen/value
     static void parse(char * p);
 
+    #if ENABLED(GCODE_TOKENIZER)
+
+      // Tokenize a line of GCode, without changing the parser state
+      // Return false if the line must be parsed as text
+      static bool tokenize(char * const text, gcode_token_t &token);
+
+      // Populate all fields from a tokenized line
+      static void load(char * const text, const gcode_token_t &token);
+
+    #endif
+
     // Code value pointer was set
-    FORCE_INLINE static bool has_value() { return value_ptr != NULL; }
+    FORCE_INLINE static bool has_value() {
+      #if ENABLED(GCODE_TOKENIZER)
+        if (command_token) return value_token != NULL;
+      #endif
+      return value_ptr != NULL;
+    }
 
     // Seen a parameter with a value
     static inline bool seenval(const char c) { return seen(c) && has_value(); }
 
     // Float removes 'E' to prevent scientific notation interpretation
-    static inline float value_float() {
-      if (value_ptr) {
-        char *e = value_ptr;
-        for (;;) {
-          const char c = *e;
-          if (c == '\0' || c == ' ') break;
-          if (c == 'E' || c == 'e') {
-            *e = '\0';
-            const float ret = strtof(value_ptr, NULL);
-            *e = c;
-            return ret;
-          }
-          ++e;
+    static inline float text_float(char * const ptr) {
+      char *e = ptr;
+      for (;;) {
+        const char c = *e;
+        if (c == '\0' || c == ' ') break;
+        if (c == 'E' || c == 'e') {
+          *e = '\0';
+          const float ret = strtof(ptr, NULL);
+          *e = c;
+          return ret;
         }
-        return strtof(value_ptr, NULL);
+        ++e;
       }
-      return 0;
+      return strtof(ptr, NULL);
+    }
+
+    static inline float value_float() {
+      #if ENABLED(GCODE_TOKENIZER)
+        if (command_token) return value_token ? (value_is_int ? float(value_token->l) : value_token->f) : 0;
+      #endif
+      return value_ptr ? text_float(value_ptr) : 0;
     }
 
     // Code value as a long or ulong
-    static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-    static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+    static inline int32_t value_long() {
+      #if ENABLED(GCODE_TOKENIZER)
+        if (command_token) return value_token ? (value_is_int ? value_token->l : int32_t(value_token->f)) : 0L;
+      #endif
+      return value_ptr ? strtol(value_ptr, NULL, 10) : 0L;
+    }
+    static inline uint32_t value_ulong() {
+      #if ENABLED(GCODE_TOKENIZER)
+        if (command_token) return uint32_t(value_long());
+      #endif
+      return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL;
+    }
 
     // Code value for use as time
     static inline millis_l  value_millis()              { return value_ulong(); }
@@ -51,7 +51,7 @@
  * Keep this data structure up to date so
  * EEPROM size is known at compile time!
  */
-#define EEPROM_VERSION "MKV72"
+#define EEPROM_VERSION "MKV75"
 #define EEPROM_OFFSET 100
 
 typedef struct EepromDataStruct {
@@ -313,6 +313,9 @@ void EEPROM::post_process() {
 
   // Init Driver pins
   LOOP_DRV() if (driver[d]) driver[d]->init();
+  #if ENABLED(STEP_PORT_OUTPUT)
+    stepper.init_step_ports();
+  #endif
 
   // Make sure delta kinematics are updated before refreshing the
   // planner position so the stepper counts will be set correctly.
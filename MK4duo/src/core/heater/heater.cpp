@@ -30,10 +30,10 @@
 
 #if HAS_HEATER
 
-Heater hotends[HOTENDS]   = Heater(IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE);
-Heater beds[BEDS]         = Heater(IS_BED, BED_CHECK_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE);
-Heater chambers[CHAMBERS] = Heater(IS_CHAMBER, CHAMBER_CHECK_INTERVAL, CHAMBER_HYSTERESIS, WATCH_CHAMBER_PERIOD, WATCH_CHAMBER_INCREASE);
-Heater coolers[COOLERS]   = Heater(IS_COOLER, COOLER_CHECK_INTERVAL, COOLER_HYSTERESIS, WATCH_COOLER_PERIOD, WATCH_COOLER_INCREASE);
+Heater hotends[HOTENDS]   = ARRAY_BY_HOTENDS(Heater(IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE));
+Heater beds[BEDS]         = ARRAY_BY_BEDS(Heater(IS_BED, BED_CHECK_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE));
+Heater chambers[CHAMBERS] = ARRAY_BY_CHAMBERS(Heater(IS_CHAMBER, CHAMBER_CHECK_INTERVAL, CHAMBER_HYSTERESIS, WATCH_CHAMBER_PERIOD, WATCH_CHAMBER_INCREASE));
+Heater coolers[COOLERS]   = ARRAY_BY_N(COOLERS, Heater(IS_COOLER, COOLER_CHECK_INTERVAL, COOLER_HYSTERESIS, WATCH_COOLER_PERIOD, WATCH_COOLER_INCREASE));
 
 /** Public Function */
 void Heater::init() {
@@ -56,10 +56,12 @@ void Heater::init() {
   watch_next_ms         = 0;
   idle_timeout_ms       = 0;
   Pidtuning             = false;
+  sample_ms             = 0;
+  sampled               = false;
 
   thermal_runaway_state = TRInactive;
 
-  data.sensor.CalcDerivedParameters();
+  update_sensor();
   data.pid.update();
 
   if (printer.isRunning()) return; // All running not reinitialize
@@ -208,11 +210,7 @@ void Heater::get_output() {
     #if HAS_COOLERS
       if (type == IS_COOLER) {
         if (isUsePid()) {
-          pwm_value = data.pid.spin(current_temperature, targetTemperature
-            #if ENABLED(PID_ADD_EXTRUSION_RATE)
-              , 0xFF
-            #endif
-          );
+          pwm_value = data.pid.spin(targetTemperature, current_temperature, sample_time(), true);
         }
         else if (expired(&check_next_ms, temp_check_interval))
           pwm_value = current_temperature >= targetTemperature ? data.pid.DriveMax : 0;
@@ -220,11 +218,16 @@ void Heater::get_output() {
       else
     #endif
       {
+        #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+          if (isUseModel())
+            pwm_value = data.model.spin(targetTemperature, current_temperature, sample_time(), model_state, data.ID, pwm_value, data.pid.Max);
+          else
+        #endif
         if (isUsePid()) {
           #if ENABLED(PID_ADD_EXTRUSION_RATE)
             const uint8_t id = (type == IS_HOTEND) ? data.ID : 0xFF;
           #endif
-          pwm_value = data.pid.spin(targetTemperature, current_temperature
+          pwm_value = data.pid.spin(targetTemperature, current_temperature, sample_time(), false
             #if ENABLED(PID_ADD_EXTRUSION_RATE)
               , id
             #endif
@@ -253,6 +256,8 @@ void Heater::get_output() {
     */
 
   }
+  else
+    restart_sample();
 
 }
 
@@ -547,6 +552,203 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
 
 }
 
+#if ENABLED(MODEL_PREDICTIVE_CONTROL)
+
+  #define MODEL_AUTOTUNE_SAMPLES  32
+  #if DISABLED(MODEL_AUTOTUNE_HOLD)
+    #define MODEL_AUTOTUNE_HOLD   30
+  #endif
+
+  /**
+   * Identify the model of the hotend, the heater power must be set.
+   *
+   *  - The ambient is the temperature at the start, the hotend must be cold
+   *  - Heat at full power to the target. The exponential through three
+   *    samples of the curve gives the time constant and the loss, where
+   *    it crosses the ambient gives the dead time of the sensor
+   *  - Hold the target with the model for twice MODEL_AUTOTUNE_HOLD
+   *    seconds, the mean power of the second half refines the loss
+   *  - Hold it again with the part cooling fan at full speed, the more
+   *    power is the loss of the fan
+   */
+  void Heater::model_autotune(const float target_temp, const bool storeValues/*=false*/) {
+
+    enum ModelTuneEnum : uint8_t { TuneHeating, TuneHold, TuneFan, TuneDone };
+
+    model_data_t &model = data.model;
+
+    update_current_temperature();
+    if (current_temperature > 50) {
+      SERIAL_LM(ER, "Model autotune needs a cold hotend");
+      return;
+    }
+
+    const bool oldReport = printer.isAutoreportTemp();
+
+    thermalManager.disable_all_heaters(); // switch off all heaters.
+
+    #if HAS_FANS
+      const uint8_t old_fan_speed = fans[0].speed;
+      fans[0].set_speed(0);
+    #endif
+
+    model.ambient = current_temperature;
+
+    const float threshold = model.ambient + (target_temp - model.ambient) * 0.3f;
+
+    float     samples[MODEL_AUTOTUNE_SAMPLES],
+              tau       = 0.0,
+              sum_pwm   = 0.0,
+              sum_temp  = 0.0;
+    uint16_t  nsum      = 0;
+    uint8_t   nsamples  = 0;
+    millis_l  sample_ms = 250,
+              start_ms  = millis(),
+              first_ms  = 0,
+              next_ms   = 0,
+              hold_ms   = 0;
+    millis_s  control_ms = 0;
+
+    ModelTuneEnum phase = TuneHeating;
+
+    printer.setWaitForHeatUp(true);
+    printer.setAutoreportTemp(true);
+
+    Pidtuning = true;
+    ResetFault();
+
+    // Turn ON this heater to max power.
+    pwm_value = data.pid.Max;
+
+    while (printer.isWaitForHeatUp()) {
+
+      printer.idle();
+
+      update_current_temperature();
+
+      const millis_l now = millis();
+
+      if (phase == TuneHeating) {
+
+        // The curve past the dead time, when full every other sample is kept at twice the interval
+        if (current_temperature >= threshold && ELAPSED(now, next_ms)) {
+          if (!nsamples) first_ms = now;
+          if (nsamples == MODEL_AUTOTUNE_SAMPLES) {
+            for (uint8_t i = 0; i < MODEL_AUTOTUNE_SAMPLES / 2; i++) samples[i] = samples[i << 1];
+            nsamples = MODEL_AUTOTUNE_SAMPLES / 2;
+            sample_ms <<= 1;
+          }
+          samples[nsamples++] = current_temperature;
+          next_ms = first_ms + nsamples * sample_ms;
+        }
+
+        if (current_temperature >= target_temp) {
+          const uint8_t i3 = nsamples - 1,
+                        i1 = i3 & 1,
+                        i2 = (i1 + i3) >> 1;
+          const float   d1 = samples[i2] - samples[i1],
+                        d2 = samples[i3] - samples[i2];
+          if (nsamples < 3 || d2 <= 0 || d2 >= d1) {
+            SERIAL_LM(ER, "Model autotune failed, the heating curve does not fit");
+            break;
+          }
+          const float r         = d2 / d1,
+                      temp_inf  = samples[i1] + d1 / (1.0f - r),
+                      t1        = (first_ms + i1 * sample_ms - start_ms) * 0.001f;
+          tau             = -((i2 - i1) * sample_ms * 0.001f) / LOG(r);
+          model.loss      = model.power * data.pid.Max * (1.0f / 255.0f) / (temp_inf - model.ambient);
+          model.capacity  = tau * model.loss;
+          model.response  = MAX(t1 - tau * LOG((temp_inf - model.ambient) / (temp_inf - samples[i1])), 0.0f);
+          SERIAL_SMV(ECHO, " Time constant:", tau);
+          SERIAL_MV(" Ambient:", model.ambient);
+          SERIAL_MV(" Response:", model.response);
+          SERIAL_EOL();
+          restart_sample();
+          hold_ms = now;
+          phase = TuneHold;
+        }
+
+      }
+      else {
+
+        // Hold the target with the model, the mean of the second half
+        if (expired(&control_ms, millis_s(PID_SAMPLE_MS))) {
+          pwm_value = model.spin(target_temp, current_temperature, sample_time(), model_state, data.ID, pwm_value, data.pid.Max);
+          if (ELAPSED(now, hold_ms + MODEL_AUTOTUNE_HOLD * 1000UL)) {
+            sum_pwm += pwm_value;
+            sum_temp += current_temperature;
+            nsum++;
+          }
+        }
+
+        if (ELAPSED(now, hold_ms + 2 * MODEL_AUTOTUNE_HOLD * 1000UL) && nsum) {
+          const float hold_loss = model.power * sum_pwm * (1.0f / 255.0f) / (sum_temp - nsum * model.ambient);
+          if (phase == TuneHold) {
+            model.loss      = hold_loss;
+            model.capacity  = tau * model.loss;
+            #if HAS_FANS
+              fans[0].set_speed(255);
+              sum_pwm = sum_temp = 0.0;
+              nsum = 0;
+              hold_ms = now;
+              phase = TuneFan;
+            #else
+              phase = TuneDone;
+            #endif
+          }
+          else {
+            model.fan_loss = MAX(hold_loss - model.loss, 0.0f) / model_data_t::fan_speed();
+            phase = TuneDone;
+          }
+        }
+
+        if (phase == TuneDone) {
+          SERIAL_EM("Model autotune finished!");
+          SERIAL_SMV(ECHO, " Capacity:", model.capacity);
+          SERIAL_MV(" Loss:", model.loss, 4);
+          SERIAL_MV(" Fan loss:", model.fan_loss, 4);
+          SERIAL_MV(" Response:", model.response);
+          SERIAL_EOL();
+          SERIAL_EMV("Use the model with M306 U2 H", int(data.ID));
+          if (storeValues) eeprom.store();
+          break;
+        }
+
+      }
+
+      if (current_temperature > target_temp + MAX_OVERSHOOT_PID_AUTOTUNE) {
+        SERIAL_LM(ER, MSG_PID_TEMP_TOO_HIGH);
+        LCD_ALERTMESSAGEPGM(MSG_PID_TEMP_TOO_HIGH);
+        break;
+      }
+
+      if ((now - start_ms) > (MAX_CYCLE_TIME_PID_AUTOTUNE * 60L * 1000L)) {
+        SERIAL_LM(ER, MSG_PID_TIMEOUT);
+        LCD_ALERTMESSAGEPGM(MSG_PID_TIMEOUT);
+        break;
+      }
+
+      lcdui.update();
+
+    }
+
+    Pidtuning = false;
+
+    thermalManager.disable_all_heaters();
+
+    #if HAS_FANS
+      fans[0].set_speed(old_fan_speed);
+    #endif
+
+    printer.setWaitForHeatUp(false);
+    printer.setAutoreportTemp(oldReport);
+
+    LCD_MESSAGEPGM(WELCOME_MSG);
+
+  }
+
+#endif // MODEL_PREDICTIVE_CONTROL
+
 void Heater::print_M301() {
   if (isUsePid()) {
     const int8_t heater_id = type == IS_HOTEND ? data.ID : -type;
@@ -597,7 +799,13 @@ void Heater::print_M306() {
   const int8_t heater_id = type == IS_HOTEND ? data.ID : -type;
   SERIAL_SM(CFG, "Heater parameters: H<Heater>");
   if (heater_id < 0) SERIAL_MSG(" T<tools>");
-  SERIAL_EM(" P<Pin> A<Power Drive Min> B<Power Drive Max> C<Power Max> F<Freq> L<Min Temp> O<Max Temp> U<Use Pid 0-1> I<Hardware Inverted 0-1> R<Thermal Protection 0-1> Q<Pwm Hardware 0-1>:");
+  SERIAL_MSG(" P<Pin> A<Power Drive Min> B<Power Drive Max> C<Power Max> F<Freq> L<Min Temp> O<Max Temp>");
+  #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+    SERIAL_MSG(" U<Use Pid 0-1 Model 2>");
+  #else
+    SERIAL_MSG(" U<Use Pid 0-1>");
+  #endif
+  SERIAL_EM(" I<Hardware Inverted 0-1> R<Thermal Protection 0-1> Q<Pwm Hardware 0-1>:");
   SERIAL_SMV(CFG, "  M306 H", (int)heater_id);
   if (heater_id < 0) SERIAL_MV(" T", int(data.ID));
   SERIAL_MV(" P", data.pin);
@@ -607,12 +815,31 @@ void Heater::print_M306() {
   SERIAL_MV(" F", data.freq);
   SERIAL_MV(" L", data.mintemp);
   SERIAL_MV(" O", data.maxtemp);
-  SERIAL_MV(" U", isUsePid());
+  #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+    SERIAL_MV(" U", isUseModel() ? 2 : int(isUsePid()));
+  #else
+    SERIAL_MV(" U", isUsePid());
+  #endif
   SERIAL_MV(" I", isHWinvert());
   SERIAL_MV(" Q", isHWpwm());
   SERIAL_MV(" R", isThermalProtection());
   SERIAL_EOL();
 
+  #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+    if (type == IS_HOTEND) {
+      SERIAL_LM(CFG, "Heater model: H<Heater> W<Power> K<Capacity> N<Loss> V<Fan loss> E<Filament heat> D<Sensor response> M<Ambient>:");
+      SERIAL_SMV(CFG, "  M306 H", (int)heater_id);
+      SERIAL_MV(" W", data.model.power);
+      SERIAL_MV(" K", data.model.capacity);
+      SERIAL_MV(" N", data.model.loss, 4);
+      SERIAL_MV(" V", data.model.fan_loss, 4);
+      SERIAL_MV(" E", data.model.filament_heat, 4);
+      SERIAL_MV(" D", data.model.response);
+      SERIAL_MV(" M", data.model.ambient);
+      SERIAL_EOL();
+    }
+  #endif
+
   if (printer.debugFeature()) {
     DEBUG_SMV(DEB, " Type:", type);
     DEBUG_MV(" temp_check_interval:", temp_check_interval);
@@ -713,6 +940,13 @@ void Heater::start_watching() {
 
 }
 
+void Heater::update_sensor() {
+  data.sensor.CalcDerivedParameters();
+  #if ENABLED(THERMISTOR_TABLE)
+    sensor_table.build(data.sensor);
+  #endif
+}
+
 /** Private Function */
 // Temperature Error Handlers
 void Heater::temp_error(PGM_P const serial_msg, PGM_P const lcd_msg) {
@@ -804,4 +1038,17 @@ void Heater::update_idle_timer() {
     setIdle(true);
 }
 
+/**
+ * Seconds since the last sample of this heater,
+ * 0 for the first one and after a pause
+ */
+float Heater::sample_time() {
+  const millis_s now = millis(),
+                 elapsed_ms = now - sample_ms;
+  sample_ms = now;
+  const bool restart = !sampled || elapsed_ms > 2 * (PID_SAMPLE_MS);
+  sampled = true;
+  return restart ? 0.0f : elapsed_ms * 0.001f;
+}
+
 #endif // HAS_HEATER
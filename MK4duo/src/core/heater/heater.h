@@ -29,9 +29,10 @@
 
 #include "sensor/sensor.h"
 #include "pid/pid.h"
+#include "model/model.h"
 
 union heater_flag_t {
-  bool all;
+  uint16_t all;
   struct {
     bool  Active            : 1;
     bool  UsePid            : 1;
@@ -41,8 +42,9 @@ union heater_flag_t {
     bool  Thermalprotection : 1;
     bool  Idle              : 1;
     bool  Fault             : 1;
+    bool  UseModel          : 1;
   };
-  heater_flag_t() { all = false; }
+  heater_flag_t() { all = 0; }
 };
 
 enum HeatertypeEnum : uint8_t { IS_HOTEND, IS_BED, IS_CHAMBER, IS_COOLER };
@@ -57,6 +59,9 @@ struct heater_data_t {
                 maxtemp;
   uint16_t      freq;
   pid_data_t    pid;
+  #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+    model_data_t  model;
+  #endif
   sensor_data_t sensor;
 };
 
@@ -83,6 +88,10 @@ class Heater {
 
     float           current_temperature;
 
+    #if ENABLED(THERMISTOR_TABLE)
+      thermistor_table_t sensor_table;
+    #endif
+
     const HeatertypeEnum type;
 
   private: /** Private Parameters */
@@ -105,6 +114,14 @@ class Heater {
 
     bool            Pidtuning;
 
+    // The sample clock of the PID and of the model
+    millis_s        sample_ms;
+    bool            sampled;
+
+    #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+      model_state_t model_state;
+    #endif
+
   public: /** Public Function */
 
     void init();
@@ -119,6 +136,9 @@ class Heater {
     void check_and_power();
     
     void PID_autotune(const float target_temp, const uint8_t ncycles, const uint8_t method, const bool storeValues=false);
+    #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+      void model_autotune(const float target_temp, const bool storeValues=false);
+    #endif
     
     void print_M301();
     void print_M305();
@@ -133,7 +153,21 @@ class Heater {
     void thermal_runaway_protection();
     void start_watching();
 
-    FORCE_INLINE void update_current_temperature() { this->current_temperature = this->data.sensor.getTemperature(); }
+    // The sensor parameters are changed
+    void update_sensor();
+
+    // The PID and the model start again from the measurement
+    FORCE_INLINE void restart_sample() { sampled = false; }
+
+    FORCE_INLINE void update_current_temperature() {
+      #if ENABLED(THERMISTOR_TABLE)
+        if (this->sensor_table.ready()) {
+          this->current_temperature = this->sensor_table.getTemperature(this->data.sensor);
+          return;
+        }
+      #endif
+      this->current_temperature = this->data.sensor.getTemperature();
+    }
     FORCE_INLINE float deg_current()  { return this->current_temperature; }
     FORCE_INLINE int16_t deg_target() { return this->target_temperature;  }
     FORCE_INLINE int16_t deg_idle()   { return this->idle_temperature;    }
@@ -193,7 +227,11 @@ class Heater {
     }
     FORCE_INLINE bool isFault() { return data.flag.Fault; }
 
-    FORCE_INLINE void resetFlag() { data.flag.all = false; }
+    // Flag bit 8 Set use Model
+    FORCE_INLINE void setUseModel(const bool onoff) { data.flag.UseModel = onoff; }
+    FORCE_INLINE bool isUseModel() { return data.flag.UseModel; }
+
+    FORCE_INLINE void resetFlag() { data.flag.all = 0; }
 
     FORCE_INLINE void SwitchOff() {
       target_temperature = 0;
@@ -211,6 +249,8 @@ class Heater {
 
     void update_idle_timer();
 
+    float sample_time();
+
 };
 
 extern Heater hotends[HOTENDS];
@@ -0,0 +1,97 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * model.cpp - model predictive control of a hotend
+ */
+
+#include "../../../../MK4duo.h"
+
+#if HAS_HEATER && ENABLED(MODEL_PREDICTIVE_CONTROL)
+
+// Time constant of the correction of the model with the measurement, s
+#define MODEL_CORRECTION_TIME 1.0f
+
+uint8_t model_data_t::spin(const float target_temp, const float current_temp, const float dt, model_state_t &state, const uint8_t hotend, const uint8_t last_output, const uint8_t max) {
+
+  const float fan     = fan_speed(),
+              e_rate  = planned_e_rate(hotend, response);
+
+  if (dt <= 0.0)
+    state.block_temperature = state.sensor_temperature = current_temp;
+  else {
+    // Heat of the last sample, the planned extrusion stands for the running one
+    state.block_temperature += (power * last_output * (1.0f / 255.0f) - heat_loss(state.block_temperature, fan, e_rate)) * dt / capacity;
+    state.sensor_temperature += (state.block_temperature - state.sensor_temperature) * dt / (response + dt);
+
+    // Pull the model to the measurement
+    const float correction = (current_temp - state.sensor_temperature) * dt / (MODEL_CORRECTION_TIME + dt);
+    state.block_temperature   += correction;
+    state.sensor_temperature  += correction;
+  }
+
+  if (target_temp <= 20) return 0;
+
+  // Heat to bring the block to the target in a sample and to hold it there
+  const float sample_s  = (PID_SAMPLE_MS) * 0.001f,
+              heat      = (target_temp - state.block_temperature) * capacity / sample_s + heat_loss(target_temp, fan, e_rate);
+
+  return constrain(heat / power * 255.0f, 0, max);
+
+}
+
+float model_data_t::fan_speed() {
+  #if HAS_FANS
+    return fans[0].actual_speed() * (1.0f / 255.0f);
+  #else
+    return 0.0f;
+  #endif
+}
+
+/**
+ * The moves of the hotend within the seconds from the running one.
+ * The time of a move is taken at the nominal speed.
+ */
+float model_data_t::planned_e_rate(const uint8_t hotend, const float seconds) {
+
+  float e_mm = 0.0f, time = 0.0f;
+
+  #if HOTENDS == 1
+    UNUSED(hotend);
+  #endif
+
+  const uint8_t head = planner.block_buffer_head;
+  for (uint8_t b = planner.block_buffer_tail; b != head && time < seconds; b = BLOCK_MOD(b + 1)) {
+    const block_t * const block = &planner.block_buffer[b];
+    if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION) || block->nominal_speed_sqr <= 0) continue;
+    time += block->millimeters / SQRT(block->nominal_speed_sqr);
+    #if HOTENDS > 1
+      if (block->active_extruder != hotend) continue;
+    #endif
+    e_mm += block->steps[E_AXIS] * mechanics.steps_to_mm[E_AXIS_N(block->active_extruder)];
+  }
+
+  return time > 0 ? e_mm / MAX(time, seconds) : 0.0f;
+
+}
+
+#endif // HAS_HEATER && MODEL_PREDICTIVE_CONTROL
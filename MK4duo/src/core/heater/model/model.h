@@ -0,0 +1,82 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * model.h - model predictive control of a hotend
+ *
+ * The hotend is a heat capacity heated by the heater and losing heat
+ * to the ambient, more with the part cooling fan on, and to the melted
+ * filament. The sensor follows the block with a first order lag, the
+ * dead time of the hotend.
+ *
+ * The model runs next to the heater and the measurement corrects it.
+ * The output brings the block of the model to the target in a sample
+ * and feeds forward the losses with the fan speed and the extrusion
+ * rate of the moves planned within the dead time, so the heater does
+ * not wait for the sensor to see the sag of a fast move.
+ */
+
+#if ENABLED(MODEL_PREDICTIVE_CONTROL)
+
+// The temperatures of the model, kept by the heater
+struct model_state_t {
+  float block_temperature,
+        sensor_temperature;
+};
+
+struct model_data_t {
+
+  public: /** Public Parameters */
+
+    float power,          // Heater power at full PWM, W
+          capacity,       // Heat capacity of the hotend, J/K
+          loss,           // Heat loss to the ambient, W/K
+          fan_loss,       // More heat loss with the fan at full speed, W/K
+          filament_heat,  // Heat to bring a mm of filament to the temperature, J/K
+          response,       // Time constant of the sensor, s
+          ambient;        // Ambient temperature, C
+
+  public: /** Public Function */
+
+    /**
+     * The heater output for the target, called every PID_SAMPLE_MS.
+     * dt is the time since the last sample in seconds, 0 restarts the
+     * model from the measurement. last_output is the output of the last
+     * sample, max the max output.
+     */
+    uint8_t spin(const float target_temp, const float current_temp, const float dt, model_state_t &state, const uint8_t hotend, const uint8_t last_output, const uint8_t max);
+
+    // Heat loss at a temperature, fan speed 0-1 and extrusion rate in mm/s
+    FORCE_INLINE float heat_loss(const float temp, const float fan, const float e_rate) {
+      return (loss + fan_loss * fan + filament_heat * e_rate) * (temp - ambient);
+    }
+
+    // Part cooling fan speed, 0-1
+    static float fan_speed();
+
+    // Mean extrusion rate of a hotend over the next seconds of the planner, mm/s
+    static float planned_e_rate(const uint8_t hotend, const float seconds);
+
+};
+
+#endif // MODEL_PREDICTIVE_CONTROL
@@ -0,0 +1,97 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * pid.cpp - pid object
+ */
+
+#include "../../../../MK4duo.h"
+
+#if HAS_HEATER
+
+#if ENABLED(PID_ADD_EXTRUSION_RATE)
+  long      pid_data_t::last_e_position   = 0,
+            pid_data_t::lpq[LPQ_MAX_LEN]  = { 0 };
+  int       pid_data_t::lpq_ptr           = 0;
+  millis_s  pid_data_t::lpq_ms            = 0;
+#endif
+
+/**
+ * The heater output, called every PID_SAMPLE_MS.
+ * A cooler works the other way, the output grows with the temperature.
+ */
+uint8_t pid_data_t::spin(const float target_temp, const float current_temp, const float dt, const bool cooling/*=false*/
+  #if ENABLED(PID_ADD_EXTRUSION_RATE)
+    , const uint8_t tid/*=0xFF*/
+  #endif
+) {
+
+  float pid_output = 0.0;
+
+  if (dt <= 0.0)
+    temperature_rate = 0.0;
+  else {
+    // Derivative of the measurement, low-pass filtered
+    const float alpha = dt / (float(PID_DTERM_FILTER) + dt);
+    temperature_rate += alpha * ((current_temp - last_temperature) / dt - temperature_rate);
+  }
+  last_temperature = current_temp;
+
+  const float pid_error = cooling ? current_temp - target_temp : target_temp - current_temp;
+
+  if (pid_error > PID_FUNCTIONAL_RANGE) {
+    pid_output = Max;
+    tempIState = tempIStateLimitMin;
+  }
+  else if (pid_error < -(PID_FUNCTIONAL_RANGE) || (!cooling && target_temp <= 20))
+    pid_output = 0;
+  else {
+    pid_output = Kp * pid_error;
+    tempIState = constrain(tempIState + pid_error * dt, tempIStateLimitMin, tempIStateLimitMax);
+    pid_output += Ki * tempIState;
+    pid_output += cooling ? Kd * temperature_rate : -Kd * temperature_rate;
+
+    #if ENABLED(PID_ADD_EXTRUSION_RATE)
+      if (tid == ACTIVE_HOTEND) {
+        if (expired(&lpq_ms, 100U)) {
+          const long e_position = stepper.position(E_AXIS);
+          if (e_position > last_e_position) {
+            lpq[lpq_ptr] = e_position - last_e_position;
+            last_e_position = e_position;
+          }
+          else {
+            lpq[lpq_ptr] = 0;
+          }
+          if (++lpq_ptr >= tools.data.lpq_len) lpq_ptr = 0;
+        }
+        pid_output += (lpq[lpq_ptr] * mechanics.steps_to_mm[E_AXIS + tools.extruder.active]) * Kc;
+      }
+    #endif // PID_ADD_EXTRUSION_RATE
+
+    LIMIT(pid_output, 0, Max);
+
+  }
+
+  return pid_output;
+}
+
+#endif // HAS_HEATER
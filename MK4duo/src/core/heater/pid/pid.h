@@ -23,14 +23,13 @@
 
 /**
  * pid.h - pid object
+ *
+ * Every heater runs its own PID with its own sample clock, the integral
+ * and the derivative use the time elapsed since the last sample of that
+ * heater, kept by the heater. The derivative is taken on the measurement, not on the error,
+ * and low-pass filtered with the PID_DTERM_FILTER time constant.
  */
 
-#if ENABLED(PID_ADD_EXTRUSION_RATE)
-  static long last_e_position   = 0,
-              lpq[LPQ_MAX_LEN]  = { 0 };
-  static int  lpq_ptr           = 0;
-#endif
-
 struct pid_data_t {
 
   public: /** Public Parameters */
@@ -42,69 +41,36 @@ struct pid_data_t {
 
   private: /** Private Parameters */
 
-    float tempIState          = 0.0,
-          tempIStateLimitMin  = 0.0,
-          tempIStateLimitMax  = 0.0,
-          last_temperature    = 0.0,
-          temperature_1s      = 0.0;
+    float     tempIState          = 0.0,  // Integral of the error, C*s
+              tempIStateLimitMin  = 0.0,
+              tempIStateLimitMax  = 0.0,
+              last_temperature    = 0.0,
+              temperature_rate    = 0.0;  // Filtered derivative of the measurement, C/s
+
+    #if ENABLED(PID_ADD_EXTRUSION_RATE)
+      // Extrusion of the active hotend, a sample each 100 ms
+      static long     last_e_position,
+                      lpq[LPQ_MAX_LEN];
+      static int      lpq_ptr;
+      static millis_s lpq_ms;
+    #endif
 
   public: /** Public Function */
 
-    uint8_t spin(const int16_t target_temp, const float current_temp
+    /**
+     * dt is the time since the last sample in seconds,
+     * 0 restarts the PID with no derivative.
+     */
+    uint8_t spin(const float target_temp, const float current_temp, const float dt, const bool cooling=false
       #if ENABLED(PID_ADD_EXTRUSION_RATE)
-        , const uint8_t tid
+        , const uint8_t tid=0xFF
       #endif
-    ) {
-
-      static millis_s cycle_1s_ms = 0;
-      float pid_output = 0.0;
-
-      const float pid_error = target_temp - current_temp;
-
-      if (pid_error > PID_FUNCTIONAL_RANGE) {
-        pid_output = Max;
-        tempIState = tempIStateLimitMin;
-      }
-      else if (pid_error < -(PID_FUNCTIONAL_RANGE) || target_temp <= 20)
-        pid_output = 0;
-      else {
-        pid_output = Kp * pid_error;
-        tempIState = constrain(tempIState + pid_error, tempIStateLimitMin, tempIStateLimitMax);
-        pid_output += Ki * tempIState * 0.1;
-        float dgain = Kd * (last_temperature - temperature_1s);
-        pid_output += dgain;
-
-        #if ENABLED(PID_ADD_EXTRUSION_RATE)
-          if (tid == ACTIVE_HOTEND) {
-            const long e_position = stepper.position(E_AXIS);
-            if (e_position > last_e_position) {
-              lpq[lpq_ptr] = e_position - last_e_position;
-              last_e_position = e_position;
-            }
-            else {
-              lpq[lpq_ptr] = 0;
-            }
-            if (++lpq_ptr >= tools.data.lpq_len) lpq_ptr = 0;
-            pid_output += (lpq[lpq_ptr] * mechanics.steps_to_mm[E_AXIS + tools.extruder.active]) * Kc;
-          }
-        #endif // PID_ADD_EXTRUSION_RATE
-
-        LIMIT(pid_output, 0, Max);
-
-      }
-
-      if (expired(&cycle_1s_ms, 1000U)) {
-        last_temperature = temperature_1s;
-        temperature_1s = current_temp;
-      }
-
-      return pid_output;
-    }
+    );
 
     void update() {
       if (Ki != 0) {
-        tempIStateLimitMin = (float)DriveMin * 10.0f / Ki;
-        tempIStateLimitMax = (float)DriveMax * 10.0f / Ki;
+        tempIStateLimitMin = (float)DriveMin / Ki;
+        tempIStateLimitMax = (float)DriveMax / Ki;
       }
     }
 
@@ -111,3 +111,11 @@
     #endif // HOTENDS > 2
   #endif // HOTENDS > 1
 #endif // HAS_HOTENDS
+
+// PID control rate
+#if PID_FREQUENCY < 1 || PID_FREQUENCY > 50
+  #error "DEPENDENCY ERROR: PID_FREQUENCY must be between 1 and 50."
+#endif
+#if ENABLED(MODEL_PREDICTIVE_CONTROL) && !HAS_HOTENDS
+  #error "DEPENDENCY ERROR: MODEL_PREDICTIVE_CONTROL requires a hotend."
+#endif
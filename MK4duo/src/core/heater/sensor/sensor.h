@@ -76,27 +76,7 @@ typedef struct {
       if (WITHIN(type, 1, 9)) {
         const int32_t averagedVssaReading = 2 * adcLowOffset,
                       averagedVrefReading = AD_RANGE + 2 * adcHighOffset;
-
-        // Calculate the resistance
-        const float denom = (float)(averagedVrefReading - raw) - 0.5;
-        if (denom <= 0.0) return ABS_ZERO;
-
-        const float resistance = pullup_res * ((float)(raw - averagedVssaReading) + 0.5) / denom;
-        const float logResistance = LOG(resistance);
-        const float recipT = shA + shB * logResistance + shC * logResistance * logResistance * logResistance;
-
-        /*
-        SERIAL_MV("Debug denom:", denom, 5);
-        SERIAL_MV(" resistance:", resistance, 5);
-        SERIAL_MV(" logResistance:", logResistance, 5);
-        SERIAL_MV(" shA:", shA, 5);
-        SERIAL_MV(" shB:", shB, 5);
-        SERIAL_MV(" shC:", shC, 5);
-        SERIAL_MV(" recipT:", recipT, 5);
-        SERIAL_EOL();
-        */
-
-        return (recipT > 0.0) ? (1.0 / recipT) + (ABS_ZERO) : 2000.0;
+        return getThermistorTemperature(raw - averagedVssaReading, averagedVrefReading - averagedVssaReading);
       }
 
       #if HAS_DHT
@@ -136,6 +116,34 @@ typedef struct {
       return 25;
     }
 
+    /**
+     * Temperature of a thermistor reading x over the span of the readings,
+     * both less the low offset
+     */
+    float getThermistorTemperature(const float x, const float span) {
+
+      // Calculate the resistance
+      const float denom = (span - x) - 0.5;
+      if (denom <= 0.0) return ABS_ZERO;
+
+      const float resistance = pullup_res * (x + 0.5) / denom;
+      const float logResistance = LOG(resistance);
+      const float recipT = shA + shB * logResistance + shC * logResistance * logResistance * logResistance;
+
+      /*
+      SERIAL_MV("Debug denom:", denom, 5);
+      SERIAL_MV(" resistance:", resistance, 5);
+      SERIAL_MV(" logResistance:", logResistance, 5);
+      SERIAL_MV(" shA:", shA, 5);
+      SERIAL_MV(" shB:", shB, 5);
+      SERIAL_MV(" shC:", shC, 5);
+      SERIAL_MV(" recipT:", recipT, 5);
+      SERIAL_EOL();
+      */
+
+      return (recipT > 0.0) ? (1.0 / recipT) + (ABS_ZERO) : 2000.0;
+    }
+
     bool set_pullup_res(const float value) {
       if (!WITHIN(value, 1, 1000000)) return false;
       pullup_res = value;
@@ -289,3 +297,107 @@ typedef struct {
     #endif // HAS_MAX6675
 
 } sensor_data_t;
+
+#if ENABLED(THERMISTOR_TABLE)
+
+  /**
+   * Conversion table of a thermistor, built by build() each time the sensor
+   * parameters change. A reading is converted with one lookup and one linear
+   * interpolation in place of the Steinhart-Hart equation, see thermistor.h
+   */
+  struct thermistor_table_t {
+
+    #if ENABLED(THERMISTOR_TABLE_PROGMEM)
+      #define THERMISTOR_POINT(I) int16_t(pgm_read_word(&point[I]))
+      const int16_t *point;     // Stock table in flash, nullptr if the sensor is not stock
+    #else
+      #define THERMISTOR_POINT(I) point[I]
+      int16_t point[THERMISTOR_TABLE_POINTS];
+      bool    valid;
+    #endif
+
+    void build(sensor_data_t &sensor) {
+
+      #if ENABLED(THERMISTOR_TABLE_PROGMEM)
+
+        point = nullptr;
+        if (!WITHIN(sensor.type, 1, 9) || sensor.pullup_res != float(THERMISTOR_SERIES_RS) || sensor.shC != 0
+          || sensor.adcLowOffset || sensor.adcHighOffset
+        ) return;
+
+        for (uint8_t t = 0; t < COUNT(thermistor_stock_table); t++) {
+          if (pgm_read_float(&thermistor_stock_table[t].r25) == sensor.res_25 && pgm_read_float(&thermistor_stock_table[t].beta) == sensor.beta) {
+            point = thermistor_stock_table[t].point;
+            return;
+          }
+        }
+
+      #else
+
+        valid = false;
+        if (!WITHIN(sensor.type, 1, 9)) return;
+
+        const float span = AD_RANGE + 2 * (sensor.adcHighOffset - sensor.adcLowOffset);
+        int16_t new_point[THERMISTOR_TABLE_POINTS];
+        for (uint16_t i = 0; i < THERMISTOR_TABLE_SIDE; i++) {
+          const float distance = thermistor_table_distance(i);
+          new_point[i] = thermistor_table_value(sensor.getThermistorTemperature(distance, span));
+          new_point[THERMISTOR_TABLE_SIDE + i] = thermistor_table_value(sensor.getThermistorTemperature(span - distance, span));
+        }
+
+        // The temperature manager reads the table from the interrupt
+        CRITICAL_SECTION_START
+          COPY_ARRAY(point, new_point);
+          valid = true;
+        CRITICAL_SECTION_END
+
+      #endif
+    }
+
+    FORCE_INLINE bool ready() {
+      #if ENABLED(THERMISTOR_TABLE_PROGMEM)
+        return point != nullptr;
+      #else
+        return valid;
+      #endif
+    }
+
+    float getTemperature(const sensor_data_t &sensor) {
+
+      const int16_t x     = sensor.raw - 2 * sensor.adcLowOffset,
+                    span  = AD_RANGE + 2 * (sensor.adcHighOffset - sensor.adcLowOffset);
+
+      // Out of the span as the equation
+      if (x < 0) return 2000.0;
+      if (x >= span) return ABS_ZERO;
+
+      // Distance from the nearest end and its side of the table
+      const bool high = x > (span >> 1);
+      const uint16_t u = high ? span - x : x,
+                     side = high ? THERMISTOR_TABLE_SIDE : 0;
+
+      // Octave of the distance
+      uint8_t k = 0;
+      #if ENABLED(CPU_32_BIT)
+        if (u) k = 31 - __builtin_clz(u);
+      #else
+        for (uint16_t v = u; v > 1; v >>= 1) k++;
+      #endif
+
+      if (!u) return THERMISTOR_POINT(side) * (1.0f / THERMISTOR_TABLE_SCALE);
+      if (k >= THERMISTOR_TABLE_OCTAVES) return THERMISTOR_POINT(side + THERMISTOR_TABLE_SIDE - 1) * (1.0f / THERMISTOR_TABLE_SCALE);
+
+      // Point before the distance and the remainder, in 1/2^k of the step
+      const uint32_t offset = uint32_t(u - (1U << k)) << THERMISTOR_TABLE_SHIFT;
+      const uint16_t i = side + 1 + (k << THERMISTOR_TABLE_SHIFT) + uint16_t(offset >> k);
+      const int16_t t0 = THERMISTOR_POINT(i),
+                    t1 = THERMISTOR_POINT(i + 1);
+
+      return (t0 + ((int32_t(t1 - t0) * int32_t(offset & ((1UL << k) - 1))) >> k)) * (1.0f / THERMISTOR_TABLE_SCALE);
+    }
+
+    #undef THERMISTOR_POINT
+
+  };
+
+#endif // THERMISTOR_TABLE
@@ -0,0 +1,39 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * thermistor.cpp - stock thermistor tables
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(THERMISTOR_TABLE_PROGMEM)
+
+  const thermistor_stock_t thermistor_stock_table[9] PROGMEM = {
+    THERMISTOR_STOCK(1), THERMISTOR_STOCK(2), THERMISTOR_STOCK(3),
+    THERMISTOR_STOCK(4), THERMISTOR_STOCK(5), THERMISTOR_STOCK(6),
+    THERMISTOR_STOCK(7), THERMISTOR_STOCK(8), THERMISTOR_STOCK(9)
+  };
+
+#endif // THERMISTOR_TABLE_PROGMEM
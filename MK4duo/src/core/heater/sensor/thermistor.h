@@ -601,6 +601,112 @@
   #define COOLER_BETA 0.0
 #endif
 
+#if ENABLED(THERMISTOR_TABLE)
+
+  /**
+   * Thermistor conversion tables
+   *
+   * The temperature of a thermistor changes fast with the ADC reading near
+   * both ends of the range, and slow in the middle. So the table points are
+   * placed on octaves of the distance from the nearest end, THERMISTOR_TABLE_STEPS
+   * points each octave. A side of the table has the points of the low end and
+   * the other side the points of the high end.
+   *
+   * Side point 0 is the end itself, point 1 + octave * steps + step is at
+   * 2^octave * (1 + step / steps) from the end, the last point is at 2^octaves.
+   * The temperatures are in 1/16 degree.
+   */
+  constexpr uint8_t thermistor_table_octaves(const uint32_t range) { return range > 1 ? 1 + thermistor_table_octaves(range >> 1) : 0; }
+  constexpr uint8_t thermistor_table_shift(const uint8_t steps)    { return steps > 1 ? 1 + thermistor_table_shift(steps >> 1) : 0; }
+
+  #define THERMISTOR_TABLE_OCTAVES  thermistor_table_octaves(AD_RANGE)
+  #define THERMISTOR_TABLE_SHIFT    thermistor_table_shift(THERMISTOR_TABLE_STEPS)
+  #define THERMISTOR_TABLE_SIDE     (THERMISTOR_TABLE_OCTAVES * (THERMISTOR_TABLE_STEPS) + 2)
+  #define THERMISTOR_TABLE_POINTS   (2 * THERMISTOR_TABLE_SIDE)
+  #define THERMISTOR_TABLE_SCALE    16
+
+  // Table value of a temperature, up to 2000 as the shorted thermistor
+  constexpr int16_t thermistor_table_value(const double t) {
+    return t > 2000.0 ? int16_t(2000 * THERMISTOR_TABLE_SCALE) : int16_t(t * THERMISTOR_TABLE_SCALE + (t < 0.0 ? -0.5 : 0.5));
+  }
+
+  // Distance from the end of a side point
+  constexpr float thermistor_table_distance(const uint16_t i) {
+    return i == 0 ? 0.0f
+         : i > THERMISTOR_TABLE_OCTAVES * (THERMISTOR_TABLE_STEPS) ? float(1UL << THERMISTOR_TABLE_OCTAVES)
+         : float(1UL << ((i - 1) >> THERMISTOR_TABLE_SHIFT)) * (1.0f + float((i - 1) & ((THERMISTOR_TABLE_STEPS) - 1)) / float(THERMISTOR_TABLE_STEPS));
+  }
+
+  #if ENABLED(THERMISTOR_TABLE_PROGMEM)
+
+    /**
+     * Tables of the stock thermistors 1-9, computed at compile time with
+     * THERMISTOR_SERIES_RS and no ADC offset. They are used in place of a
+     * table in SRAM by the sensors with the stock parameters.
+     */
+
+    // Natural log: ln(v) = k ln(2) + 2 atanh((m - 1) / (m + 1)), with 1 <= m < 2
+    constexpr double thermistor_ln_series(const double y2, const double term, const uint8_t n) {
+      return n > 41 ? 0.0 : term / n + thermistor_ln_series(y2, term * y2, n + 2);
+    }
+    constexpr double thermistor_ln_mantissa(const double y) { return 2.0 * thermistor_ln_series(y * y, y, 1); }
+    constexpr double thermistor_ln(const double v, const int8_t k=0) {
+      return v >= 2.0 ? thermistor_ln(v * 0.5, k + 1)
+           : v < 1.0  ? thermistor_ln(v * 2.0, k - 1)
+           : k * 0.6931471805599453 + thermistor_ln_mantissa((v - 1.0) / (v + 1.0));
+    }
+
+    // Temperature of a reading x with the stock Steinhart-Hart coefficients, as sensor_data_t::getTemperature()
+    constexpr double thermistor_stock_recipT(const double x, const double r25, const double beta) {
+      return 1.0 / (25.0 - (ABS_ZERO)) + (thermistor_ln(THERMISTOR_SERIES_RS * (x + 0.5) / (AD_RANGE - x - 0.5)) - thermistor_ln(r25)) / beta;
+    }
+    constexpr double thermistor_stock_temp(const double x, const double r25, const double beta) {
+      return AD_RANGE - x - 0.5 <= 0.0 ? ABS_ZERO
+           : thermistor_stock_recipT(x, r25, beta) > 0.0 ? 1.0 / thermistor_stock_recipT(x, r25, beta) + (ABS_ZERO)
+           : 2000.0;
+    }
+    constexpr int16_t thermistor_stock_point(const uint16_t i, const double r25, const double beta) {
+      return thermistor_table_value(thermistor_stock_temp(
+        i < THERMISTOR_TABLE_SIDE ? thermistor_table_distance(i) : AD_RANGE - thermistor_table_distance(i - THERMISTOR_TABLE_SIDE),
+        r25, beta
+      ));
+    }
+
+    // Sequence 0...N-1 of point numbers, split in halves to keep the template depth low
+    template<uint16_t... I> struct thermistor_point_list {};
+
+    template<class A, class B> struct thermistor_point_concat;
+    template<uint16_t... A, uint16_t... B>
+    struct thermistor_point_concat<thermistor_point_list<A...>, thermistor_point_list<B...>> {
+      typedef thermistor_point_list<A..., uint16_t(sizeof...(A) + B)...> type;
+    };
+
+    template<uint16_t N> struct thermistor_point_sequence {
+      typedef typename thermistor_point_concat<typename thermistor_point_sequence<N / 2>::type, typename thermistor_point_sequence<N - N / 2>::type>::type type;
+    };
+    template<> struct thermistor_point_sequence<0> { typedef thermistor_point_list<> type; };
+    template<> struct thermistor_point_sequence<1> { typedef thermistor_point_list<0> type; };
+
+    struct thermistor_stock_t {
+      float   r25,
+              beta;
+      int16_t point[THERMISTOR_TABLE_POINTS];
+    };
+
+    template<uint16_t... I>
+    constexpr thermistor_stock_t thermistor_stock(const double r25, const double beta, thermistor_point_list<I...>) {
+      return { float(r25), float(beta), { thermistor_stock_point(I, r25, beta)... } };
+    }
+
+    #define THERMISTOR_STOCK(N) thermistor_stock(T##N##_R25, T##N##_BETA, thermistor_point_sequence<THERMISTOR_TABLE_POINTS>::type())
+
+    // Computed once in thermistor.cpp
+    extern const thermistor_stock_t thermistor_stock_table[9];
+
+  #endif // THERMISTOR_TABLE_PROGMEM
+
+#endif // THERMISTOR_TABLE
+
 #if HAS_AMPLIFIER
   #include "thermistoramplifier.h"
 #endif
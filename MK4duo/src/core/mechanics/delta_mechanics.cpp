@@ -101,6 +101,7 @@ void Delta_Mechanics::factory_parameters() {
   data.radius                   = DELTA_RADIUS;
   data.segments_per_second      = DELTA_SEGMENTS_PER_SECOND;
   data.segments_per_line        = DELTA_SEGMENTS_PER_LINE;
+  data.segment_error            = DELTA_SEGMENT_ERROR;
   data.print_radius             = DELTA_PRINTABLE_RADIUS;
   data.probe_radius             = DELTA_PROBEABLE_RADIUS;
   data.height                   = DELTA_HEIGHT;
@@ -144,8 +145,9 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
   /**
    * Prepare a linear move in a DELTA setup.
    *
-   * This calls buffer_line several times, adding
-   * small incremental moves for DELTA.
+   * This queues the move as several small segments,
+   * a fixed number per second or, with a segment error
+   * set, as few as keep the towers within the error.
    */
   bool Delta_Mechanics::prepare_move_to_destination_mech_specific() {
 
@@ -188,6 +190,14 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
     // Now compute the number of lines needed
     uint16_t numLines = (segments + data.segments_per_line - 1) / data.segments_per_line;
 
+    if (data.segment_error > 0) {
+      // The fixed lines are the upper bound, down to half of them with the planner running empty
+      const uint8_t moves = planner.moves_planned();
+      if (moves < (BLOCK_BUFFER_SIZE) / 2)
+        numLines = MAX(1U, uint32_t(numLines) * (moves + (BLOCK_BUFFER_SIZE) / 2) / (BLOCK_BUFFER_SIZE));
+      NOMORE(numLines, adaptive_lines(difference, cartesian_distance));
+    }
+
     // The approximate length of each segment
     const float inv_numLines = 1.0f / float(numLines),
                 segment_distance[XYZE] = {
@@ -211,25 +221,88 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
     float raw[XYZE];
     COPY_ARRAY(raw, current_position);
 
-    // Calculate and execute the segments
-    while (--numLines) {
+    // Calculate and execute the segments, a batch at a time
+    float seg_raw[DELTA_SEGMENT_BATCH][XYZE],
+          seg_motor[DELTA_SEGMENT_BATCH][ABCE];
+
+    while (numLines) {
 
       static millis_s next_idle_ms = 0;
       if (expired(&next_idle_ms, 200U)) printer.idle();
 
-      LOOP_XYZE(i) raw[i] += segment_distance[i];
+      const uint8_t count = MIN(numLines, uint16_t(DELTA_SEGMENT_BATCH));
+      numLines -= count;
+
+      for (uint8_t s = 0; s < count; s++) {
+        // The last segment ends on the destination
+        if (!numLines && s == count - 1)
+          COPY_ARRAY(raw, destination);
+        else
+          LOOP_XYZE(i) raw[i] += segment_distance[i];
+        COPY_ARRAY(seg_raw[s], raw);
+        #if HAS_POSITION_MODIFIERS
+          planner.apply_modifiers(seg_raw[s]);
+        #endif
+      }
+
+      Transform(seg_raw, seg_motor, count);
 
-      if (!planner.buffer_line(raw, _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm))
-        break;
+      if (!planner.buffer_segments(count, seg_motor, raw
+        #if ENABLED(JUNCTION_DEVIATION)
+          , segment_distance
+        #endif
+        , _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm
+      )) break;
 
     }
 
-    planner.buffer_line(destination, _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm);
-
     return false; // caller will update current_position
 
   }
 
+  /**
+   * A tower follows z + sqrt(D2 - r^2) along the move, r the distance of
+   * the effector from the tower. A straight segment of length s in the
+   * tower space misses that curve by at most k * s^2 / 8, with k the bound
+   * of the second derivative of the tower height by the move length:
+   *
+   *   k = (uxy^2 * H^2 + (r.u)^2) / H^3,  H = sqrt(D2 - r^2)
+   *
+   * u is the direction of the move, uxy its part in XY. The distance from
+   * the tower and |r.u| are largest at an end of the move, so the ends
+   * bound the whole move. Long moves near the centre get long segments,
+   * moves far from a tower or across it short ones.
+   */
+  uint16_t Delta_Mechanics::adaptive_lines(const float (&difference)[XYZE], const float cartesian_distance) {
+
+    #if HOTENDS > 1
+      const float offset_x = nozzle.data.hotend_offset[X_AXIS][ACTIVE_HOTEND],
+                  offset_y = nozzle.data.hotend_offset[Y_AXIS][ACTIVE_HOTEND];
+    #else
+      constexpr float offset_x = 0.0f, offset_y = 0.0f;
+    #endif
+
+    const float inv_distance  = 1.0f / cartesian_distance,
+                ux            = difference[X_AXIS] * inv_distance,
+                uy            = difference[Y_AXIS] * inv_distance,
+                uxy2          = sq(ux) + sq(uy);
+
+    float k = 0.0f;
+    LOOP_XYZ(i) {
+      const float sx = current_position[X_AXIS] - towerX[i] - offset_x, sy = current_position[Y_AXIS] - towerY[i] - offset_y,
+                  ex = destination[X_AXIS] - towerX[i] - offset_x,      ey = destination[Y_AXIS] - towerY[i] - offset_y,
+                  H2 = MIN(D2[i] - sq(sx) - sq(sy), D2[i] - sq(ex) - sq(ey)),
+                  ru = MAX(ABS(sx * ux + sy * uy), ABS(ex * ux + ey * uy));
+      if (H2 <= 0) return UINT16_MAX;
+      NOLESS(k, (uxy2 * H2 + sq(ru)) / (H2 * SQRT(H2)));
+    }
+
+    // Segment length s = sqrt(8 * error / k)
+    const float lines = CEIL(cartesian_distance * SQRT(k / (8.0f * data.segment_error)));
+    return lines < UINT16_MAX ? MAX(1U, uint16_t(lines)) : UINT16_MAX;
+
+  }
+
 #endif // DISABLED(AUTO_BED_LEVELING_UBL)
 
 /**
@@ -383,6 +456,40 @@ void Delta_Mechanics::Transform(const float (&raw)[XYZE]) {
   Transform(raw_xyz);
 }
 
+/**
+ * The towers of all the points in one loop, with no call and no store
+ * to delta[]. The three roots of a point and the points of the batch do
+ * not depend on each other, the FPU pipelines them and the compiler can
+ * vectorize the loop where the target has vector square roots.
+ */
+void Delta_Mechanics::Transform(const float (*raw)[XYZE], float (*motor)[ABCE], const uint8_t count) {
+
+  #if HOTENDS > 1
+    // Delta hotend offsets must be applied in Cartesian space
+    const float offset_x = nozzle.data.hotend_offset[X_AXIS][ACTIVE_HOTEND],
+                offset_y = nozzle.data.hotend_offset[Y_AXIS][ACTIVE_HOTEND];
+  #else
+    constexpr float offset_x = 0.0f, offset_y = 0.0f;
+  #endif
+
+  const float tax = towerX[A_AXIS] + offset_x, tay = towerY[A_AXIS] + offset_y,
+              tbx = towerX[B_AXIS] + offset_x, tby = towerY[B_AXIS] + offset_y,
+              tcx = towerX[C_AXIS] + offset_x, tcy = towerY[C_AXIS] + offset_y,
+              d2a = D2[A_AXIS], d2b = D2[B_AXIS], d2c = D2[C_AXIS];
+
+  for (uint8_t i = 0; i < count; i++) {
+    const float x = raw[i][X_AXIS], y = raw[i][Y_AXIS], z = raw[i][Z_AXIS];
+    const float ra = d2a - sq(x - tax) - sq(y - tay),
+                rb = d2b - sq(x - tbx) - sq(y - tby),
+                rc = d2c - sq(x - tcx) - sq(y - tcy);
+    motor[i][A_AXIS] = z + _SQRT(ra);
+    motor[i][B_AXIS] = z + _SQRT(rb);
+    motor[i][C_AXIS] = z + _SQRT(rc);
+    motor[i][E_AXIS] = raw[i][E_AXIS];
+  }
+
+}
+
 void Delta_Mechanics::recalc_delta_settings() {
 
   // Get a minimum radius for clamping
@@ -1008,10 +1115,11 @@ void Delta_Mechanics::report_current_position_detail() {
     SERIAL_MV(" R", LINEAR_UNIT(data.radius));
     SERIAL_MV(" D", LINEAR_UNIT(data.diagonal_rod));
     SERIAL_EOL();
-    SERIAL_LM(CFG, "Delta Geometry adjustment: S<DELTA_SEGMENTS_PER_SECOND> L<DELTA_SEGMENTS_PER_LINE>");
+    SERIAL_LM(CFG, "Delta Geometry adjustment: S<DELTA_SEGMENTS_PER_SECOND> L<DELTA_SEGMENTS_PER_LINE> E<DELTA_SEGMENT_ERROR>");
     SERIAL_SM(CFG, "  M666");
     SERIAL_MV(" S", data.segments_per_second);
     SERIAL_MV(" L", data.segments_per_line);
+    SERIAL_MV(" E", LINEAR_UNIT(data.segment_error), 3);
     SERIAL_EOL();
     SERIAL_LM(CFG, "Delta Geometry adjustment: O<DELTA_PRINTABLE_RADIUS> P<DELTA_PROBEABLE_RADIUS> H<DELTA_HEIGHT>");
     SERIAL_SM(CFG, "  M666");
@@ -28,6 +28,13 @@
 
 #pragma once
 
+// Segments of a delta move transformed and queued at once
+#if BLOCK_BUFFER_SIZE > 16
+  #define DELTA_SEGMENT_BATCH 8
+#else
+  #define DELTA_SEGMENT_BATCH (BLOCK_BUFFER_SIZE / 4)
+#endif
+
 // Struct Delta Settings
 typedef struct : public generic_data_t {
 
@@ -45,6 +52,8 @@ typedef struct : public generic_data_t {
 
   uint8_t   segments_per_line;
 
+  float     segment_error;
+
 } mechanics_data_t;
 
 class Delta_Mechanics : public Mechanics {
@@ -92,8 +101,8 @@ class Delta_Mechanics : public Mechanics {
       /**
        * Prepare a linear move in a DELTA setup.
        *
-       * This calls buffer_line several times, adding
-       * small incremental moves for DELTA.
+       * The segments are transformed and queued
+       * DELTA_SEGMENT_BATCH at a time.
        */
       static bool prepare_move_to_destination_mech_specific();
     #endif
@@ -122,6 +131,8 @@ class Delta_Mechanics : public Mechanics {
     FORCE_INLINE static void InverseTransform(const float point[XYZ], float cartesian[XYZ]) { InverseTransform(point[X_AXIS], point[Y_AXIS], point[Z_AXIS], cartesian); }
     static void Transform(const float (&raw)[XYZ]);
     static void Transform(const float (&raw)[XYZE]);
+    // Transform count points, E is copied
+    static void Transform(const float (*raw)[XYZE], float (*motor)[ABCE], const uint8_t count);
     static void recalc_delta_settings();
 
     /**
@@ -194,6 +205,13 @@ class Delta_Mechanics : public Mechanics {
      */
     static void Set_clip_start_height();
 
+    #if DISABLED(AUTO_BED_LEVELING_UBL)
+      /**
+       * Lines of a move to keep the towers within the segment error
+       */
+      static uint16_t adaptive_lines(const float (&difference)[XYZE], const float cartesian_distance);
+    #endif
+
     #if ENABLED(DELTA_FAST_SQRT) && ENABLED(__AVR__)
       static float Q_rsqrt(float number);
     #endif
@@ -248,6 +248,18 @@
 #if DISABLED(N_ARC_CORRECTION)
   #error "DEPENDENCY ERROR: Missing setting N_ARC_CORRECTION."
 #endif
+#if ENABLED(ARC_BLOCKS)
+  #if DISABLED(ARC_SUPPORT)
+    #error "DEPENDENCY ERROR: ARC_BLOCKS requires ARC_SUPPORT."
+  #elif IS_KINEMATIC || IS_CORE
+    #error "DEPENDENCY ERROR: ARC_BLOCKS is only for cartesian mechanics."
+  #elif DISABLED(CPU_32_BIT)
+    #error "DEPENDENCY ERROR: ARC_BLOCKS requires a 32 bit board."
+  #endif
+#endif
+#if ENABLED(G5_BEZIER_CURVE) && DISABLED(G5_BEZIER)
+  #error "DEPENDENCY ERROR: G5_BEZIER_CURVE requires G5_BEZIER."
+#endif
 #if DISABLED(DEFAULT_AXIS_STEPS_PER_UNIT)
   #error "DEPENDENCY ERROR: Missing setting DEFAULT_AXIS_STEPS_PER_UNIT."
 #endif
@@ -603,6 +615,13 @@
   #if DISABLED(PSI_HOMING_OFFSET)
     #error "DEPENDENCY ERROR: Missing setting PSI_HOMING_OFFSET."
   #endif
+  #if ENABLED(SCARA_INCREMENTAL_SEGMENTS)
+    #if ENABLED(SCARA_FEEDRATE_SCALING)
+      #error "DEPENDENCY ERROR: SCARA_INCREMENTAL_SEGMENTS is not compatible with SCARA_FEEDRATE_SCALING."
+    #elif SCARA_RESYNC_SEGMENTS < 1 || SCARA_RESYNC_SEGMENTS > 255
+      #error "DEPENDENCY ERROR: SCARA_RESYNC_SEGMENTS must be between 1 and 255."
+    #endif
+  #endif
 
   /**
    * Babystepping
@@ -128,6 +128,12 @@ void Scara_Mechanics::get_cartesian_from_steppers() {
    *
    * This calls buffer_line several times, adding
    * small incremental moves for SCARA.
+   *
+   * With SCARA_INCREMENTAL_SEGMENTS the segments are as long as
+   * the feedrate moves in a segment time, so each one takes the
+   * same time, and the last one takes the rest of the move. The
+   * arm angles follow the line from the last segment, with the
+   * exact transform every SCARA_RESYNC_SEGMENTS.
    */
    bool Scara_Mechanics::prepare_move_to_destination_mech_specific() {
 
@@ -160,6 +166,90 @@ void Scara_Mechanics::get_cartesian_from_steppers() {
     // No E move either? Game over.
     if (UNEAR_ZERO(cartesian_mm)) return true;
 
+  #if ENABLED(SCARA_INCREMENTAL_SEGMENTS)
+
+    // The distance moved in a segment time, for SCARA at least 0.5mm
+    const float segment_mm = MAX(_feedrate_mm_s / data.segments_per_second, 0.5f);
+
+    // The segments of a segment time before the last one, it ends on the destination
+    uint16_t segments = MAX(1U, uint16_t(cartesian_mm / segment_mm)) - 1;
+
+    const float scale = segment_mm / cartesian_mm,
+                segment_distance[XYZE] = {
+                  difference[X_AXIS] * scale,
+                  difference[Y_AXIS] * scale,
+                  difference[Z_AXIS] * scale,
+                  difference[E_AXIS] * scale
+                };
+
+    // Get the current position as starting point
+    float raw[XYZE];
+    COPY_ARRAY(raw, current_position);
+
+    // Calculate and execute the segments, a batch at a time
+    float seg_motor[SCARA_SEGMENT_BATCH][ABCE];
+    scara_arms_t arms;
+    uint8_t followed = SCARA_RESYNC_SEGMENTS;
+
+    while (segments) {
+
+      static millis_s next_idle_ms = 0;
+      if (expired(&next_idle_ms, 200U)) printer.idle();
+
+      const uint8_t count = MIN(segments, uint16_t(SCARA_SEGMENT_BATCH));
+      segments -= count;
+
+      for (uint8_t s = 0; s < count; s++) {
+        LOOP_XYZE(i) raw[i] += segment_distance[i];
+        float seg_raw[XYZE];
+        COPY_ARRAY(seg_raw, raw);
+        #if HAS_POSITION_MODIFIERS
+          planner.apply_modifiers(seg_raw);
+        #endif
+        // The exact transform at the start, every SCARA_RESYNC_SEGMENTS and near the singularity
+        if (followed >= SCARA_RESYNC_SEGMENTS || !follow_arms(arms, seg_raw, seg_motor[s])) {
+          sync_arms(arms, seg_raw, seg_motor[s]);
+          followed = 0;
+        }
+        else
+          followed++;
+      }
+
+      if (!planner.buffer_segments(count, seg_motor, raw
+        #if ENABLED(JUNCTION_DEVIATION)
+          , segment_distance
+        #endif
+        , _feedrate_mm_s, tools.extruder.active, segment_mm
+      )) return false;
+
+    }
+
+    // The last segment, with the rest of the move
+    const float last_distance[XYZE] = {
+      destination[X_AXIS] - raw[X_AXIS],
+      destination[Y_AXIS] - raw[Y_AXIS],
+      destination[Z_AXIS] - raw[Z_AXIS],
+      destination[E_AXIS] - raw[E_AXIS]
+    };
+    float last_mm = SQRT(sq(last_distance[X_AXIS]) + sq(last_distance[Y_AXIS]) + sq(last_distance[Z_AXIS]));
+    if (UNEAR_ZERO(last_mm)) last_mm = ABS(last_distance[E_AXIS]);
+
+    float seg_raw[XYZE];
+    COPY_ARRAY(seg_raw, destination);
+    #if HAS_POSITION_MODIFIERS
+      planner.apply_modifiers(seg_raw);
+    #endif
+    sync_arms(arms, seg_raw, seg_motor[0]);
+
+    planner.buffer_segments(1, seg_motor, destination
+      #if ENABLED(JUNCTION_DEVIATION)
+        , last_distance
+      #endif
+      , _feedrate_mm_s, tools.extruder.active, last_mm
+    );
+
+  #else
+
     // Minimum number of seconds to move the given distance
     const float seconds = cartesian_mm / _feedrate_mm_s;
 
@@ -261,6 +351,8 @@ void Scara_Mechanics::get_cartesian_from_steppers() {
       planner.buffer_line(destination, _feedrate_mm_s, tools.extruder.active);
     #endif
 
+  #endif // SCARA_INCREMENTAL_SEGMENTS
+
     return false; // caller will update current_position
   }
 
@@ -912,4 +1004,69 @@ void Scara_Mechanics::homeaxis(const AxisEnum axis) {
 
 }
 
+#if ENABLED(SCARA_INCREMENTAL_SEGMENTS)
+
+  /**
+   * The exact arm angles of a segment
+   */
+  void Scara_Mechanics::sync_arms(scara_arms_t &arms, const float (&raw)[XYZE], float (&motor)[ABCE]) {
+    Transform(raw);
+    arms.a = RADIANS(delta[A_AXIS]);
+    arms.b = RADIANS(delta[B_AXIS]);
+    arms.cos_a = cos(arms.a); arms.sin_a = sin(arms.a);
+    arms.cos_b = cos(arms.b); arms.sin_b = sin(arms.b);
+    motor[A_AXIS] = delta[A_AXIS];
+    motor[B_AXIS] = delta[B_AXIS];
+    motor[C_AXIS] = delta[C_AXIS];
+    motor[E_AXIS] = raw[E_AXIS];
+  }
+
+  /**
+   * The arm angles of a segment from the last segment.
+   *
+   * A Newton step on the forward kinematics, the arms turn by the
+   * angles that take the effector from where the last angles put it
+   * to the new point. The cosine and sine turn with the small angle
+   * series, without the trigonometric functions of the transform.
+   * Return false near the singularity, the arms in line, or for a
+   * step too large for the series.
+   */
+  bool Scara_Mechanics::follow_arms(scara_arms_t &arms, const float (&raw)[XYZE], float (&motor)[ABCE]) {
+
+    // The Jacobian determinant, L1 * L2 * sin(b - a)
+    const float det = L1 * L2 * (arms.sin_b * arms.cos_a - arms.cos_b * arms.sin_a);
+    if (ABS(det) < 0.05f * L1 * L2) return false;
+
+    // The distance of the point from the effector of the last angles
+    const float rx = raw[X_AXIS] - SCARA_OFFSET_X - (L1 * arms.cos_a + L2 * arms.cos_b),
+                ry = raw[Y_AXIS] - SCARA_OFFSET_Y - (L1 * arms.sin_a + L2 * arms.sin_b),
+                da = L2 * (arms.cos_b * rx + arms.sin_b * ry) / det,
+                db = -L1 * (arms.cos_a * rx + arms.sin_a * ry) / det;
+
+    if (ABS(da) > 0.05f || ABS(db) > 0.05f) return false;
+
+    // Turn the arms, cos(d) = 1 - d^2/2 and sin(d) = d - d^3/6
+    const float da2 = sq(da), db2 = sq(db),
+                cos_da = 1.0f - 0.5f * da2, sin_da = da * (1.0f - da2 * (1.0f / 6.0f)),
+                cos_db = 1.0f - 0.5f * db2, sin_db = db * (1.0f - db2 * (1.0f / 6.0f)),
+                cos_a = arms.cos_a * cos_da - arms.sin_a * sin_da,
+                cos_b = arms.cos_b * cos_db - arms.sin_b * sin_db;
+
+    arms.sin_a = arms.sin_a * cos_da + arms.cos_a * sin_da;
+    arms.sin_b = arms.sin_b * cos_db + arms.cos_b * sin_db;
+    arms.cos_a = cos_a;
+    arms.cos_b = cos_b;
+    arms.a += da;
+    arms.b += db;
+
+    motor[A_AXIS] = DEGREES(arms.a);
+    motor[B_AXIS] = DEGREES(arms.b);
+    motor[C_AXIS] = raw[Z_AXIS];
+    motor[E_AXIS] = raw[E_AXIS];
+    return true;
+
+  }
+
+#endif // SCARA_INCREMENTAL_SEGMENTS
+
 #endif // IS_SCARA
@@ -28,6 +28,24 @@
 
 #pragma once
 
+#if ENABLED(SCARA_INCREMENTAL_SEGMENTS)
+
+  // Segments of a SCARA move transformed and queued at once
+  #if BLOCK_BUFFER_SIZE > 16
+    #define SCARA_SEGMENT_BATCH 8
+  #else
+    #define SCARA_SEGMENT_BATCH (BLOCK_BUFFER_SIZE / 4)
+  #endif
+
+  // Arm angles of the last segment in radians, with their cosine and sine
+  struct scara_arms_t {
+    float a, b,
+          cos_a, sin_a,
+          cos_b, sin_b;
+  };
+
+#endif
+
 // Struct Scara Settings
 typedef struct : public generic_data_t {
 
@@ -79,6 +97,9 @@ class Scara_Mechanics : public Mechanics {
        *
        * This calls buffer_line several times, adding
        * small incremental moves for SCARA.
+       * With SCARA_INCREMENTAL_SEGMENTS the segments take
+       * the same time and are queued SCARA_SEGMENT_BATCH
+       * at a time.
        */
       static bool prepare_move_to_destination_mech_specific();
     #endif
@@ -168,6 +189,14 @@ class Scara_Mechanics : public Mechanics {
      */
     static void homeaxis(const AxisEnum axis);
 
+    #if ENABLED(SCARA_INCREMENTAL_SEGMENTS)
+      /**
+       * The arm angles of a segment, exact or from the last segment
+       */
+      static void sync_arms(scara_arms_t &arms, const float (&raw)[XYZE], float (&motor)[ABCE]);
+      static bool follow_arms(scara_arms_t &arms, const float (&raw)[XYZE], float (&motor)[ABCE]);
+    #endif
+
 };
 
 extern Scara_Mechanics mechanics;
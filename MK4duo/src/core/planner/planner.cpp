@@ -124,6 +124,10 @@ float Planner::previous_speed[NUM_AXIS]   = { 0.0 },
   bool Planner::abort_on_endstop_hit = false;
 #endif
 
+#if ENABLED(G5_BEZIER_CURVE)
+  curve_chord_t Planner::curve = { 0.0f, false };
+#endif
+
 #if HAS_SPI_LCD
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
@@ -814,6 +818,11 @@ void Planner::quick_stop() {
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
+  #if ENABLED(STEP_CHUNK_QUEUE)
+    // And their step chunks
+    compressor.clear();
+  #endif
+
   //  And restart the block delay for the first movement - As the queue was
   // forced to empty, there is no risk the ISR could touch this variable.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
@@ -884,6 +893,7 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 }
 
 void Planner::synchronize() {
+  MOTION_PROBE(SYNCHRONIZE);
   while (has_blocks_queued() || cleaning_buffer_flag) {
     printer.idle();
     PRINTER_KEEPALIVE(InProcess);
@@ -905,6 +915,7 @@ void Planner::finish_and_disable() {
  *  fr_mm_s       - (target) speed of the move
  *  extruder      - target extruder
  *  millimeters   - the length of the movement, if known
+ *  arc           - the arc of the movement, if any
  *
  * Returns true if movement was properly queued, false otherwise
  */
@@ -916,8 +927,13 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
     , const float (&delta_mm_cart)[XYZE]
   #endif
   , float fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
+  #if ENABLED(ARC_BLOCKS)
+    , const arc_move_t * const arc/*=NULL*/
+  #endif
 ) {
 
+  MOTION_PROBE(BUFFER_STEPS);
+
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_flag) return false;
 
@@ -934,6 +950,9 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
       , delta_mm_cart
     #endif
     , fr_mm_s, extruder, millimeters
+    #if ENABLED(ARC_BLOCKS)
+      , arc
+    #endif
   )) {
     // Movement was not queued, probably because it was too short.
     // Simply accept that as movement queued and done
@@ -952,6 +971,7 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
 
   // Move buffer head
   block_buffer_head = next_buffer_head;
+  MOTION_BLOCK_QUEUED();
 
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
@@ -968,6 +988,7 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
  *  target      - target position in steps units
  *  fr_mm_s     - (target) speed of the move
  *  extruder    - target extruder
+ *  arc         - the arc of the movement, if any
  *
  * Returns true is movement is acceptable, false otherwise
  */
@@ -980,6 +1001,9 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     , const float (&delta_mm_cart)[XYZE]
   #endif
   , float fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
+  #if ENABLED(ARC_BLOCKS)
+    , const arc_move_t * const arc/*=NULL*/
+  #endif
 ) {
 
   const int32_t dx = target[X_AXIS] - position[X_AXIS],
@@ -1162,6 +1186,21 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   block->steps[E_AXIS] = esteps;
   block->step_event_count = MAX(block->steps[X_AXIS], block->steps[Y_AXIS], block->steps[Z_AXIS], esteps);
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      block->arc = arc->block;
+      // Steps added to an axis of the arc, as the hysteresis correction, go with the first chord
+      const uint32_t extra_p = block->steps[arc->block.p_axis] - ABS(target[arc->block.p_axis] - position[arc->block.p_axis]),
+                     extra_q = block->steps[arc->block.q_axis] - ABS(target[arc->block.q_axis] - position[arc->block.q_axis]);
+      block->arc.origin[0] -= extra_p << ARC_STEP_BITS;
+      block->arc.origin[1] -= extra_q << ARC_STEP_BITS;
+      // The step events follow the length of the arc, every chord has the room of the first one
+      NOLESS(block->step_event_count, arc->events + MAX(extra_p, extra_q) * arc->block.chords);
+    }
+    else
+      block->arc.chords = 0;
+  #endif
+
   // Bail if this is a zero-length block
   if (printer.mode == PRINTER_MODE_FFF && block->step_event_count < MIN_STEPS_PER_SEGMENT) return false;
 
@@ -1518,8 +1557,19 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   // Calculate and limit speed in mm/sec for each axis
   float current_speed[NUM_AXIS], speed_factor = 1.0f; // factor <1 decreases speed
   LOOP_XYZE(i) {
-    const float delta_mm_i = delta_mm[i];
-    const float cs = ABS(current_speed[i] = delta_mm_i * inverse_secs);
+    #if ENABLED(ARC_BLOCKS)
+      // An arc starts along the tangent, an axis is the fastest at the start or at the end
+      float cs;
+      if (arc) {
+        current_speed[i] = arc->entry[i] * block->millimeters * inverse_secs;
+        cs = MAX(ABS(arc->entry[i]), ABS(arc->exit[i])) * block->millimeters * inverse_secs;
+      }
+      else
+        cs = ABS(current_speed[i] = delta_mm[i] * inverse_secs);
+    #else
+      const float delta_mm_i = delta_mm[i];
+      const float cs = ABS(current_speed[i] = delta_mm_i * inverse_secs);
+    #endif
     if (i == E_AXIS) i += extruder;
     if (cs > mechanics.data.max_feedrate_mm_s[i]) NOMORE(speed_factor, mechanics.data.max_feedrate_mm_s[i] / cs);
   }
@@ -1571,6 +1621,9 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
   // Compute and limit the acceleration rate for the trapezoid generator.
   const float steps_per_mm = block->step_event_count * inverse_millimeters;
+  #if ENABLED(PLANNER_INTEGER_TRAPEZOID)
+    block->steps_per_mm = steps_per_mm;
+  #endif
   uint32_t accel;
   if (!block->steps[X_AXIS] && !block->steps[Y_AXIS] && !block->steps[Z_AXIS]) {
     // convert to: acceleration steps/sec^2
@@ -1620,6 +1673,12 @@ bool Planner::fill_block(block_t * const block, bool split_move,
                               && de > 0;
 
       if (block->use_advance_lead) {
+        #if ENABLED(ARC_BLOCKS)
+          // The extrusion of an arc goes along its length
+          if (arc)
+            block->e_D_ratio = (target_float[E_AXIS] - position_float[E_AXIS]) / block->millimeters;
+          else
+        #endif
         block->e_D_ratio = (target_float[E_AXIS] - position_float[E_AXIS]) /
           #if IS_KINEMATIC
             block->millimeters
@@ -1670,6 +1729,28 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
+
+  #if ENABLED(ARC_BLOCKS) || ENABLED(G5_BEZIER_CURVE)
+    // Keep the centripetal acceleration of an arc or a curve within the acceleration, not below the minimum speed
+    const float curve_radius =
+      #if ENABLED(ARC_BLOCKS) && ENABLED(G5_BEZIER_CURVE)
+        arc ? arc->radius : curve.radius
+      #elif ENABLED(ARC_BLOCKS)
+        arc ? arc->radius : 0.0f
+      #else
+        curve.radius
+      #endif
+    ;
+    if (curve_radius > 0) {
+      const float limit_sqr = MAX(block->acceleration * curve_radius, sq(float(MINIMUM_PLANNER_SPEED)));
+      if (block->nominal_speed_sqr > limit_sqr) {
+        const float arc_factor = SQRT(limit_sqr / block->nominal_speed_sqr);
+        LOOP_XYZE(i) current_speed[i] *= arc_factor;
+        block->nominal_rate *= arc_factor;
+        block->nominal_speed_sqr = limit_sqr;
+      }
+    }
+  #endif
   #if DISABLED(BEZIER_JERK_CONTROL)
     block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (HAL_TIMER_RATE)));
   #endif
@@ -1706,6 +1787,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
       };
     #endif
 
+    #if ENABLED(ARC_BLOCKS)
+      // An arc joins the previous move along the tangent at the start
+      if (arc) COPY_ARRAY(unit_vec, arc->entry);
+    #endif
+
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
       // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
@@ -1755,6 +1841,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
       vmax_junction_sqr = 0;
 
+    #if ENABLED(ARC_BLOCKS)
+      // The next move joins an arc along the tangent at the end
+      if (arc) COPY_ARRAY(previous_unit_vec, arc->exit);
+      else
+    #endif
     COPY_ARRAY(previous_unit_vec, unit_vec);
 
   #endif // ENABLED(JUNCTION_DEVIATION)
@@ -1855,6 +1946,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
   #endif // Classic Jerk Limiting
 
+  #if ENABLED(G5_BEZIER_CURVE)
+    // The chords of a curve join without a corner, the curvature limits the speed
+    if (curve.joined && moves_queued) vmax_junction_sqr = MIN(block->nominal_speed_sqr, previous_nominal_speed_sqr);
+  #endif
+
   // Max entry speed of this block equals the max exit speed of the previous block.
   block->max_entry_speed_sqr = vmax_junction_sqr;
 
@@ -1876,6 +1972,13 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   block->flag |= block->nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
 
   // Update previous path unit_vector and nominal speed
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      const float arc_speed = SQRT(block->nominal_speed_sqr);
+      LOOP_XYZE(i) previous_speed[i] = arc->exit[i] * arc_speed;
+    }
+    else
+  #endif
   COPY_ARRAY(previous_speed, current_speed);
   previous_nominal_speed_sqr = block->nominal_speed_sqr;
 
@@ -2041,6 +2144,8 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
  */
 bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, const float &e, const float &fr_mm_s, const uint8_t extruder, const float millimeters/*=0.0*/) {
 
+  MOTION_PROBE(BUFFER_LINE);
+
   float raw[XYZE] = { rx, ry, rz, e };
   #if HAS_POSITION_MODIFIERS
     apply_modifiers(raw);
@@ -2095,6 +2200,197 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
 
 }
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Add an arc to the buffer, not more than a quadrant, as a single block.
+   *
+   * The stepper cuts the chords. The angle of a chord keeps the arc within
+   * half a step of the chord, the sagitta of a chord is radius * angle^2 / 8.
+   */
+  bool Planner::buffer_arc(const float (&cart)[XYZE], const float (&start)[XYZE], const float (&center)[2], const float &angle,
+    const AxisEnum p_axis, const AxisEnum q_axis, const float &fr_mm_s, const uint8_t extruder, const float &millimeters
+  ) {
+
+    // If we are cleaning, do not accept queuing of movements
+    if (cleaning_buffer_flag) return false;
+
+    float raw[XYZE];
+    COPY_ARRAY(raw, cart);
+    #if HAS_POSITION_MODIFIERS
+      apply_modifiers(raw);
+    #endif
+
+    // Simulation Mode no movement
+    if (printer.debugSimulation()) return buffer_segment(raw, fr_mm_s, extruder, millimeters);
+
+    // Calculate target position in absolute steps
+    const int32_t target[XYZE] = {
+      static_cast<int32_t>(FLOOR(raw[X_AXIS] * mechanics.data.axis_steps_per_mm[X_AXIS] + 0.5f)),
+      static_cast<int32_t>(FLOOR(raw[Y_AXIS] * mechanics.data.axis_steps_per_mm[Y_AXIS] + 0.5f)),
+      static_cast<int32_t>(FLOOR(raw[Z_AXIS] * mechanics.data.axis_steps_per_mm[Z_AXIS] + 0.5f)),
+      static_cast<int32_t>(FLOOR(raw[E_AXIS] * mechanics.data.axis_steps_per_mm[E_AXIS_N(extruder)] + 0.5f))
+    };
+
+    // DRYRUN prevents E moves from taking place
+    if (printer.debugDryrun()) {
+      position[E_AXIS] = target[E_AXIS];
+      #if HAS_POSITION_FLOAT
+        position_float[E_AXIS] = raw[E_AXIS];
+      #endif
+    }
+
+    const AxisEnum axis[2] = { p_axis, q_axis };
+    const float r_start[2]  = { start[p_axis] - center[0], start[q_axis] - center[1] },
+                r_end[2]    = { cart[p_axis] - center[0], cart[q_axis] - center[1] },
+                spm         = MAX(mechanics.data.axis_steps_per_mm[p_axis], mechanics.data.axis_steps_per_mm[q_axis]);
+
+    arc_move_t arc;
+    arc.radius = HYPOT(r_start[0], r_start[1]);
+
+    const float flat_mm = ABS(angle) * arc.radius;
+
+    float chords = CEIL(ABS(angle) * SQRT(arc.radius * spm * 0.25f));
+    NOLESS(chords, 1.0f);
+    NOMORE(chords, 65535.0f);
+    arc.block.chords  = chords;
+
+    // In double, the error of a float rotation would change the radius along the chords
+    const double chord_angle = double(angle) / chords;
+    arc.block.cos_t   = lround(cos(chord_angle) * double(1UL << ARC_TURN_BITS));
+    arc.block.sin_t   = lround(sin(chord_angle) * double(1UL << ARC_TURN_BITS));
+    arc.block.p_axis  = p_axis;
+    arc.block.q_axis  = q_axis;
+
+    // The step events of a chord are shared evenly, a chord gets the steps of its length
+    // on an axis of the arc and a step more for each end, or its part of a linear axis
+    uint32_t chord_events = CEIL(flat_mm * spm / chords) + 3;
+    LOOP_XYZE(i) if (i != p_axis && i != q_axis) NOLESS(chord_events, uint32_t(ABS(target[i] - position[i])) / arc.block.chords + 3);
+    arc.events = chord_events * arc.block.chords;
+
+    // The start from the center, the modifiers move the center with the arc
+    for (uint8_t i = 0; i < 2; i++) {
+      const double  axis_spm  = mechanics.data.axis_steps_per_mm[axis[i]],
+                    dir       = target[axis[i]] < position[axis[i]] ? -1.0 : 1.0;
+      arc.block.radius[i] = lround(r_start[i] * spm * double(1UL << ARC_STEP_BITS));
+      arc.block.scale[i]  = lround(dir * axis_spm / spm * double(1UL << ARC_SCALE_BITS));
+      arc.block.origin[i] = lround(dir * (position[axis[i]] - (center[i] + raw[axis[i]] - cart[axis[i]]) * axis_spm) * double(1UL << ARC_STEP_BITS));
+    }
+
+    // Tangents at the ends, per mm of the move
+    const float inv_mm    = 1.0f / millimeters,
+                tangent   = (angle < 0 ? -flat_mm : flat_mm) * inv_mm / arc.radius;
+    LOOP_XYZE(i) arc.entry[i] = arc.exit[i] = (cart[i] - start[i]) * inv_mm;
+    arc.entry[p_axis] = -r_start[1] * tangent;
+    arc.entry[q_axis] =  r_start[0] * tangent;
+    arc.exit[p_axis]  = -r_end[1] * tangent;
+    arc.exit[q_axis]  =  r_end[0] * tangent;
+
+    // Queue the movement
+    if (!buffer_steps(target
+      #if HAS_POSITION_FLOAT
+        , raw
+      #endif
+      , fr_mm_s, extruder, millimeters, &arc
+    )) return false;
+
+    stepper.wake_up();
+    return true;
+
+  }
+
+#endif // ARC_BLOCKS
+
+#if IS_KINEMATIC
+
+  bool Planner::buffer_segments(const uint8_t count, const float (*motor)[ABCE], const float (&cart)[XYZE]
+    #if ENABLED(JUNCTION_DEVIATION)
+      , const float (&delta_mm_cart)[XYZE]
+    #endif
+    , const float &fr_mm_s, const uint8_t extruder, const float &millimeters
+  ) {
+
+    MOTION_PROBE(BUFFER_SEGMENTS);
+
+    // If we are cleaning, do not accept queuing of movements
+    if (cleaning_buffer_flag) return false;
+
+    const bool no_e_move = printer.debugDryrun() || printer.debugSimulation();
+    bool queued = false;
+
+    for (uint8_t s = 0; s < count; s++) {
+
+      const float (&pos)[ABCE] = motor[s];
+
+      const int32_t target[XYZE] = {
+        static_cast<int32_t>(FLOOR(pos[A_AXIS] * mechanics.data.axis_steps_per_mm[A_AXIS] + 0.5f)),
+        static_cast<int32_t>(FLOOR(pos[B_AXIS] * mechanics.data.axis_steps_per_mm[B_AXIS] + 0.5f)),
+        static_cast<int32_t>(FLOOR(pos[C_AXIS] * mechanics.data.axis_steps_per_mm[C_AXIS] + 0.5f)),
+        static_cast<int32_t>(FLOOR(pos[E_AXIS] * mechanics.data.axis_steps_per_mm[E_AXIS_N(extruder)] + 0.5f))
+      };
+
+      // DRYRUN or Simulation prevents E moves from taking place
+      if (no_e_move) {
+        position[E_AXIS] = target[E_AXIS];
+        #if HAS_POSITION_FLOAT
+          position_float[E_AXIS] = pos[E_AXIS];
+        #endif
+      }
+
+      // Simulation Mode no movement
+      if (printer.debugSimulation()) {
+        LOOP_XYZ(axis)
+          position[axis] = target[axis];
+      }
+
+      // The stepper does not take a block before the lookahead,
+      // plan the queued ones before waiting for a free block
+      if (queued && !moves_free()) {
+        recalculate();
+        stepper.wake_up();
+        queued = false;
+      }
+
+      uint8_t next_buffer_head;
+      block_t * const block = get_next_free_block(next_buffer_head);
+
+      // A quick stop while waiting for the block drops the rest of the batch
+      if (cleaning_buffer_flag) return false;
+
+      // A segment too short is taken as done
+      if (!fill_block(block, false, target
+        #if HAS_POSITION_FLOAT
+          , pos
+        #endif
+        #if ENABLED(JUNCTION_DEVIATION)
+          , delta_mm_cart
+        #endif
+        , fr_mm_s, extruder, millimeters
+      )) continue;
+
+      // The first block of an empty queue waits for the others
+      if (block_buffer_head == block_buffer_tail)
+        delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
+
+      block_buffer_head = next_buffer_head;
+      MOTION_BLOCK_QUEUED();
+      queued = true;
+
+    }
+
+    if (queued) {
+      recalculate();
+      stepper.wake_up();
+    }
+
+    COPY_ARRAY(position_cart, cart);
+
+    return true;
+
+  }
+
+#endif // IS_KINEMATIC
+
 /**
  * Directly set the planner ABC position (and stepper positions)
  * converting mm (or angles for SCARA) into steps.
@@ -2224,8 +2520,7 @@ void Planner::refresh_positioning() {
 
 /** Private Function */
 /**
- * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
- * by the provided factors.
+ * Calculate trapezoid parameters, from the entry- and exit-speeds.
  **
  * ############ VERY IMPORTANT ############
  * NOTE that the PRECONDITION to call this function is that the block is
@@ -2235,7 +2530,31 @@ void Planner::refresh_positioning() {
  */
 #define MINIMAL_STEP_RATE 120
 
-void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
+void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_speed, const float &exit_speed) {
+
+  MOTION_PROBE(TRAPEZOID);
+
+  #if ENABLED(PLANNER_INTEGER_TRAPEZOID_CHECK)
+    block_t int_block;
+  #endif
+
+  #if ENABLED(PLANNER_INTEGER_TRAPEZOID)
+    // The squares of the rates must fit in 32 bit
+    if (block->nominal_rate <= PLANNER_INTEGER_MAX_RATE) {
+      #if ENABLED(PLANNER_INTEGER_TRAPEZOID_CHECK)
+        int_block = *block;
+        calculate_trapezoid_integer(&int_block, entry_speed, exit_speed);
+      #else
+        calculate_trapezoid_integer(block, entry_speed, exit_speed);
+        return;
+      #endif
+    }
+  #endif
+
+  // NOTE: Entry and exit factors always > 0 by all previous logic operations.
+  const float nomr = 1.0f / SQRT(block->nominal_speed_sqr),
+              entry_factor = entry_speed * nomr,
+              exit_factor  = exit_speed * nomr;
 
   uint32_t initial_rate = CEIL(entry_factor * block->nominal_rate),
            final_rate   = CEIL(exit_factor  * block->nominal_rate); // (steps per second)
@@ -2298,8 +2617,199 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
   #endif
   block->final_rate = final_rate;
 
+  #if ENABLED(PLANNER_INTEGER_TRAPEZOID_CHECK)
+    // Both kernels must agree within one step. The float kernel does not limit
+    // the exit rate to the nominal one, the stepper never reaches these values.
+    if (block->nominal_rate <= PLANNER_INTEGER_MAX_RATE) {
+      const uint32_t count = block->step_event_count;
+      #define INT_DIFF(F)      (ABS(int32_t(int_block.F - block->F)) > 1)
+      #define INT_DIFF_STEP(F) (ABS(int32_t(MIN(int_block.F, count) - MIN(block->F, count))) > 1)
+      if (INT_DIFF_STEP(accelerate_until) || INT_DIFF_STEP(decelerate_after) || INT_DIFF(initial_rate)
+        || (block->decelerate_after < count && INT_DIFF(final_rate))
+        #if ENABLED(BEZIER_JERK_CONTROL)
+          // The cruise rate follows the acceleration steps
+          || (int_block.accelerate_until == block->accelerate_until && INT_DIFF(cruise_rate))
+        #endif
+      ) {
+        SERIAL_SM(ER, "Planner integer trapezoid mismatch");
+        SERIAL_MV(" steps:", block->step_event_count);
+        SERIAL_MV(" accelerate:", block->accelerate_until);
+        SERIAL_MV("/", int_block.accelerate_until);
+        SERIAL_MV(" decelerate:", block->decelerate_after);
+        SERIAL_MV("/", int_block.decelerate_after);
+        SERIAL_MV(" initial:", block->initial_rate);
+        SERIAL_MV("/", int_block.initial_rate);
+        SERIAL_MV(" final:", block->final_rate);
+        SERIAL_EMV("/", int_block.final_rate);
+      }
+      #undef INT_DIFF
+      #undef INT_DIFF_STEP
+
+      // Run the integer plan
+      *block = int_block;
+    }
+  #endif
+
 }
 
+#if ENABLED(PLANNER_INTEGER_TRAPEZOID)
+
+  /**
+   * Integer square root, rounded down
+   */
+  static uint32_t isqrt(uint32_t value) {
+    uint32_t root = 0, bit = 1UL << 30;
+    while (bit > value) bit >>= 2;
+    while (bit) {
+      if (value >= root + bit) {
+        value -= root + bit;
+        root = (root >> 1) + bit;
+      }
+      else
+        root >>= 1;
+      bit >>= 2;
+    }
+    return root;
+  }
+
+  /**
+   * Same as calculate_trapezoid_for_block() in integer math. The entry and
+   * exit speeds come in float from the junction math, the rates are them by
+   * the step events per mm of the block. The nominal rate is at most
+   * PLANNER_INTEGER_MAX_RATE so every square of a rate fits in 32 bit.
+   * There is no 64 bit math.
+   */
+  void Planner::calculate_trapezoid_integer(block_t* const block, const float &entry_speed, const float &exit_speed) {
+
+    const uint32_t nominal_rate = block->nominal_rate;
+
+    // Round up like CEIL() in the float kernel, never past the nominal rate
+    uint32_t initial_rate = CEIL(entry_speed * block->steps_per_mm),
+             final_rate   = CEIL(exit_speed  * block->steps_per_mm);
+    NOMORE(initial_rate, nominal_rate);
+    NOMORE(final_rate,   nominal_rate);
+
+    // Limit minimal step rate (Otherwise the timer will overflow.)
+    NOLESS(initial_rate,  uint32_t(MINIMAL_STEP_RATE));
+    NOLESS(final_rate,    uint32_t(MINIMAL_STEP_RATE));
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      uint32_t cruise_rate = initial_rate;
+    #endif
+
+    const uint32_t  accel       = block->acceleration_steps_per_s2,
+                    accel_x2    = accel << 1,
+                    nominal_sq  = nominal_rate * nominal_rate,
+                    initial_sq  = initial_rate * initial_rate,
+                    final_sq    = final_rate * final_rate;
+
+              // Steps required for acceleration, deceleration to/from nominal rate
+    uint32_t  accelerate_steps = 0,
+              decelerate_steps = 0;
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      uint32_t accelerate_full = 0;     // Whole steps of the acceleration to the nominal rate
+    #endif
+
+    if (accel) {
+      if (initial_rate < nominal_rate) {
+        const uint32_t dist = nominal_sq - initial_sq;
+        accelerate_steps = dist / accel_x2;
+        #if ENABLED(BEZIER_JERK_CONTROL)
+          accelerate_full = accelerate_steps;
+        #endif
+        if (dist % accel_x2) accelerate_steps++;
+      }
+      if (final_rate < nominal_rate)
+        decelerate_steps = (nominal_sq - final_sq) / accel_x2;
+    }
+
+              // Steps between acceleration and deceleration, if any
+    int32_t   plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+
+    // Does accelerate_steps + decelerate_steps exceed step_event_count?
+    // Then we can't possibly reach the nominal rate, there will be no cruising.
+    // Calculate the intersection of the acceleration and of the braking, in order
+    // to reach the final_rate exactly at the end of this block.
+    if (plateau_steps < 0) {
+      accelerate_steps = 0;
+      if (accel) {
+        // (2a * count - initial^2 + final^2) / 4a rounded up, as half the count
+        // and the difference of the squares by 4a, with the odd step of the count
+        const uint32_t  count     = block->step_event_count,
+                        accel_x4  = accel_x2 << 1,
+                        odd       = (count & 1) ? accel_x2 : 0;
+        int32_t steps = count >> 1;
+        if (final_sq >= initial_sq) {
+          const uint32_t diff = final_sq - initial_sq,
+                         rest = diff % accel_x4 + odd;
+          steps += diff / accel_x4 + (rest > accel_x4 ? 2 : rest ? 1 : 0);
+        }
+        else {
+          const uint32_t diff = initial_sq - final_sq;
+          if (diff >= odd)
+            steps -= int32_t((diff - odd) / accel_x4);
+          else
+            steps++;
+        }
+        if (steps > 0) accelerate_steps = steps;
+      }
+      NOMORE(accelerate_steps, block->step_event_count);
+      plateau_steps = 0;
+
+      #if ENABLED(BEZIER_JERK_CONTROL)
+        // We won't reach the cruising rate. Let's calculate the speed we will reach,
+        // the square is saturated in 32 bit past the whole steps to the nominal rate
+        const uint32_t  whole = MIN(accelerate_steps, accelerate_full),
+                        over  = accel_x2 * (accelerate_steps - whole);
+        uint32_t rate_sq = initial_sq + accel_x2 * whole;
+        rate_sq = over > 0xFFFFFFFFUL - rate_sq ? 0xFFFFFFFFUL : rate_sq + over;
+        cruise_rate = isqrt(rate_sq);
+      #endif
+    }
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      else // We have some plateau time, so the cruise rate will be the nominal rate
+        cruise_rate = nominal_rate;
+    #endif
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      // Jerk controlled speed requires to express speed versus time, NOT steps.
+      // rate * STEPPER_TIMER_RATE / accel, with the rest of the timer rate by the
+      // acceleration made 16 bit so its product with a rate fits.
+      uint32_t  acceleration_time = 0,
+                deceleration_time = 0;
+      if (accel) {
+        const uint32_t quot = uint32_t(STEPPER_TIMER_RATE) / accel;
+        uint32_t rest = uint32_t(STEPPER_TIMER_RATE) % accel, div = accel;
+        while (rest > 0xFFFF) { rest >>= 1; div >>= 1; }
+        const uint32_t acc_rate = cruise_rate - initial_rate,
+                       dec_rate = cruise_rate - final_rate;
+        acceleration_time = acc_rate * quot + acc_rate * rest / div;
+        deceleration_time = dec_rate * quot + dec_rate * rest / div;
+      }
+
+      // And to offload calculations from the ISR, we also calculate the inverse of those times here
+      uint32_t  acceleration_time_inverse = get_period_inverse(acceleration_time),
+                deceleration_time_inverse = get_period_inverse(deceleration_time);
+    #endif
+
+    // Store new block parameters
+    block->accelerate_until = accelerate_steps;
+    block->decelerate_after = accelerate_steps + plateau_steps;
+    block->initial_rate = initial_rate;
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      block->acceleration_time = acceleration_time;
+      block->deceleration_time = deceleration_time;
+      block->acceleration_time_inverse = acceleration_time_inverse;
+      block->deceleration_time_inverse = deceleration_time_inverse;
+      block->cruise_rate = cruise_rate;
+    #endif
+    block->final_rate = final_rate;
+
+  }
+
+#endif // ENABLED(PLANNER_INTEGER_TRAPEZOID)
+
 /*                            PLANNER SPEED DEFINITION
                                      +--------+   <- current->nominal_speed
                                     /          \
@@ -2363,7 +2873,8 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
 */
 
 // The kernel called by recalculate() when scanning the plan from last to first entry.
-void Planner::reverse_pass_kernel(block_t* const current_block, const block_t* const next_block) {
+// Return true if the entry speed of the block changed.
+bool Planner::reverse_pass_kernel(block_t* const current_block, const block_t* const next_block) {
 
   if (current_block) {
     // If entry speed is already at the maximum entry speed, and there was no change of speed
@@ -2406,10 +2917,12 @@ void Planner::reverse_pass_kernel(block_t* const current_block, const block_t* c
           // Block is not BUSY, we won the race against the Stepper ISR:
           // Just Set the new entry speed
           current_block->entry_speed_sqr = new_entry_speed_sqr;
+          return true;
         }
       }
     }
   }
+  return false;
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
@@ -2467,8 +2980,15 @@ void Planner::forward_pass_kernel(const block_t* const previous_block, block_t*
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the reverse pass.
+ *
+ * The pass stops at the first block whose entry speed does not change:
+ * the blocks before it already hold the plan they would get again.
+ * It also stops after PLANNER_LOOKAHEAD_WINDOW blocks, if set. The blocks
+ * left out keep their lower entry speeds, that is always a safe plan.
+ *
+ * Return the index of the first block the forward pass has to look at.
  */
-void Planner::reverse_pass() {
+uint8_t Planner::reverse_pass() {
 
   // Initialize block index to the last block in the planner buffer.
   uint8_t block_index = prev_block_index(block_buffer_head);
@@ -2480,7 +3000,11 @@ void Planner::reverse_pass() {
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
   //  planning already consumed blocks
-  if (planned_block_index == block_buffer_head) return;
+  if (planned_block_index == block_buffer_head) return planned_block_index;
+
+  #if PLANNER_LOOKAHEAD_WINDOW > 0
+    uint8_t window = PLANNER_LOOKAHEAD_WINDOW;
+  #endif
 
   // Reverse Pass: Coarsely maximize all possible deceleration curves back-planning from the last
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
@@ -2493,7 +3017,16 @@ void Planner::reverse_pass() {
 
     // Only consider non sync blocks
     if (!TEST(current_block->flag, BLOCK_BIT_SYNC_POSITION)) {
-      reverse_pass_kernel(current_block, next_block);
+
+      #if PLANNER_LOOKAHEAD_WINDOW > 0
+        if (!window--) return block_index;
+      #endif
+
+      // The new block changes the exit speed of the one before it, so that one is
+      // always planned. From there on, an unchanged entry speed ends the pass.
+      if (!reverse_pass_kernel(current_block, next_block) && next_block)
+        return block_index;
+
       next_block = current_block;
     }
 
@@ -2506,19 +3039,22 @@ void Planner::reverse_pass() {
     while (planned_block_index != block_buffer_planned) {
 
       // If we reached the busy block or an already processed block, break the loop now
-      if (block_index == planned_block_index) return;
+      if (block_index == planned_block_index) return planned_block_index;
 
       // Advance the pointer, following the busy block
       planned_block_index = next_block_index(planned_block_index);
     }
   }
+
+  return planned_block_index;
 }
 
 /**
  * recalculate() needs to go over the current plan twice.
- * Once in reverse and once forward. This implements the forward pass.
+ * Once in reverse and once forward. This implements the forward pass,
+ * from the first block changed by the reverse pass.
  */
-void Planner::forward_pass() {
+void Planner::forward_pass(const uint8_t first_block_index) {
 
   // Forward Pass: Forward plan the acceleration curve from the planned pointer onward.
   // Also scans for optimal plan breakpoints and appropriately updates the planned pointer.
@@ -2529,6 +3065,9 @@ void Planner::forward_pass() {
   //  pass will never modify the values at the tail.
   uint8_t block_index = block_buffer_planned;
 
+  // The blocks before the first changed one are already forward planned
+  if (is_nearer_head(first_block_index, block_index)) block_index = first_block_index;
+
   block_t *current_block;
   const block_t * previous_block = nullptr;
   while (block_index != block_buffer_head) {
@@ -2558,13 +3097,17 @@ void Planner::forward_pass() {
 /**
  * Recalculate the trapezoid speed profiles for all blocks in the plan
  * according to the entry_factor for each junction. Must be called by
- * recalculate() after updating the blocks.
+ * recalculate() after updating the blocks. The blocks before the first
+ * changed one keep their trapezoid.
  */
-void Planner::recalculate_trapezoids() {
+void Planner::recalculate_trapezoids(const uint8_t first_block_index) {
 
   uint8_t block_index       = block_buffer_tail,
           head_block_index  = block_buffer_head;
 
+  if (first_block_index != head_block_index && is_nearer_head(first_block_index, block_index))
+    block_index = first_block_index;
+
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
@@ -2612,14 +3155,11 @@ void Planner::recalculate_trapezoids() {
           if (!stepper.is_block_busy(current_block)) {
             // Block is not BUSY, we won the race against the Stepper ISR:
 
-            // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-            const float current_nominal_speed = SQRT(current_block->nominal_speed_sqr),
-                        nomr = 1.0f / current_nominal_speed;
-            calculate_trapezoid_for_block(current_block, current_entry_speed * nomr, next_entry_speed * nomr);
+            calculate_trapezoid_for_block(current_block, current_entry_speed, next_entry_speed);
             #if ENABLED(LIN_ADVANCE)
               if (current_block->use_advance_lead) {
                 const float comp = current_block->e_D_ratio * extruder_advance_K * mechanics.data.axis_steps_per_mm[E_INDEX];
-                current_block->max_adv_steps = current_nominal_speed * comp;
+                current_block->max_adv_steps = SQRT(current_block->nominal_speed_sqr) * comp;
                 current_block->final_adv_steps = next_entry_speed * comp;
               }
             #endif
@@ -2652,13 +3192,11 @@ void Planner::recalculate_trapezoids() {
     if (!stepper.is_block_busy(current_block)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
-      const float next_nominal_speed = SQRT(next_block->nominal_speed_sqr),
-                  nomr = 1.0f / next_nominal_speed;
-      calculate_trapezoid_for_block(next_block, next_entry_speed * nomr, (MINIMUM_PLANNER_SPEED) * nomr);
+      calculate_trapezoid_for_block(next_block, next_entry_speed, MINIMUM_PLANNER_SPEED);
       #if ENABLED(LIN_ADVANCE)
         if (next_block->use_advance_lead) {
           const float comp = next_block->e_D_ratio * extruder_advance_K * mechanics.data.axis_steps_per_mm[E_INDEX];
-          next_block->max_adv_steps = next_nominal_speed * comp;
+          next_block->max_adv_steps = SQRT(next_block->nominal_speed_sqr) * comp;
           next_block->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
         }
       #endif
@@ -2672,14 +3210,18 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+
+  MOTION_PROBE(RECALCULATE);
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
 
   // If there is just one block, no planning can be done. Avoid it!
+  uint8_t first_block_index = block_buffer_tail;
   if (block_index != block_buffer_planned) {
-    reverse_pass();
-    forward_pass();
+    first_block_index = reverse_pass();
+    forward_pass(first_block_index);
   }
 
-  recalculate_trapezoids();
+  recalculate_trapezoids(first_block_index);
 }
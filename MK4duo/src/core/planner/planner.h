@@ -30,6 +30,63 @@
  * Copyright (c) 2009-2011 Simen Svale Skogsrud
  */
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * struct block_arc_t
+   *
+   * The arc of a block on the P and Q axes, never more than a quadrant,
+   * so the axes do not change direction. The stepper rotates the radius
+   * vector a chord at a time and steps to the end of the chord.
+   *
+   * The values are fixed point, the stepper needs no FPU. A length is in
+   * 1 / 2^ARC_STEP_BITS of a step, of the finest axis for the radius.
+   */
+  #define ARC_STEP_BITS   8
+  #define ARC_SCALE_BITS  16
+  #define ARC_TURN_BITS   30
+  #define ARC_MAX_STEPS   (1UL << (30 - ARC_STEP_BITS)) // Radius in steps of the finest axis
+
+  typedef struct {
+    int32_t   radius[2],          // Radius vector from the center to the start
+              scale[2],           // Steps of the axis per step of the finest axis, 2^ARC_SCALE_BITS = 1, negative moving back
+              origin[2],          // Start from the center, along the move
+              cos_t, sin_t;       // Rotation of a chord, 2^ARC_TURN_BITS = 1
+    uint16_t  chords;             // Number of chords, 0 for a line
+    uint8_t   p_axis, q_axis;     // Axes of the plane of the arc
+  } block_arc_t;
+
+  /**
+   * struct arc_move_t
+   *
+   * An arc for the planner. The speed of the axes and the junctions
+   * follow the tangents at the ends.
+   */
+  typedef struct {
+    block_arc_t block;
+    uint32_t    events;           // Step events along the arc, enough for the steps of every chord
+    float       radius,           // Radius, mm
+                entry[XYZE],      // Tangent at the start, per mm of the move
+                exit[XYZE];       // Tangent at the end, per mm of the move
+  } arc_move_t;
+
+#endif
+
+#if ENABLED(G5_BEZIER_CURVE)
+
+  /**
+   * struct curve_chord_t
+   *
+   * The next line as a chord of a curve. The chords of a curve join
+   * without a corner and the curvature limits the speed.
+   */
+  typedef struct {
+    float radius;                 // Radius of curvature along the chord, mm, 0 for no limit
+    bool  joined;                 // The chord follows a chord of the same curve
+  } curve_chord_t;
+
+#endif
+
 /**
  * struct block_t
  *
@@ -60,6 +117,10 @@ typedef struct block_t {
 
   uint32_t step_event_count;                // The number of step events required to complete this block
 
+  #if ENABLED(ARC_BLOCKS)
+    block_arc_t arc;                        // The arc of the block, if any
+  #endif
+
   #if EXTRUDERS > 1
     uint8_t active_extruder;                // The extruder to move (if E move)
   #else
@@ -100,6 +161,10 @@ typedef struct block_t {
             final_rate,                     // The minimal rate at exit
             acceleration_steps_per_s2;      // acceleration steps/sec^2
 
+  #if ENABLED(PLANNER_INTEGER_TRAPEZOID)
+    float     steps_per_mm;                 // Step events per mm, the step rate of a speed
+  #endif
+
   #if ENABLED(BARICUDA)
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
@@ -129,6 +194,10 @@ typedef struct block_t {
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+#if ENABLED(PLANNER_INTEGER_TRAPEZOID)
+  #define PLANNER_INTEGER_MAX_RATE  0xFFFFUL                            // Squares of the rates in 32 bit
+#endif
+
 class Planner {
 
   public: /** Constructor */
@@ -175,6 +244,10 @@ class Planner {
       static bool abort_on_endstop_hit;
     #endif
 
+    #if ENABLED(G5_BEZIER_CURVE)
+      static curve_chord_t curve;                     // The next line as a chord of a curve
+    #endif
+
   private: /** Private Parameters */
 
     /**
@@ -303,7 +376,10 @@ class Planner {
      */
     FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
       // Wait until there are enough slots free
-      while (moves_free() < count) { printer.idle(); }
+      if (moves_free() < count) {
+        MOTION_PROBE(PLANNER_WAIT);
+        while (moves_free() < count) { printer.idle(); }
+      }
 
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
@@ -320,6 +396,7 @@ class Planner {
      *  fr_mm_s       - (target) speed of the move
      *  extruder      - target extruder
      *  millimeters   - the length of the movement, if known
+     *  arc           - the arc of the movement, if any
      *
      * Returns true if movement was properly queued, false otherwise
      */
@@ -331,6 +408,9 @@ class Planner {
         , const float (&delta_mm_cart)[XYZE]
       #endif
       , float fr_mm_s, const uint8_t extruder, const float &millimeters=0.0
+      #if ENABLED(ARC_BLOCKS)
+        , const arc_move_t * const arc=NULL
+      #endif
     );
 
     /**
@@ -342,6 +422,7 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the arc of the movement, if any
      *
      * Return true is movement is acceptable, false otherwise
      */
@@ -354,6 +435,9 @@ class Planner {
         , const float (&delta_mm_cart)[XYZE]
       #endif
       , float fr_mm_s, const uint8_t extruder, const float &millimeters=0.0
+      #if ENABLED(ARC_BLOCKS)
+        , const arc_move_t * const arc=NULL
+      #endif
     );
 
     /**
@@ -420,6 +504,58 @@ class Planner {
       );
     }
 
+    #if ENABLED(ARC_BLOCKS)
+
+      /**
+       * Planner::buffer_arc
+       *
+       * Add an arc to the buffer, not more than a quadrant, as a single block.
+       * The target is cartesian, the modifiers are applied here.
+       *
+       *  cart        - target position in mm
+       *  start       - start position in mm
+       *  center      - center of the arc on the P and Q axes in mm
+       *  angle       - angle of the arc in radians, counterclockwise positive
+       *  p_axis      - first axis of the plane of the arc
+       *  q_axis      - second axis of the plane of the arc
+       *  fr_mm_s     - (target) speed of the move
+       *  extruder    - target extruder
+       *  millimeters - the length of the arc
+       */
+      static bool buffer_arc(const float (&cart)[XYZE], const float (&start)[XYZE], const float (&center)[2], const float &angle,
+        const AxisEnum p_axis, const AxisEnum q_axis, const float &fr_mm_s, const uint8_t extruder, const float &millimeters
+      );
+
+    #endif
+
+    #if IS_KINEMATIC
+
+      /**
+       * Planner::buffer_segments
+       *
+       * Add the segments of a kinematic move at once. The motor positions
+       * are already transformed. The blocks are filled one after the other
+       * and the lookahead runs once for all of them, or before waiting if
+       * the buffer is full. False if a quick stop drops the moves, even
+       * while waiting.
+       *
+       *  count         - the number of segments
+       *  motor         - the motor positions (A B C E) at the end of each segment
+       *  cart          - the cartesian position at the end of the last segment
+       *  delta_mm_cart - the cartesian distance of a segment
+       *  fr_mm_s       - (target) speed of the segments
+       *  extruder      - target extruder
+       *  millimeters   - the cartesian length of a segment
+       */
+      static bool buffer_segments(const uint8_t count, const float (*motor)[ABCE], const float (&cart)[XYZE]
+        #if ENABLED(JUNCTION_DEVIATION)
+          , const float (&delta_mm_cart)[XYZE]
+        #endif
+        , const float &fr_mm_s, const uint8_t extruder, const float &millimeters
+      );
+
+    #endif
+
     /**
      * Set the planner.position and individual stepper positions.
      * Used by G92, G28, G29, and other procedures.
@@ -610,6 +746,13 @@ class Planner {
     static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
     static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
 
+    /**
+     * Is block_index nearer to the head than other_index?
+     */
+    FORCE_INLINE static bool is_nearer_head(const uint8_t block_index, const uint8_t other_index) {
+      return BLOCK_MOD(block_buffer_head - block_index) < BLOCK_MOD(block_buffer_head - other_index);
+    }
+
     /**
      * Calculate the distance (not time) it takes to accelerate
      * from initial_rate to target_rate using the given acceleration:
@@ -650,15 +793,19 @@ class Planner {
       }
     #endif
 
-    static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
+    static void calculate_trapezoid_for_block(block_t* const block, const float &entry_speed, const float &exit_speed);
+
+    #if ENABLED(PLANNER_INTEGER_TRAPEZOID)
+      static void calculate_trapezoid_integer(block_t* const block, const float &entry_speed, const float &exit_speed);
+    #endif
 
-    static void reverse_pass_kernel(block_t* const current_block, const block_t* const next_block);
+    static bool reverse_pass_kernel(block_t* const current_block, const block_t* const next_block);
     static void forward_pass_kernel(const block_t* const previous_block, block_t* const current_block, const uint8_t block_index);
 
-    static void reverse_pass();
-    static void forward_pass();
+    static uint8_t reverse_pass();
+    static void forward_pass(const uint8_t first_block_index);
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t first_block_index);
 
     static void recalculate();
 
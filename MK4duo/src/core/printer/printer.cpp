@@ -59,6 +59,9 @@ millis_l  Printer::max_inactivity_ms  = 0,
 // Interrupt Event
 InterruptEventEnum Printer::interruptEvent = INTERRUPT_EVENT_NONE;
 
+// Tasks flagged by HAL::Tick
+volatile bool Printer::task_pending[TASK_COUNT] = { false };
+
 // Printer mode
 PrinterModeEnum Printer::mode =
   #if ENABLED(PLOTTER)
@@ -352,6 +355,11 @@ void Printer::loop() {
     commands.advance_queue();
     endstops.report_state();
 
+    #if ENABLED(ARDUINO_ARCH_LINUX)
+      // The simulation is over when every command and every move is done
+      if (Simulator::finished()) Simulator::terminate(Simulator::EXIT_DONE);
+    #endif
+
   }
 }
 
@@ -393,6 +401,10 @@ void Printer::check_periodical_actions() {
     if (card.isAutoreport()) card.print_status();
   #endif
 
+  #if ENABLED(STEPPER_PROFILER)
+    if (!isSuspendAutoreport()) profiler.auto_report();
+  #endif
+
   if (planner.cleaning_buffer_flag) {
     planner.cleaning_buffer_flag = false;
     #if ENABLED(SD_FINISHED_STEPPERRELEASE) && ENABLED(SD_FINISHED_RELEASECOMMAND)
@@ -567,6 +579,13 @@ void Printer::stop() {
  */
 void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
 
+  PROFILE_LOOP(IDLE);
+
+  #if ENABLED(STEP_CHUNK_QUEUE)
+    // Step chunks of the next blocks for the stepper
+    compressor.spin();
+  #endif
+
   #if ENABLED(SPI_ENDSTOPS)
     if (endstops.tmc_spi_homing.any
       #if ENABLED(IMPROVE_HOMING_RELIABILITY)
@@ -591,11 +610,19 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
   // Control interrupt events
   handle_interrupt_events();
 
+  // Temperature and periodical actions
+  run_tasks();
+
   // Tick timer job counter
   print_job_counter.tick();
 
   commands.get_available();
 
+  #if HAS_SD_SUPPORT && ENABLED(SD_BLOCK_READ)
+    // No room for commands, read the printed file ahead
+    if (planner.is_full() || commands.buffer_ring.isFull()) card.prefetch();
+  #endif
+
   handle_safety_watch();
 
   if (expired(&max_inactivity_ms, millis_l(max_inactive_time * 1000UL))) {
@@ -821,6 +848,37 @@ void Printer::setInterruptEvent(const InterruptEventEnum event) {
     interruptEvent = event;
 }
 
+/**
+ * Called every ms from HAL::Tick, it only flags the tasks due.
+ * The tasks run out of the interrupt in idle(), so the float
+ * work of the heaters does not delay the stepper ISR.
+ *
+ * If idle() is not called for TASK_TEMPERATURE_TIMEOUT ms nothing
+ * watches the heaters, their outputs are switched off until the
+ * temperature task runs again. The watchdog resets the printer
+ * if idle() is never called again.
+ */
+void Printer::tick_tasks() {
+
+  static millis_s cycle_1s_ms   = millis(),
+                  cycle_pid_ms  = millis();
+  static uint16_t temperature_wait_ms = 0;
+
+  // Event PID sample
+  if (expired(&cycle_pid_ms, millis_s(PID_SAMPLE_MS))) task_pending[TASK_TEMPERATURE] = true;
+
+  // Event 1.0 Second
+  if (expired(&cycle_1s_ms, 1000U)) task_pending[TASK_PERIODICAL] = true;
+
+  if (!task_pending[TASK_TEMPERATURE])
+    temperature_wait_ms = 0;
+  else if (temperature_wait_ms < TASK_TEMPERATURE_TIMEOUT)
+    temperature_wait_ms++;
+  else
+    thermalManager.output_off();
+
+}
+
 /**
  * isPrinting check
  */
@@ -931,6 +989,21 @@ void Printer::setup_pinout() {
 
 }
 
+void Printer::run_tasks() {
+
+  // The flag is cleared first, a task due while it runs is not lost
+  if (task_pending[TASK_TEMPERATURE]) {
+    task_pending[TASK_TEMPERATURE] = false;
+    thermalManager.spin();
+  }
+
+  if (task_pending[TASK_PERIODICAL]) {
+    task_pending[TASK_PERIODICAL] = false;
+    check_periodical_actions();
+  }
+
+}
+
 void Printer::handle_interrupt_events() {
 
   if (interruptEvent == INTERRUPT_EVENT_NONE) return; // Exit if none Event
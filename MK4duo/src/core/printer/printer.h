@@ -27,6 +27,9 @@
  * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
  */
 
+// Longest wait in ms of the temperature task before the heater outputs are switched off
+#define TASK_TEMPERATURE_TIMEOUT  1000
+
 union debug_flag_t {
   uint8_t all;
   struct {
@@ -105,6 +108,8 @@ class Printer {
     static InterruptEventEnum interruptEvent;
     static PrinterModeEnum    mode;
 
+    static volatile bool      task_pending[TASK_COUNT];
+
     #if ENABLED(BARICUDA)
       static int baricuda_valve_pressure;
       static int baricuda_e_to_p_pressure;
@@ -144,6 +149,8 @@ class Printer {
     static void idle(const bool ignore_stepper_queue=false);
     static void setInterruptEvent(const InterruptEventEnum event);
 
+    static void tick_tasks();
+
     static bool isPrinting();
     static bool isPaused();
 
@@ -242,6 +249,8 @@ class Printer {
 
     static void handle_interrupt_events();
 
+    static void run_tasks();
+
     static void handle_safety_watch();
 
     #if ENABLED(HOST_KEEPALIVE_FEATURE)
@@ -112,12 +112,39 @@
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "DEPENDENCY ERROR: BLOCK_BUFFER_SIZE must be a power of 2."
 #endif
+#if PLANNER_LOOKAHEAD_WINDOW < 0 || PLANNER_LOOKAHEAD_WINDOW == 1
+  #error "DEPENDENCY ERROR: PLANNER_LOOKAHEAD_WINDOW must be 0 or at least 2."
+#endif
 #if DISABLED(MAX_CMD_SIZE)
   #error "DEPENDENCY ERROR: Missing setting MAX_CMD_SIZE."
 #endif
 #if DISABLED(BUFSIZE)
   #error "DEPENDENCY ERROR: Missing setting BUFSIZE."
 #endif
+#if ENABLED(GCODE_TOKENIZER)
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "DEPENDENCY ERROR: GCODE_TOKENIZER requires FASTER_GCODE_PARSER."
+  #elif MAX_CMD_SIZE > 255
+    #error "DEPENDENCY ERROR: GCODE_TOKENIZER requires MAX_CMD_SIZE 255 or less."
+  #elif GCODE_TOKEN_PARAMS < 1 || GCODE_TOKEN_PARAMS > 26
+    #error "DEPENDENCY ERROR: GCODE_TOKEN_PARAMS must be between 1 and 26."
+  #endif
+#endif
+#if ENABLED(SD_BLOCK_READ) && (SD_READ_BUFFERS < 2 || SD_READ_BUFFERS > 16)
+  #error "DEPENDENCY ERROR: SD_READ_BUFFERS must be between 2 and 16."
+#endif
+#if ENABLED(THERMISTOR_TABLE) && THERMISTOR_TABLE_STEPS != 1 && THERMISTOR_TABLE_STEPS != 2 && THERMISTOR_TABLE_STEPS != 4 && THERMISTOR_TABLE_STEPS != 8 && THERMISTOR_TABLE_STEPS != 16
+  #error "DEPENDENCY ERROR: THERMISTOR_TABLE_STEPS must be 1, 2, 4, 8 or 16."
+#endif
+#if ENABLED(THERMISTOR_TABLE_PROGMEM) && DISABLED(THERMISTOR_TABLE)
+  #error "DEPENDENCY ERROR: THERMISTOR_TABLE_PROGMEM requires THERMISTOR_TABLE."
+#endif
+#if ENABLED(ADC_SCAN) && DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_LINUX)
+  #error "DEPENDENCY ERROR: ADC_SCAN is only for Arduino DUE and the native simulator."
+#endif
+#if ENABLED(ADC_SCAN) && (ADC_SCAN_SAMPLES < 16 || ADC_SCAN_SAMPLES > 4096)
+  #error "DEPENDENCY ERROR: ADC_SCAN_SAMPLES must be between 16 and 4096."
+#endif
 #if ENABLED(SERIAL_XON_XOFF) && RX_BUFFER_SIZE < 1024
   #error "DEPENDENCY ERROR: For SERIAL_XON_XOFF set RX_BUFFER_SIZE to 1024 or more."
 #endif
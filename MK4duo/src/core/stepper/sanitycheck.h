@@ -38,6 +38,32 @@
   #endif
 #endif
 
+#if ENABLED(STEP_PORT_OUTPUT)
+  #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_LINUX)
+    #error "DEPENDENCY ERROR: STEP_PORT_OUTPUT is only for Arduino DUE and the native simulator."
+  #elif ENABLED(DUAL_X_CARRIAGE)
+    #error "DEPENDENCY ERROR: STEP_PORT_OUTPUT is not compatible with DUAL_X_CARRIAGE."
+  #elif ENABLED(SQUARE_WAVE_STEPPING)
+    #error "DEPENDENCY ERROR: STEP_PORT_OUTPUT is not compatible with SQUARE_WAVE_STEPPING."
+  #endif
+#endif
+
+#if ENABLED(DEFERRED_STEP_PULSE) && ENABLED(LASER)
+  #error "DEPENDENCY ERROR: DEFERRED_STEP_PULSE is not compatible with LASER."
+#endif
+
+#if ENABLED(STEP_CHUNK_QUEUE)
+  #if DISABLED(CPU_32_BIT)
+    #error "DEPENDENCY ERROR: STEP_CHUNK_QUEUE is only for 32 bit boards."
+  #elif STEP_CHUNK_BUFFER_SIZE < 8 || STEP_CHUNK_BUFFER_SIZE > 256 || (STEP_CHUNK_BUFFER_SIZE & (STEP_CHUNK_BUFFER_SIZE - 1))
+    #error "DEPENDENCY ERROR: STEP_CHUNK_BUFFER_SIZE must be a power of 2 from 8 to 256."
+  #elif STEP_CHUNK_BLOCKS < 1 || STEP_CHUNK_BLOCKS >= BLOCK_BUFFER_SIZE
+    #error "DEPENDENCY ERROR: STEP_CHUNK_BLOCKS must be from 1 to BLOCK_BUFFER_SIZE - 1."
+  #elif STEP_CHUNK_MAX_ERROR < 0
+    #error "DEPENDENCY ERROR: STEP_CHUNK_MAX_ERROR must be 0 or more."
+  #endif
+#endif
+
 #if ENABLED(DIGIPOT_I2C)
   #if DISABLED(DIGIPOT_I2C_NUM_CHANNELS)
     #error "DEPENDENCY ERROR: Missing setting DIGIPOT_I2C_NUM_CHANNELS."
@@ -0,0 +1,344 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * step_compressor.cpp - Step chunks of the planned blocks
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(STEP_CHUNK_QUEUE)
+
+StepCompressor compressor;
+
+/** Private Parameters */
+step_chunk_t StepCompressor::buffer[STEP_CHUNK_BUFFER_SIZE];
+
+volatile uint8_t  StepCompressor::head  = 0,
+                  StepCompressor::tail  = 0;
+
+uint8_t StepCompressor::block_index     = 0;
+bool    StepCompressor::replay          = false;
+bool    StepCompressor::full            = false;
+uint8_t StepCompressor::full_tail       = 0;
+
+uint8_t StepCompressor::chunk_index     = 0;
+bool    StepCompressor::chunk_open      = false;
+int64_t StepCompressor::chunk_ticks     = 0;
+int32_t StepCompressor::add_min         = 0,
+        StepCompressor::add_max         = 0,
+        StepCompressor::last_error      = 0;
+
+// Divisions rounded down and up, for a positive divisor
+static inline int64_t div_floor(const int64_t n, const int64_t d) { return n >= 0 ? n / d : -((d - 1 - n) / d); }
+static inline int64_t div_ceil(const int64_t n, const int64_t d)  { return n >= 0 ? (n + d - 1) / d : -(-n / d); }
+
+/** Public Function */
+void StepCompressor::spin() {
+
+  const uint8_t nonbusy = planner.block_buffer_nonbusy,
+                planned = planner.block_buffer_planned;
+
+  // Start again from the first block the stepper did not take, after a quick stop too
+  if (BLOCK_MOD(block_index - nonbusy) > BLOCK_MOD(planned - nonbusy)) {
+    block_index = nonbusy;
+    full = false;
+  }
+
+  // The block did not fit, try it again when the stepper took chunks
+  if (full) {
+    if (tail == full_tail) return;
+    full = false;
+  }
+
+  // Only the blocks before the planned one, the planner does not change them anymore
+  while (block_index != planned && BLOCK_MOD(block_index - nonbusy) < STEP_CHUNK_BLOCKS) {
+
+    const block_t * const block = &planner.block_buffer[block_index];
+
+    // No trapezoid yet, wait for it
+    if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return;
+
+    if (!TEST(block->flag, BLOCK_BIT_SYNC_POSITION)
+      #if ENABLED(ARC_BLOCKS)
+        && !block->arc.chords
+      #endif
+      && !compress_block(block_index)
+      && head != tail
+    ) {
+      // Wait for the stepper to free the buffer, an empty buffer too small leaves the block to the ISR
+      full = true;
+      full_tail = tail;
+      return;
+    }
+
+    block_index = BLOCK_MOD(block_index + 1);
+  }
+
+}
+
+void StepCompressor::clear() {
+  tail = head;
+  replay = false;
+  full = false;
+}
+
+void StepCompressor::discard_block() {
+  while (replay && tail != head) {
+    if (buffer[tail].last) replay = false;
+    tail = CHUNK_MOD(tail + 1);
+  }
+  replay = false;
+}
+
+/** Private Function */
+
+/**
+ * The intervals of the block as Stepper::block_phase_step() computes
+ * them, with the step events of Stepper::pulse_phase_step() in between.
+ * False if the chunks do not fit in the buffer.
+ */
+bool StepCompressor::compress_block(const uint8_t index) {
+
+  const block_t * const block = &planner.block_buffer[index];
+
+  uint8_t oversampling = 0;
+
+  #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    uint32_t max_rate = block->nominal_rate;
+    while (max_rate < HAL_frequency_limit[0]) {
+      max_rate <<= 1;
+      if (max_rate >= HAL_frequency_limit[0]) break;
+      ++oversampling;
+    }
+  #endif
+
+  const uint32_t  step_event_count  = block->step_event_count << oversampling,
+                  accelerate_until  = block->accelerate_until << oversampling,
+                  decelerate_after  = block->decelerate_after << oversampling;
+
+  uint32_t  step_events_completed = 0,
+            acceleration_time     = 0,
+            deceleration_time     = 0;
+  int32_t   ticks_nominal         = -1;
+  uint8_t   steps_per_isr;
+
+  #if ENABLED(BEZIER_JERK_CONTROL)
+    bezier_curve_t bezier;
+    bezier.init(block->initial_rate, block->cruise_rate, block->acceleration_time_inverse);
+    bool bezier_2nd_half = false;
+  #else
+    uint32_t acc_step_rate = block->initial_rate;
+  #endif
+
+  chunk_index = head;
+  chunk_open = false;
+  last_error = 0;
+
+  uint32_t interval = Stepper::calc_timer_interval(block->initial_rate, &steps_per_isr, oversampling);
+  if (!add_interval(interval, steps_per_isr)) return false;
+
+  for (;;) {
+
+    // The step events of the pulse phase
+    step_events_completed += MIN(step_event_count - step_events_completed, uint32_t(steps_per_isr));
+    if (step_events_completed >= step_event_count) break;
+
+    if (step_events_completed <= accelerate_until) {
+      #if ENABLED(BEZIER_JERK_CONTROL)
+        const uint32_t acc_step_rate =
+          acceleration_time < block->acceleration_time
+            ? bezier.eval(acceleration_time)
+            : block->cruise_rate;
+      #else
+        acc_step_rate = Stepper::accelerate_rate(block, acceleration_time);
+      #endif
+      interval = Stepper::calc_timer_interval(acc_step_rate, &steps_per_isr, oversampling);
+      acceleration_time += interval;
+    }
+    else if (step_events_completed > decelerate_after) {
+      uint32_t step_rate;
+      #if ENABLED(BEZIER_JERK_CONTROL)
+        if (!bezier_2nd_half) {
+          bezier.init(block->cruise_rate, block->final_rate, block->deceleration_time_inverse);
+          bezier_2nd_half = true;
+          step_rate = block->cruise_rate;
+        }
+        else {
+          step_rate = deceleration_time < block->deceleration_time
+            ? bezier.eval(deceleration_time)
+            : block->final_rate;
+        }
+      #else
+        step_rate = Stepper::decelerate_rate(block, deceleration_time, acc_step_rate);
+      #endif
+      interval = Stepper::calc_timer_interval(step_rate, &steps_per_isr, oversampling);
+      deceleration_time += interval;
+    }
+    else {
+      if (ticks_nominal < 0)
+        ticks_nominal = Stepper::calc_timer_interval(block->nominal_rate, &steps_per_isr, oversampling);
+
+      // All the events up to the deceleration take the nominal interval
+      const uint32_t count = (MIN(decelerate_after, step_event_count - 1) - step_events_completed) / steps_per_isr + 1;
+      if (!add_run(ticks_nominal, steps_per_isr, count)) return false;
+      step_events_completed += (count - 1) * steps_per_isr;
+      continue;
+    }
+
+    // The last events of the block on time
+    if (!add_interval(interval, steps_per_isr, step_event_count - step_events_completed <= steps_per_isr)) return false;
+  }
+
+  if (chunk_open) close_chunk();
+  buffer[CHUNK_MOD(chunk_index - 1)].last = true;
+
+  commit_block(index);
+  return true;
+
+}
+
+/**
+ * Queue the chunks of the block, if the stepper did not take it
+ * in the meantime
+ */
+void StepCompressor::commit_block(const uint8_t index) {
+
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+  const uint8_t nonbusy = planner.block_buffer_nonbusy;
+  if (BLOCK_MOD(index - nonbusy) < BLOCK_MOD(planner.block_buffer_head - nonbusy)) {
+    SBI(planner.block_buffer[index].flag, BLOCK_BIT_CHUNKED);
+    head = chunk_index;
+  }
+
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+}
+
+/**
+ * Add the next interval to the chunk, if an add keeps all its events
+ * in time. The event k after the first is at k * interval + add * k * (k + 1) / 2.
+ * The last interval of a block takes no error.
+ */
+bool StepCompressor::add_interval(const uint32_t interval, const uint8_t steps, const bool last/*=false*/) {
+
+  const int64_t max_error = last ? 0 : (STEP_CHUNK_MAX_ERROR);
+
+  if (chunk_open) {
+    step_chunk_t &chunk = buffer[chunk_index];
+    if (chunk.steps == steps && chunk.count < 0xFFFF) {
+      const int64_t k     = chunk.count,
+                    sum   = k * (k + 1) / 2,
+                    ticks = chunk_ticks + interval,
+                    base  = k * chunk.interval;
+      // No interval below a tick
+      const int64_t lo = MAX(MAX(int64_t(add_min), div_ceil(ticks - max_error - base, sum)), div_ceil(1 - int64_t(chunk.interval), k)),
+                    hi = MIN(int64_t(add_max), div_floor(ticks + max_error - base, sum));
+      if (lo <= hi) {
+        add_min = lo;
+        add_max = hi;
+        chunk_ticks = ticks;
+        chunk.count++;
+        return true;
+      }
+    }
+    close_chunk();
+  }
+
+  return open_chunk(interval, steps);
+
+}
+
+/**
+ * Add count times the same interval, the first one puts the events
+ * back in time and the others are all exact.
+ */
+bool StepCompressor::add_run(const uint32_t interval, const uint8_t steps, uint32_t count) {
+
+  if (chunk_open) close_chunk();
+
+  if (last_error) {
+    if (!open_chunk(interval, steps)) return false;
+    close_chunk();
+    count--;
+  }
+
+  while (count) {
+    if (!open_chunk(interval, steps)) return false;
+    const uint16_t n = MIN(count, 0xFFFFUL);
+    buffer[chunk_index].count = n;
+    chunk_ticks = int64_t(interval) * (n - 1);
+    add_min = add_max = 0;
+    close_chunk();
+    count -= n;
+  }
+
+  return true;
+
+}
+
+/**
+ * Start a chunk with its first event in time. False if the buffer is full.
+ */
+bool StepCompressor::open_chunk(const uint32_t interval, const uint8_t steps) {
+
+  if (CHUNK_MOD(chunk_index + 1) == tail) return false;
+
+  step_chunk_t &chunk = buffer[chunk_index];
+  chunk.interval  = int64_t(interval) > last_error ? interval - last_error : 1;
+  chunk.count     = 1;
+  chunk.add       = 0;
+  chunk.steps     = steps;
+  chunk.last      = false;
+
+  last_error += int32_t(chunk.interval - interval);
+  chunk_ticks = 0;
+  add_min = INT16_MIN;
+  add_max = INT16_MAX;
+  chunk_open = true;
+
+  return true;
+
+}
+
+/**
+ * Take the add in the middle of the range and go to the next chunk
+ */
+void StepCompressor::close_chunk() {
+
+  step_chunk_t &chunk = buffer[chunk_index];
+  if (chunk.count > 1) {
+    chunk.add = (add_min + add_max) / 2;
+    const int64_t k = chunk.count - 1;
+    last_error += k * chunk.interval + chunk.add * k * (k + 1) / 2 - chunk_ticks;
+  }
+
+  chunk_index = CHUNK_MOD(chunk_index + 1);
+  chunk_open = false;
+
+}
+
+#endif // STEP_CHUNK_QUEUE
@@ -0,0 +1,149 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * step_compressor.h - Step chunks of the planned blocks
+ *
+ * The main loop runs the speed of the blocks after the running one as
+ * Stepper::block_phase_step() would, and packs the intervals between the
+ * step events in chunks of intervals growing by a constant. The stepper
+ * ISR takes the intervals of a compressed block from the chunks and does
+ * no speed computation.
+ *
+ * Only the blocks before the planned block of the planner are compressed,
+ * the new moves do not change them anymore. A block is queued whole and
+ * it is read only for the planner, as the running block. The blocks the
+ * compressor did not reach, the arc blocks and the blocks with more chunks
+ * than the buffer run the speed computation in the ISR.
+ *
+ * The first event of a chunk is on time, the others are within
+ * STEP_CHUNK_MAX_ERROR ticks. The last event of a block is on time too,
+ * the next block starts from it and the errors do not add up over the
+ * blocks. With 0 the events are the ones of the ISR.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEP_CHUNK_QUEUE)
+
+#define CHUNK_MOD(n) ((n)&(STEP_CHUNK_BUFFER_SIZE-1))
+
+struct step_chunk_t {
+  uint32_t  interval;   // Ticks before the first step event
+  uint16_t  count;      // Intervals of the chunk
+  int16_t   add;        // Ticks added to the interval after each one
+  uint8_t   steps;      // Step events per interval
+  bool      last;       // Last chunk of the block
+};
+
+class StepCompressor {
+
+  public: /** Constructor */
+
+    StepCompressor() {}
+
+  private: /** Private Parameters */
+
+    static step_chunk_t buffer[STEP_CHUNK_BUFFER_SIZE];
+
+    static volatile uint8_t head,   // Written by the main loop when a block is queued
+                            tail;   // Written by the stepper ISR
+
+    static uint8_t  block_index;    // The next block of the planner to compress
+    static bool     replay;         // The running block takes the intervals from the chunks
+    static bool     full;           // The block did not fit in the buffer
+    static uint8_t  full_tail;      // The tail when it did not fit
+
+    // The chunk under way, the chunks of a block are queued with it
+    static uint8_t  chunk_index;    // Buffer index of the chunk
+    static bool     chunk_open;     // The chunk takes more intervals
+    static int64_t  chunk_ticks;    // Ticks from the first event of the chunk to the last one
+    static int32_t  add_min,        // Range of the add that keeps the events in time
+                    add_max,
+                    last_error;     // Ticks the last event queued is late
+
+  public: /** Public Function */
+
+    /**
+     * Compress the blocks after the running one, called by the main loop
+     */
+    static void spin();
+
+    /**
+     * Drop all the chunks. Call with the stepper ISR disabled.
+     */
+    static void clear();
+
+    /**
+     * A new block for the stepper ISR, true if it takes the chunks
+     */
+    FORCE_INLINE static bool start_block(const block_t * const block) {
+      return (replay = TEST(block->flag, BLOCK_BIT_CHUNKED));
+    }
+
+    FORCE_INLINE static bool replaying() { return replay; }
+
+    /**
+     * The interval before the next step events and the count of them
+     */
+    FORCE_INLINE static uint32_t next_interval(uint8_t &steps) {
+
+      // The chunks were dropped by a quick stop, the block is aborted
+      if (tail == head) {
+        replay = false;
+        return STEPPER_TIMER_RATE / 1000;
+      }
+
+      step_chunk_t &chunk = buffer[tail];
+      const uint32_t interval = chunk.interval;
+      steps = chunk.steps;
+      if (--chunk.count)
+        chunk.interval += chunk.add;
+      else {
+        if (chunk.last) replay = false;
+        tail = CHUNK_MOD(tail + 1);
+      }
+      return interval;
+
+    }
+
+    /**
+     * Drop the chunks left of the running block, if any
+     */
+    static void discard_block();
+
+  private: /** Private Function */
+
+    static bool compress_block(const uint8_t index);
+    static void commit_block(const uint8_t index);
+
+    static bool add_interval(const uint32_t interval, const uint8_t steps, const bool last=false);
+    static bool add_run(const uint32_t interval, const uint8_t steps, uint32_t count);
+    static bool open_chunk(const uint32_t interval, const uint8_t steps);
+    static void close_chunk();
+
+};
+
+extern StepCompressor compressor;
+
+#endif // STEP_CHUNK_QUEUE
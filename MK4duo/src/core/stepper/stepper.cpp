@@ -127,19 +127,31 @@ uint32_t  Stepper::advance_dividend[XYZE] = { 0 },
           Stepper::decelerate_after       = 0,  // The point from where we need to start decelerating
           Stepper::step_event_count       = 0;  // The total event count for the current block
 
+#if ENABLED(ARC_BLOCKS)
+  uint32_t  Stepper::chord_events_end     = 0,
+            Stepper::chord_steps[XYZE]    = { 0 },
+            Stepper::chord_even[XYZE + 1] = { 0 },
+            Stepper::chord_rest[XYZE + 1] = { 0 },
+            Stepper::chord_error[XYZE + 1]= { 0 };
+  int32_t   Stepper::chord_radius[2]      = { 0 };
+  uint16_t  Stepper::chord_index          = 0;
+#endif
+
 #if EXTRUDERS > 1 || ENABLED(COLOR_MIXING_EXTRUDER)
   uint8_t Stepper::active_extruder        = 0,
           Stepper::active_extruder_driver = 0;
 #endif
 
 #if ENABLED(BEZIER_JERK_CONTROL)
-  int32_t __attribute__((used)) Stepper::bezier_A __asm__("bezier_A");    // A coefficient in Bézier speed curve with alias for assembler
-  int32_t __attribute__((used)) Stepper::bezier_B __asm__("bezier_B");    // B coefficient in Bézier speed curve with alias for assembler
-  int32_t __attribute__((used)) Stepper::bezier_C __asm__("bezier_C");    // C coefficient in Bézier speed curve with alias for assembler
-  uint32_t __attribute__((used)) Stepper::bezier_F __asm__("bezier_F");   // F coefficient in Bézier speed curve with alias for assembler
-  uint32_t __attribute__((used)) Stepper::bezier_AV __asm__("bezier_AV"); // AV coefficient in Bézier speed curve with alias for assembler
   #if ENABLED(__AVR__)
+    int32_t __attribute__((used)) Stepper::bezier_A __asm__("bezier_A");    // A coefficient in Bézier speed curve with alias for assembler
+    int32_t __attribute__((used)) Stepper::bezier_B __asm__("bezier_B");    // B coefficient in Bézier speed curve with alias for assembler
+    int32_t __attribute__((used)) Stepper::bezier_C __asm__("bezier_C");    // C coefficient in Bézier speed curve with alias for assembler
+    uint32_t __attribute__((used)) Stepper::bezier_F __asm__("bezier_F");   // F coefficient in Bézier speed curve with alias for assembler
+    uint32_t __attribute__((used)) Stepper::bezier_AV __asm__("bezier_AV"); // AV coefficient in Bézier speed curve with alias for assembler
     bool __attribute__((used)) Stepper::A_negative __asm__("A_negative"); // If A coefficient was negative
+  #else
+    bezier_curve_t Stepper::bezier;
   #endif
   bool Stepper::bezier_2nd_half = false;  // =false If Bézier curve has been initialized or not
 #endif
@@ -168,6 +180,18 @@ uint32_t Stepper::nextMainISR = 0;
 
 #endif // LIN_ADVANCE
 
+#if ENABLED(DEFERRED_STEP_PULSE)
+
+  constexpr uint32_t PULSE_ISR_NEVER      = 0xFFFFFFFF;
+  uint32_t  Stepper::nextPulseISR         = PULSE_ISR_NEVER,
+            Stepper::pulse_train_ticks    = 0;
+
+  uint8_t   Stepper::pulse_events         = 0;
+
+  bool      Stepper::pulse_active         = false;
+
+#endif // DEFERRED_STEP_PULSE
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(BEZIER_JERK_CONTROL)
   uint32_t Stepper::acc_step_rate = 0; // needed for deceleration start point
@@ -186,6 +210,16 @@ int8_t  Stepper::count_direction[NUM_AXIS]  = { 1, 1, 1, 1 };
   #endif // LASER_RASTER
 #endif // LASER
 
+#if ENABLED(STEP_PORT_OUTPUT)
+  fastio_port_t Stepper::step_port[STEP_PORTS];
+  uint32_t      Stepper::step_port_high[STEP_PORTS]                   = { 0 },
+                Stepper::axis_step_mask[XYZ][STEP_PORTS]              = { { 0 } },
+                Stepper::e_step_mask[DRIVER_EXTRUDERS][STEP_PORTS]    = { { 0 } },
+                Stepper::pulse_step_mask[STEP_PORTS]                  = { 0 };
+  uint8_t       Stepper::step_ports                                   = 0,
+                Stepper::pulse_axis_bits                              = 0;
+#endif
+
 /** Public Function */
 void Stepper::create_driver() {
 
@@ -313,6 +347,9 @@ void Stepper::factory_parameters() {
  */
 void Stepper::Step() {
 
+  // Timer count at the entry, it is the latency of the ISR
+  PROFILE_ISR_START();
+
   #if DISABLED(__AVR__)
     // Disable interrupts, to avoid ISR preemption while we reprogram the period
     // (AVR enters the ISR with global interrupts disabled, so no need to do it here)
@@ -338,8 +375,23 @@ void Stepper::Step() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      // The main ISR waits for the last edge of the pulses
+      const bool main_due = !nextMainISR && nextPulseISR == PULSE_ISR_NEVER;
+    #else
+      const bool main_due = !nextMainISR;
+    #endif
+
     // Run main stepping pulse phase ISR if we have to
-    if (!nextMainISR) pulse_phase_step();
+    if (main_due) {
+      PROFILE_PHASE(PULSE, pulse_phase_step());
+      PROFILE_STEPS(steps_per_isr);
+    }
+
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      // Run the next edge of the step pulses
+      if (!nextPulseISR) PROFILE_PHASE(PULSE, nextPulseISR = pulse_edge_step());
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
       // Run linear advance stepper ISR
@@ -347,19 +399,42 @@ void Stepper::Step() {
     #endif
 
     // Run main stepping block processing ISR if we have to
-    if (!nextMainISR) nextMainISR = block_phase_step();
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      if (!nextMainISR && nextPulseISR == PULSE_ISR_NEVER) {
+        PROFILE_PHASE(BLOCK, nextMainISR = block_phase_step());
+        // The interval runs from the first pulse of the events
+        nextMainISR = nextMainISR > pulse_train_ticks ? nextMainISR - pulse_train_ticks : 0;
+        pulse_train_ticks = 0;
+      }
+    #else
+      if (!nextMainISR) PROFILE_PHASE(BLOCK, nextMainISR = block_phase_step());
+    #endif
+
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      // The main ISR does not run while there are edges to do
+      const uint32_t next_main = nextPulseISR == PULSE_ISR_NEVER ? nextMainISR : nextPulseISR;
+    #else
+      const uint32_t next_main = nextMainISR;
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
-      uint32_t interval = MIN(nextAdvanceISR, nextMainISR); // Nearest time interval
+      uint32_t interval = MIN(nextAdvanceISR, next_main);   // Nearest time interval
     #else
-      uint32_t interval = nextMainISR;                      // Remaining stepper ISR time
+      uint32_t interval = next_main;                        // Remaining stepper ISR time
     #endif
 
     // Limit the value to the maximum possible value of the timer
     NOMORE(interval, uint32_t(HAL_TIMER_TYPE_MAX));
 
     // Compute the time remaining for the main isr
-    nextMainISR -= interval;
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      if (nextPulseISR != PULSE_ISR_NEVER) {
+        nextPulseISR -= interval;
+        pulse_train_ticks += interval;
+      }
+      else
+    #endif
+        nextMainISR -= interval;
 
     #if ENABLED(LIN_ADVANCE)
       // Compute the time remaining for the advance isr
@@ -410,6 +485,9 @@ void Stepper::Step() {
      */
     min_ticks = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + hal_timer_t(STEPPER_TIMER_MAX_INTERVAL); // ISR never takes more than 1ms, so this shouldn't cause trouble
 
+    // The next event should already have run
+    PROFILE_DEADLINE(next_isr_ticks, hal_timer_t(min_ticks - hal_timer_t(STEPPER_TIMER_MAX_INTERVAL)));
+
     /**
      * NB: If for some reason the stepper monopolizes the MPU, eventually the
      * timer will wrap around (and so will 'next_isr_ticks'). So, limit the
@@ -418,9 +496,21 @@ void Stepper::Step() {
      */
     if (!--max_loops) next_isr_ticks = min_ticks;
 
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      // An edge is never early, the timer runs it at the soonest instead of a wait.
+      // The main ISR takes the delay off its interval, so the step rate is kept.
+      if (!nextPulseISR && next_isr_ticks < min_ticks) {
+        pulse_train_ticks += hal_timer_t(min_ticks - next_isr_ticks);
+        next_isr_ticks = min_ticks;
+        break;
+      }
+    #endif
+
     // Advance pulses if not enough time to wait for the next ISR
   } while (next_isr_ticks < min_ticks);
 
+  PROFILE_ISR_END();
+
   // Schedule next interrupt
   HAL_timer_set_count(STEPPER_TIMER_NUM, hal_timer_t(next_isr_ticks));
 
@@ -429,6 +519,63 @@ void Stepper::Step() {
 
 }
 
+#if ENABLED(STEP_PORT_OUTPUT)
+
+  /**
+   * Resolve the step pins of the drivers to ports and masks.
+   * A step pin off the ports, or more ports than STEP_PORTS,
+   * leave the pulses to write the pins one by one.
+   */
+  void Stepper::init_step_ports() {
+
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+    ZERO(step_port_high);
+    ZERO(axis_step_mask);
+    ZERO(e_step_mask);
+    ZERO(pulse_step_mask);
+    pulse_axis_bits = 0;
+
+    uint8_t ports = 0;
+    bool resolved = true;
+
+    #if HAS_X_STEP
+      resolved &= add_step_pin(axis_step_mask[X_AXIS], ports, X_DRV, !driver[X_DRV]->isStep());
+      #if ENABLED(X_TWO_STEPPER_DRIVERS)
+        resolved &= add_step_pin(axis_step_mask[X_AXIS], ports, X2_DRV, !driver[X2_DRV]->isStep());
+      #endif
+    #endif
+    #if HAS_Y_STEP
+      resolved &= add_step_pin(axis_step_mask[Y_AXIS], ports, Y_DRV, !driver[Y_DRV]->isStep());
+      #if ENABLED(Y_TWO_STEPPER_DRIVERS)
+        resolved &= add_step_pin(axis_step_mask[Y_AXIS], ports, Y2_DRV, !driver[Y2_DRV]->isStep());
+      #endif
+    #endif
+    #if HAS_Z_STEP
+      resolved &= add_step_pin(axis_step_mask[Z_AXIS], ports, Z_DRV, !driver[Z_DRV]->isStep());
+      #if ENABLED(Z_TWO_STEPPER_DRIVERS) || ENABLED(Z_THREE_STEPPER_DRIVERS)
+        resolved &= add_step_pin(axis_step_mask[Z_AXIS], ports, Z2_DRV, !driver[Z2_DRV]->isStep());
+      #endif
+      #if ENABLED(Z_THREE_STEPPER_DRIVERS)
+        resolved &= add_step_pin(axis_step_mask[Z_AXIS], ports, Z3_DRV, !driver[Z3_DRV]->isStep());
+      #endif
+    #endif
+
+    // The extruders pulse with the logic of E0
+    #if HAS_EXTRUDERS && DISABLED(LIN_ADVANCE) && DISABLED(COLOR_MIXING_EXTRUDER)
+      for (uint8_t e = 0; e < DRIVER_EXTRUDERS; e++)
+        resolved &= add_step_pin(e_step_mask[e], ports, E0_DRV + e, !driver[E0_DRV]->isStep());
+    #endif
+
+    step_ports = resolved ? ports : 0;
+
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+  }
+
+#endif // STEP_PORT_OUTPUT
+
 /**
  * Check if the given block is busy or not - Must not be called from ISR contexts
  * The current_block could change in the middle of the read by an Stepper ISR, so
@@ -457,8 +604,12 @@ bool Stepper::is_block_busy(const block_t* const block) {
 
   #endif
 
-  // Return if the block is busy or not
-  return block == vnew;
+  // Return if the block is busy or not, a compressed block is as busy
+  return block == vnew
+    #if ENABLED(STEP_CHUNK_QUEUE)
+      || TEST(block->flag, BLOCK_BIT_CHUNKED)
+    #endif
+  ;
 
 }
 
@@ -1338,19 +1489,33 @@ void Stepper::pulse_phase_step() {
       axis_did_move = 0;
       current_block = NULL;
       planner.discard_current_block();
+      #if ENABLED(STEP_CHUNK_QUEUE)
+        compressor.discard_block();
+      #endif
     }
   }
 
   // If there is no current block, do nothing
   if (!current_block) return;
 
-  // Compute the count of pending loops
-  const uint32_t pending_events = step_event_count - step_events_completed;
+  // Compute the count of pending loops, an arc block stops at the end of the chord
+  #if ENABLED(ARC_BLOCKS)
+    const uint32_t pending_events = chord_events_end - step_events_completed;
+  #else
+    const uint32_t pending_events = step_event_count - step_events_completed;
+  #endif
   uint8_t events_to_do = MIN(pending_events, steps_per_isr);
 
   // Just update the value we will get at the end of the loop
   step_events_completed += events_to_do;
 
+  #if ENABLED(DEFERRED_STEP_PULSE)
+    // The edges of the pulses run from the ISR loop at their time
+    pulse_events = events_to_do;
+    nextPulseISR = 0;
+    return;
+  #endif
+
   // Get the timer count and estimate the end of the pulse
   hal_timer_t pulse_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_min_pulse_tick;
 
@@ -1410,6 +1575,8 @@ void Stepper::pulse_phase_step() {
 
 uint32_t Stepper::block_phase_step() {
 
+  MOTION_PROBE(BLOCK_PHASE);
+
   // If no queued movements, just wait 1ms for the next move
   uint32_t interval = (STEPPER_TIMER_RATE / 1000);
 
@@ -1432,25 +1599,36 @@ uint32_t Stepper::block_phase_step() {
     else {
       // Step events not completed yet...
 
+      #if ENABLED(ARC_BLOCKS)
+        // Cut the next chord of an arc block
+        if (step_events_completed >= chord_events_end) next_chord();
+      #endif
+
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) {
 
-        #if ENABLED(BEZIER_JERK_CONTROL)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate =
-            acceleration_time < current_block->acceleration_time
-              ? _eval_bezier_curve(acceleration_time)
-              : current_block->cruise_rate;
-        #else
-          acc_step_rate = HAL_MULTI_ACC(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
+        #if ENABLED(STEP_CHUNK_QUEUE)
+          if (compressor.replaying())
+            interval = compressor.next_interval(steps_per_isr);
+          else
         #endif
+        {
+          #if ENABLED(BEZIER_JERK_CONTROL)
+            // Get the next speed to use (Jerk limited!)
+            uint32_t acc_step_rate =
+              acceleration_time < current_block->acceleration_time
+                ? _eval_bezier_curve(acceleration_time)
+                : current_block->cruise_rate;
+          #else
+            acc_step_rate = accelerate_rate(current_block, acceleration_time);
+          #endif
 
-        // acc_step_rate is in steps/second
+          // acc_step_rate is in steps/second
 
-        // step_rate to timer interval
-        interval = calc_timer_interval(acc_step_rate, &steps_per_isr, oversampling_factor);
-        acceleration_time += interval;
+          // step_rate to timer interval
+          interval = calc_timer_interval(acc_step_rate, &steps_per_isr, oversampling_factor);
+          acceleration_time += interval;
+        }
 
         #if ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
@@ -1462,41 +1640,42 @@ uint32_t Stepper::block_phase_step() {
       }
       // Are we in deceleration phase
       else if (step_events_completed > decelerate_after) {
-        uint32_t step_rate;
-
-        #if ENABLED(BEZIER_JERK_CONTROL)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-        #else
-
-          // Using the old trapezoidal control
-          step_rate = HAL_MULTI_ACC(deceleration_time, current_block->acceleration_rate);
 
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
-          }
+        #if ENABLED(STEP_CHUNK_QUEUE)
+          if (compressor.replaying())
+            interval = compressor.next_interval(steps_per_isr);
           else
-            step_rate = current_block->final_rate;
         #endif
+        {
+          uint32_t step_rate;
+
+          #if ENABLED(BEZIER_JERK_CONTROL)
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              bezier_2nd_half = true;
+              // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+              step_rate = current_block->cruise_rate;
+            }
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                : current_block->final_rate;
+            }
+          #else
 
-        // step_rate is in steps/second
+            // Using the old trapezoidal control
+            step_rate = decelerate_rate(current_block, deceleration_time, acc_step_rate);
+          #endif
 
-        // step_rate to timer interval
-        interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
-        deceleration_time += interval;
+          // step_rate is in steps/second
+
+          // step_rate to timer interval
+          interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
+          deceleration_time += interval;
+        }
 
         #if ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
@@ -1519,14 +1698,21 @@ uint32_t Stepper::block_phase_step() {
           if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
         #endif
 
-        // Calculate the ticks_nominal for this nominal speed, if not done yet
-        if (ticks_nominal < 0) {
-          // step_rate to timer interval and loops for the nominal speed
-          ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr, oversampling_factor);
-        }
+        #if ENABLED(STEP_CHUNK_QUEUE)
+          if (compressor.replaying())
+            interval = compressor.next_interval(steps_per_isr);
+          else
+        #endif
+        {
+          // Calculate the ticks_nominal for this nominal speed, if not done yet
+          if (ticks_nominal < 0) {
+            // step_rate to timer interval and loops for the nominal speed
+            ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr, oversampling_factor);
+          }
 
-        // The timer interval is just the nominal value for the nominal speed
-        interval = ticks_nominal;
+          // The timer interval is just the nominal value for the nominal speed
+          interval = ticks_nominal;
+        }
       }
     }
   }
@@ -1551,6 +1737,8 @@ uint32_t Stepper::block_phase_step() {
           return interval; // No more queued movements!
       }
 
+      MOTION_BLOCK_START(current_block);
+
       #if HAS_SD_RESTART
         restart.job_info.sdpos = current_block->sdpos;
       #endif
@@ -1670,6 +1858,25 @@ uint32_t Stepper::block_phase_step() {
       accelerate_until = current_block->accelerate_until << oversampling;
       decelerate_after = current_block->decelerate_after << oversampling;
 
+      #if ENABLED(ARC_BLOCKS)
+        if (current_block->arc.chords) {
+          // Start the first chord of the arc, the step events are shared evenly by the chords
+          const uint16_t chords = current_block->arc.chords;
+          for (uint8_t i = 0; i <= XYZE; i++) {
+            const uint32_t count = i < XYZE ? current_block->steps[i] : step_event_count;
+            chord_even[i] = count / chords;
+            chord_rest[i] = count % chords;
+            chord_error[i] = chords >> 1;
+          }
+          COPY_ARRAY(chord_radius, current_block->arc.radius);
+          ZERO(chord_steps);
+          chord_events_end = chord_index = 0;
+          next_chord();
+        }
+        else
+          chord_events_end = step_event_count;
+      #endif
+
       #if ENABLED(COLOR_MIXING_EXTRUDER)
         mixer.stepper_setup(current_block->b_color);
       #endif
@@ -1741,8 +1948,13 @@ uint32_t Stepper::block_phase_step() {
          if (current_block->laser_mode == RASTER) counter_raster = 0;
       #endif
 
-      // Calculate the initial timer interval
-      interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr, oversampling_factor);
+      // Calculate the initial timer interval, a compressed block takes the intervals of its chunks
+      #if ENABLED(STEP_CHUNK_QUEUE)
+        if (compressor.start_block(current_block))
+          interval = compressor.next_interval(steps_per_isr);
+        else
+      #endif
+          interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr, oversampling_factor);
     }
   }
 
@@ -1759,12 +1971,109 @@ uint32_t Stepper::block_phase_step() {
   return interval;
 }
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Rotate the radius vector to the end of the next chord and trace the
+   * chord from the end of the last one. The last chord ends on the steps
+   * of the block, so the error of the rotations does not add up.
+   */
+  void Stepper::next_chord() {
+
+    const block_arc_t &arc = current_block->arc;
+    const bool last = ++chord_index >= arc.chords;
+
+    uint32_t target[XYZE];
+    if (last) {
+      LOOP_XYZE(i) target[i] = current_block->steps[i];
+      chord_events_end = step_event_count;
+    }
+    else {
+      // The linear axis, the extruder and the step events go along evenly
+      LOOP_XYZE(i) {
+        target[i] = chord_steps[i] + chord_even[i];
+        if ((chord_error[i] += chord_rest[i]) >= arc.chords) { chord_error[i] -= arc.chords; target[i]++; }
+      }
+      chord_events_end += chord_even[XYZE];
+      if ((chord_error[XYZE] += chord_rest[XYZE]) >= arc.chords) { chord_error[XYZE] -= arc.chords; chord_events_end++; }
+
+      // Rotate the radius vector
+      const int32_t r_p = chord_radius[0], r_q = chord_radius[1];
+      chord_radius[0] = (int64_t(r_p) * arc.cos_t - int64_t(r_q) * arc.sin_t + (1L << (ARC_TURN_BITS - 1))) >> ARC_TURN_BITS;
+      chord_radius[1] = (int64_t(r_p) * arc.sin_t + int64_t(r_q) * arc.cos_t + (1L << (ARC_TURN_BITS - 1))) >> ARC_TURN_BITS;
+
+      // The axes of the arc, never back and never past the end of the block
+      const uint8_t axis[2] = { arc.p_axis, arc.q_axis };
+      for (uint8_t i = 0; i < 2; i++) {
+        const uint8_t a = axis[i];
+        const int64_t steps = ((int64_t(chord_radius[i]) * arc.scale[i]) >> ARC_SCALE_BITS) - arc.origin[i];
+        if (steps <= int64_t(chord_steps[a]) << ARC_STEP_BITS)
+          target[a] = chord_steps[a];
+        else if (steps >= int64_t(current_block->steps[a]) << ARC_STEP_BITS)
+          target[a] = current_block->steps[a];
+        else
+          target[a] = (steps + (1L << (ARC_STEP_BITS - 1))) >> ARC_STEP_BITS;
+      }
+    }
+
+    // Bresenham dividends of the chord, the planner gives every chord the events of its steps
+    LOOP_XYZE(i) {
+      advance_dividend[i] = (target[i] - chord_steps[i]) << 1;
+      chord_steps[i] = target[i];
+    }
+
+    // Bresenham divisor and delta errors of the chord
+    const uint32_t events = chord_events_end - step_events_completed;
+    advance_divisor = events << 1;
+    delta_error[X_AXIS] = delta_error[Y_AXIS] = delta_error[Z_AXIS] = delta_error[E_AXIS] = -int32_t(events);
+
+  }
+
+#endif // ARC_BLOCKS
+
+#if ENABLED(DEFERRED_STEP_PULSE)
+
+  /**
+   * The next edge of the step pulses. The ISR loop never runs an edge
+   * before its time, it programs the timer for it. The pulse ends after
+   * the minimum pulse ticks, the next one starts after the rest of the
+   * pulse cycle. An aborted block drops the pulses still to do.
+   */
+  uint32_t Stepper::pulse_edge_step() {
+
+    if (abort_current_block) pulse_events = 0;
+
+    if (pulse_active) {
+      pulse_tick_stop();
+      pulse_active = false;
+      return pulse_events ? MAX(HAL_add_pulse_ticks, 1UL) : PULSE_ISR_NEVER;
+    }
+
+    if (!pulse_events) return PULSE_ISR_NEVER;
+
+    pulse_tick_start();
+    pulse_active = true;
+    --pulse_events;
+    return MAX(HAL_min_pulse_tick, 1UL);
+
+  }
+
+#endif // DEFERRED_STEP_PULSE
+
 FORCE_INLINE void Stepper::pulse_tick_start() {
 
+  #if ENABLED(STEP_PORT_OUTPUT)
+    // The axes to step, written a port at once at the end
+    uint8_t axis_bits = 0;
+    #define START_STEP(A) SBI(axis_bits, A##_AXIS)
+  #else
+    #define START_STEP(A) start_##A##_step()
+  #endif
+
   #if HAS_X_STEP
     delta_error[X_AXIS] += advance_dividend[X_AXIS];
     if (delta_error[X_AXIS] >= 0) {
-      start_X_step();
+      START_STEP(X);
       count_position[X_AXIS] += count_direction[X_AXIS];
     }
   #endif
@@ -1772,7 +2081,7 @@ FORCE_INLINE void Stepper::pulse_tick_start() {
   #if HAS_Y_STEP
     delta_error[Y_AXIS] += advance_dividend[Y_AXIS];
     if (delta_error[Y_AXIS] >= 0) {
-      start_Y_step();
+      START_STEP(Y);
       count_position[Y_AXIS] += count_direction[Y_AXIS];
     }
   #endif
@@ -1780,7 +2089,7 @@ FORCE_INLINE void Stepper::pulse_tick_start() {
   #if HAS_Z_STEP
     delta_error[Z_AXIS] += advance_dividend[Z_AXIS];
     if (delta_error[Z_AXIS] >= 0) {
-      start_Z_step();
+      START_STEP(Z);
       count_position[Z_AXIS] += count_direction[Z_AXIS];
     }
   #endif
@@ -1805,12 +2114,22 @@ FORCE_INLINE void Stepper::pulse_tick_start() {
 
     delta_error[E_AXIS] += advance_dividend[E_AXIS];
     if (delta_error[E_AXIS] >= 0) {
-      E_STEP_WRITE(active_extruder_driver, !driver[E0_DRV]->isStep());
+      #if ENABLED(STEP_PORT_OUTPUT)
+        START_STEP(E);
+      #else
+        E_STEP_WRITE(active_extruder_driver, !driver[E0_DRV]->isStep());
+      #endif
       count_position[E_AXIS] += count_direction[E_AXIS];
     }
 
   #endif
 
+  #undef START_STEP
+
+  #if ENABLED(STEP_PORT_OUTPUT)
+    start_port_steps(axis_bits);
+  #endif
+
 }
 
 FORCE_INLINE void Stepper::pulse_tick_stop() {
@@ -1818,21 +2137,27 @@ FORCE_INLINE void Stepper::pulse_tick_stop() {
   #if HAS_X_STEP
     if (delta_error[X_AXIS] >= 0) {
       delta_error[X_AXIS] -= advance_divisor;
-      stop_X_step();
+      #if DISABLED(STEP_PORT_OUTPUT)
+        stop_X_step();
+      #endif
     }
   #endif
 
   #if HAS_Y_STEP
     if (delta_error[Y_AXIS] >= 0) {
       delta_error[Y_AXIS] -= advance_divisor;
-      stop_Y_step();
+      #if DISABLED(STEP_PORT_OUTPUT)
+        stop_Y_step();
+      #endif
     }
   #endif
 
   #if HAS_Z_STEP
     if (delta_error[Z_AXIS] >= 0) {
       delta_error[Z_AXIS] -= advance_divisor;
-      stop_Z_step();
+      #if DISABLED(STEP_PORT_OUTPUT)
+        stop_Z_step();
+      #endif
     }
   #endif
 
@@ -1845,13 +2170,108 @@ FORCE_INLINE void Stepper::pulse_tick_stop() {
     #elif HAS_EXTRUDERS
       if (delta_error[E_AXIS] >= 0) {
         delta_error[E_AXIS] -= advance_divisor;
-        E_STEP_WRITE(active_extruder_driver, driver[E0_DRV]->isStep());
+        #if DISABLED(STEP_PORT_OUTPUT)
+          E_STEP_WRITE(active_extruder_driver, driver[E0_DRV]->isStep());
+        #endif
       }
     #endif
   #endif
 
+  #if ENABLED(STEP_PORT_OUTPUT)
+    stop_port_steps();
+  #endif
+
 }
 
+#if ENABLED(STEP_PORT_OUTPUT)
+
+  /**
+   * Start the steps of the axes, one write to set and one to clear the
+   * pins of each port. The motors of an axis apart, homing to their own
+   * endstops, and the pins off the ports are written one by one.
+   */
+  FORCE_INLINE void Stepper::start_port_steps(const uint8_t axis_bits) {
+
+    if (!step_ports
+      #if HAS_MULTI_ENDSTOP || ENABLED(Z_STEPPER_AUTO_ALIGN)
+        || separate_multi_axis
+      #endif
+    ) {
+      if (TEST(axis_bits, X_AXIS)) start_X_step();
+      if (TEST(axis_bits, Y_AXIS)) start_Y_step();
+      if (TEST(axis_bits, Z_AXIS)) start_Z_step();
+      #if HAS_EXTRUDERS
+        if (TEST(axis_bits, E_AXIS)) E_STEP_WRITE(active_extruder_driver, !driver[E0_DRV]->isStep());
+      #endif
+      pulse_axis_bits = axis_bits;
+      return;
+    }
+
+    for (uint8_t p = 0; p < step_ports; p++) {
+      uint32_t mask = 0;
+      if (TEST(axis_bits, X_AXIS)) mask |= axis_step_mask[X_AXIS][p];
+      if (TEST(axis_bits, Y_AXIS)) mask |= axis_step_mask[Y_AXIS][p];
+      if (TEST(axis_bits, Z_AXIS)) mask |= axis_step_mask[Z_AXIS][p];
+      #if HAS_EXTRUDERS
+        if (TEST(axis_bits, E_AXIS)) mask |= e_step_mask[active_extruder_driver][p];
+      #endif
+      if (mask) {
+        PORT_SET(step_port[p], mask & step_port_high[p]);
+        PORT_CLEAR(step_port[p], mask & ~step_port_high[p]);
+        pulse_step_mask[p] = mask;
+      }
+    }
+
+  }
+
+  FORCE_INLINE void Stepper::stop_port_steps() {
+
+    if (pulse_axis_bits) {
+      if (TEST(pulse_axis_bits, X_AXIS)) stop_X_step();
+      if (TEST(pulse_axis_bits, Y_AXIS)) stop_Y_step();
+      if (TEST(pulse_axis_bits, Z_AXIS)) stop_Z_step();
+      #if HAS_EXTRUDERS
+        if (TEST(pulse_axis_bits, E_AXIS)) E_STEP_WRITE(active_extruder_driver, driver[E0_DRV]->isStep());
+      #endif
+      pulse_axis_bits = 0;
+      return;
+    }
+
+    for (uint8_t p = 0; p < step_ports; p++) {
+      const uint32_t mask = pulse_step_mask[p];
+      if (mask) {
+        PORT_CLEAR(step_port[p], mask & step_port_high[p]);
+        PORT_SET(step_port[p], mask & ~step_port_high[p]);
+        pulse_step_mask[p] = 0;
+      }
+    }
+
+  }
+
+  bool Stepper::add_step_pin(uint32_t (&mask)[STEP_PORTS], uint8_t &ports, const uint8_t d, const bool high) {
+
+    if (!driver[d]) return true;
+
+    const pin_t pin = driver[d]->data.pin.step;
+    if (!PORT_VALID(pin)) return false;
+
+    // The slot of the port, a new one for a port not seen yet
+    const fastio_port_t port = PORT_OF(pin);
+    uint8_t p = 0;
+    while (p < ports && step_port[p] != port) p++;
+    if (p == ports) {
+      if (ports == STEP_PORTS) return false;
+      step_port[ports++] = port;
+    }
+
+    mask[p] |= PORT_MASK(pin);
+    if (high) step_port_high[p] |= PORT_MASK(pin);
+    return true;
+
+  }
+
+#endif // STEP_PORT_OUTPUT
+
 /**
  * Start X Y Z Step
  */
@@ -3062,32 +3482,13 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
 
   #else // !ENABLED(__AVR__)
 
+    // The curve of stepper.h, the StepCompressor runs it too
     FORCE_INLINE void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
-      // Calculate the Bézier coefficients
-      bezier_A =  768 * (v1 - v0);
-      bezier_B = 1920 * (v0 - v1);
-      bezier_C = 1280 * (v1 - v0);
-      bezier_F =  128 * v0;
-      bezier_AV = av;
+      bezier.init(v0, v1, av);
     }
 
     FORCE_INLINE int32_t Stepper::_eval_bezier_curve(const uint32_t curr_step) {
-      uint32_t t = bezier_AV * curr_step;               // t: Range 0 - 1^32 = 32 bits
-      uint64_t f = t;
-      f *= t;                                           // Range 32*2 = 64 bits (unsigned)
-      f >>= 32;                                         // Range 32 bits  (unsigned)
-      f *= t;                                           // Range 32*2 = 64 bits  (unsigned)
-      f >>= 32;                                         // Range 32 bits : f = t^3  (unsigned)
-      int64_t acc = (int64_t) bezier_F << 31;           // Range 63 bits (signed)
-      acc += ((uint32_t) f >> 1) * (int64_t) bezier_C;  // Range 29bits + 31 = 60bits (plus sign)
-      f *= t;                                           // Range 32*2 = 64 bits
-      f >>= 32;                                         // Range 32 bits : f = t^3  (unsigned)
-      acc += ((uint32_t) f >> 1) * (int64_t) bezier_B;  // Range 29bits + 31 = 60bits (plus sign)
-      f *= t;                                           // Range 32*2 = 64 bits
-      f >>= 32;                                         // Range 32 bits : f = t^3  (unsigned)
-      acc += ((uint32_t) f >> 1) * (int64_t) bezier_A;  // Range 28bits + 31 = 59bits (plus sign)
-      acc >>= (31 + 7);                                 // Range 24bits (plus sign)
-      return (int32_t) acc;
+      return bezier.eval(curr_step);
     }
 
   #endif // !ENABLED(__AVR__)
@@ -43,6 +43,11 @@
 
 #include "stepper_macro.h"
 
+#if ENABLED(STEP_PORT_OUTPUT)
+  // Ports of the step pins written at once, more ports write the pins one by one
+  #define STEP_PORTS 4
+#endif
+
 // Struct Stepper data
 typedef struct {
   uint32_t  maximum_rate,
@@ -50,6 +55,52 @@ typedef struct {
   uint8_t   minimum_pulse;
   bool      quad_stepping;
 } stepper_data_t;
+
+#if ENABLED(BEZIER_JERK_CONTROL) && DISABLED(__AVR__)
+
+  /**
+   * The Bzier speed curve of the 32 bit boards, run by the stepper ISR and
+   * by the StepCompressor. AVR runs it in assembler, see stepper.cpp.
+   */
+  struct bezier_curve_t {
+
+    int32_t   A,  // A coefficient in Bzier speed curve
+              B,  // B coefficient in Bzier speed curve
+              C;  // C coefficient in Bzier speed curve
+    uint32_t  F,  // F coefficient in Bzier speed curve
+              AV; // AV coefficient in Bzier speed curve
+
+    FORCE_INLINE void init(const int32_t v0, const int32_t v1, const uint32_t av) {
+      // Calculate the Bzier coefficients
+      A =  768 * (v1 - v0);
+      B = 1920 * (v0 - v1);
+      C = 1280 * (v1 - v0);
+      F =  128 * v0;
+      AV = av;
+    }
+
+    FORCE_INLINE int32_t eval(const uint32_t curr_step) const {
+      uint32_t t = AV * curr_step;                // t: Range 0 - 1^32 = 32 bits
+      uint64_t f = t;
+      f *= t;                                     // Range 32*2 = 64 bits (unsigned)
+      f >>= 32;                                   // Range 32 bits  (unsigned)
+      f *= t;                                     // Range 32*2 = 64 bits  (unsigned)
+      f >>= 32;                                   // Range 32 bits : f = t^3  (unsigned)
+      int64_t acc = (int64_t) F << 31;            // Range 63 bits (signed)
+      acc += ((uint32_t) f >> 1) * (int64_t) C;   // Range 29bits + 31 = 60bits (plus sign)
+      f *= t;                                     // Range 32*2 = 64 bits
+      f >>= 32;                                   // Range 32 bits : f = t^3  (unsigned)
+      acc += ((uint32_t) f >> 1) * (int64_t) B;   // Range 29bits + 31 = 60bits (plus sign)
+      f *= t;                                     // Range 32*2 = 64 bits
+      f >>= 32;                                   // Range 32 bits : f = t^3  (unsigned)
+      acc += ((uint32_t) f >> 1) * (int64_t) A;   // Range 28bits + 31 = 59bits (plus sign)
+      acc >>= (31 + 7);                           // Range 24bits (plus sign)
+      return (int32_t) acc;
+    }
+
+  };
+
+#endif
   
 class Stepper {
 
@@ -105,6 +156,17 @@ class Stepper {
                     decelerate_after,       // The point from where we need to start decelerating
                     step_event_count;       // The total event count for the current block
 
+    #if ENABLED(ARC_BLOCKS)
+      // The chord of an arc block under way
+      static uint32_t chord_events_end,       // The step event at the end of the chord, the end of the block for a line
+                      chord_steps[XYZE],      // The steps of each axis at the end of the chord
+                      chord_even[XYZE + 1],   // Steps of each axis and step events of every chord, the events last
+                      chord_rest[XYZE + 1],   // The rest of the division by the chords, shared as Bresenham
+                      chord_error[XYZE + 1];
+      static int32_t  chord_radius[2];        // Radius vector at the end of the chord
+      static uint16_t chord_index;            // The chord under way
+    #endif
+
     #if EXTRUDERS > 1 || ENABLED(COLOR_MIXING_EXTRUDER)
       static uint8_t  active_extruder,        // Active extruder
                       active_extruder_driver; // Active extruder driver
@@ -114,13 +176,15 @@ class Stepper {
     #endif
 
     #if ENABLED(BEZIER_JERK_CONTROL)
-      static int32_t  bezier_A,     // A coefficient in Bzier speed curve
-                      bezier_B,     // B coefficient in Bzier speed curve
-                      bezier_C;     // C coefficient in Bzier speed curve
-      static uint32_t bezier_F,     // F coefficient in Bzier speed curve
-                      bezier_AV;    // AV coefficient in Bzier speed curve
       #if ENABLED(__AVR__)
+        static int32_t  bezier_A,   // A coefficient in Bzier speed curve
+                        bezier_B,   // B coefficient in Bzier speed curve
+                        bezier_C;   // C coefficient in Bzier speed curve
+        static uint32_t bezier_F,   // F coefficient in Bzier speed curve
+                        bezier_AV;  // AV coefficient in Bzier speed curve
         static bool A_negative;     // If A coefficient was negative
+      #else
+        static bezier_curve_t bezier; // Bzier speed curve
       #endif
       static bool bezier_2nd_half;  // If Bzier curve has been initialized or not
     #endif
@@ -133,6 +197,13 @@ class Stepper {
       static bool     LA_use_advance_lead;
     #endif // !LIN_ADVANCE
 
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      static uint32_t nextPulseISR,       // Time remaining for the next edge of the step pulses
+                      pulse_train_ticks;  // Time from the first pulse of the step events
+      static uint8_t  pulse_events;       // Step events still to pulse
+      static bool     pulse_active;       // A step pulse is active
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(BEZIER_JERK_CONTROL)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -164,6 +235,16 @@ class Stepper {
       #endif
     #endif
 
+    #if ENABLED(STEP_PORT_OUTPUT)
+      static fastio_port_t  step_port[STEP_PORTS];                      // Ports of the step pins
+      static uint32_t       step_port_high[STEP_PORTS],                 // Step pins pulsed high
+                            axis_step_mask[XYZ][STEP_PORTS],            // Step pins of each axis
+                            e_step_mask[DRIVER_EXTRUDERS][STEP_PORTS],  // Step pin of each extruder driver
+                            pulse_step_mask[STEP_PORTS];                // Step pins of the pulse under way
+      static uint8_t        step_ports,                                 // Ports in use, 0 writes the pins one by one
+                            pulse_axis_bits;                            // Axes of the pulse written pin by pin
+    #endif
+
   public: /** Public Function */
 
     /**
@@ -186,6 +267,14 @@ class Stepper {
      */
     static void Step();
 
+    #if ENABLED(STEP_PORT_OUTPUT)
+      /**
+       * Resolve the step pins of the drivers to ports and masks.
+       * Call it after the driver pins or the step logic change.
+       */
+      static void init_step_ports();
+    #endif
+
     /**
      * Check if the given block is busy or not - Must not be called from ISR contexts
      */
@@ -351,6 +440,84 @@ class Stepper {
       FORCE_INLINE static float laser_intensity() { return current_block->laser_intensity; }
     #endif
 
+    /**
+     * The timer interval for a step rate and the step events of the interval
+     */
+    FORCE_INLINE static hal_timer_t calc_timer_interval(uint32_t step_rate, uint8_t* loops, uint8_t scale) {
+
+      uint8_t multistep = 1;
+
+      // Scale the frequency, as requested by the caller
+      step_rate <<= scale;
+
+      if (data.quad_stepping) {
+        // Select the proper multistepping
+        uint8_t idx = 0;
+        while (idx < 7 && step_rate > HAL_frequency_limit[idx]) {
+          step_rate >>= 1;
+          multistep <<= 1;
+          ++idx;
+        };
+      }
+      else 
+        NOMORE(step_rate, HAL_frequency_limit[0]);
+
+      *loops = multistep;
+
+      #if ENABLED(CPU_32_BIT)
+        // In case of high-performance processor, it is able to calculate in real-time
+        return uint32_t(STEPPER_TIMER_RATE) / step_rate;
+      #else
+        hal_timer_t timer;
+        constexpr uint32_t min_step_rate = F_CPU / 500000U;
+        NOLESS(step_rate, min_step_rate);
+        step_rate -= min_step_rate;   // Correct for minimal speed
+        if (step_rate >= (8 * 256)) { // higher step rate
+          const uint8_t   tmp_step_rate = (step_rate & 0x00FF);
+          const uint16_t  table_address = (uint16_t)&speed_lookuptable_fast[(uint8_t)(step_rate >> 8)][0],
+                          gain = (uint16_t)pgm_read_word_near(table_address + 2);
+          timer = MultiU16X8toH16(tmp_step_rate, gain);
+          timer = (uint16_t)pgm_read_word_near(table_address) - timer;
+        }
+        else { // lower step rates
+          uint16_t table_address = (uint16_t)&speed_lookuptable_slow[0][0];
+          table_address += ((step_rate) >> 1) & 0xFFFC;
+          timer = (uint16_t)pgm_read_word_near(table_address)
+                - (((uint16_t)pgm_read_word_near(table_address + 2) * (uint8_t)(step_rate & 0x0007)) >> 3);
+        }
+
+        return timer;
+      #endif
+
+    }
+
+    #if DISABLED(BEZIER_JERK_CONTROL)
+
+      /**
+       * The step rate of the trapezoid after time ticks of acceleration
+       */
+      FORCE_INLINE static uint32_t accelerate_rate(const block_t * const block, const uint32_t time) {
+        uint32_t step_rate = HAL_MULTI_ACC(time, block->acceleration_rate) + block->initial_rate;
+        NOMORE(step_rate, block->nominal_rate);
+        return step_rate;
+      }
+
+      /**
+       * The step rate of the trapezoid after time ticks of deceleration from rate
+       */
+      FORCE_INLINE static uint32_t decelerate_rate(const block_t * const block, const uint32_t time, const uint32_t rate) {
+        uint32_t step_rate = HAL_MULTI_ACC(time, block->acceleration_rate);
+        if (step_rate < rate) { // Still decelerating?
+          step_rate = rate - step_rate;
+          NOLESS(step_rate, block->final_rate);
+        }
+        else
+          step_rate = block->final_rate;
+        return step_rate;
+      }
+
+    #endif
+
   private: /** Private Function */
 
     /**
@@ -363,6 +530,20 @@ class Stepper {
      */
     static uint32_t block_phase_step();
 
+    #if ENABLED(ARC_BLOCKS)
+      /**
+       * Start the next chord of an arc block
+       */
+      static void next_chord();
+    #endif
+
+    #if ENABLED(DEFERRED_STEP_PULSE)
+      /**
+       * The next edge of the step pulses, without waiting in the pulse phase
+       */
+      static uint32_t pulse_edge_step();
+    #endif
+
     /**
      * Pulse tick Start
      */
@@ -387,6 +568,15 @@ class Stepper {
     FORCE_INLINE static void stop_Y_step();
     FORCE_INLINE static void stop_Z_step();
 
+    #if ENABLED(STEP_PORT_OUTPUT)
+      /**
+       * Start and stop the steps of the axes, a port at once
+       */
+      FORCE_INLINE static void start_port_steps(const uint8_t axis_bits);
+      FORCE_INLINE static void stop_port_steps();
+      static bool add_step_pin(uint32_t (&mask)[STEP_PORTS], uint8_t &ports, const uint8_t d, const bool high);
+    #endif
+
     /**
      * Set X Y Z direction
      */
@@ -436,54 +626,6 @@ class Stepper {
       }
     #endif
 
-    FORCE_INLINE static hal_timer_t calc_timer_interval(uint32_t step_rate, uint8_t* loops, uint8_t scale) {
-
-      uint8_t multistep = 1;
-
-      // Scale the frequency, as requested by the caller
-      step_rate <<= scale;
-
-      if (data.quad_stepping) {
-        // Select the proper multistepping
-        uint8_t idx = 0;
-        while (idx < 7 && step_rate > HAL_frequency_limit[idx]) {
-          step_rate >>= 1;
-          multistep <<= 1;
-          ++idx;
-        };
-      }
-      else 
-        NOMORE(step_rate, HAL_frequency_limit[0]);
-
-      *loops = multistep;
-
-      #if ENABLED(CPU_32_BIT)
-        // In case of high-performance processor, it is able to calculate in real-time
-        return uint32_t(STEPPER_TIMER_RATE) / step_rate;
-      #else
-        hal_timer_t timer;
-        constexpr uint32_t min_step_rate = F_CPU / 500000U;
-        NOLESS(step_rate, min_step_rate);
-        step_rate -= min_step_rate;   // Correct for minimal speed
-        if (step_rate >= (8 * 256)) { // higher step rate
-          const uint8_t   tmp_step_rate = (step_rate & 0x00FF);
-          const uint16_t  table_address = (uint16_t)&speed_lookuptable_fast[(uint8_t)(step_rate >> 8)][0],
-                          gain = (uint16_t)pgm_read_word_near(table_address + 2);
-          timer = MultiU16X8toH16(tmp_step_rate, gain);
-          timer = (uint16_t)pgm_read_word_near(table_address) - timer;
-        }
-        else { // lower step rates
-          uint16_t table_address = (uint16_t)&speed_lookuptable_slow[0][0];
-          table_address += ((step_rate) >> 1) & 0xFFFC;
-          timer = (uint16_t)pgm_read_word_near(table_address)
-                - (((uint16_t)pgm_read_word_near(table_address + 2) * (uint8_t)(step_rate & 0x0007)) >> 3);
-        }
-
-        return timer;
-      #endif
-
-    }
-
 };
 
 extern Stepper stepper;
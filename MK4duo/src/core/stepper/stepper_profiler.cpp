@@ -0,0 +1,144 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * stepper_profiler.cpp - Stepper ISR and main loop timing
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(STEPPER_PROFILER)
+
+StepperProfiler profiler;
+
+/** Public Parameters */
+volatile uint32_t StepperProfiler::deadlines_missed = 0;
+
+/** Private Parameters */
+profile_phase_t StepperProfiler::phase[PHASE_COUNT];
+profile_loop_t  StepperProfiler::loop[LOOP_COUNT];
+uint32_t        StepperProfiler::steps[PROFILER_STEP_BUCKETS];
+millis_l        StepperProfiler::start_ms = 0;
+
+uint8_t StepperProfiler::report_interval  = 0,
+        StepperProfiler::report_count     = 0;
+
+/** Public Function */
+void StepperProfiler::reset() {
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+  ZERO(phase);
+  ZERO(steps);
+  deadlines_missed = 0;
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+  ZERO(loop);
+  start_ms = millis();
+}
+
+void StepperProfiler::report() {
+
+  // Copy the stepper figures, the ISR must not change them while they are printed
+  profile_phase_t isr_phase[PHASE_COUNT];
+  uint32_t isr_steps[PROFILER_STEP_BUCKETS], missed;
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+  COPY_ARRAY(isr_phase, phase);
+  COPY_ARRAY(isr_steps, steps);
+  missed = deadlines_missed;
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+  const float elapsed_s = float(millis() - start_ms) * 0.001f;
+
+  SERIAL_SMV(ECHO, "Stepper profile over ", elapsed_s, 3);
+  SERIAL_EM("s, times in us");
+
+  SERIAL_SMV(ECHO, "  ISR load:", elapsed_s > 0 ? float(isr_phase[PHASE_ISR].total) * 100.0f / (float(STEPPER_TIMER_RATE) * elapsed_s) : 0.0f, 2);
+  SERIAL_MV("% Missed deadlines:", missed);
+  SERIAL_EOL();
+
+  print_phase(PSTR("Pulse phase"), isr_phase[PHASE_PULSE]);
+  print_phase(PSTR("Block phase"), isr_phase[PHASE_BLOCK]);
+  print_phase(PSTR("Stepper ISR"), isr_phase[PHASE_ISR]);
+  print_phase(PSTR("ISR latency"), isr_phase[PHASE_LATENCY]);
+
+  SERIAL_SM(ECHO, "  Steps per ISR");
+  for (uint8_t b = 0; b < PROFILER_STEP_BUCKETS; b++) {
+    if (isr_steps[b]) {
+      SERIAL_MV(" ", 1 << b);
+      SERIAL_MV(":", isr_steps[b]);
+    }
+  }
+  SERIAL_EOL();
+
+  print_loop(PSTR("Idle"), loop[LOOP_IDLE]);
+  print_loop(PSTR("Temperature"), loop[LOOP_TEMPERATURE]);
+
+}
+
+void StepperProfiler::auto_report() {
+  if (report_interval && !--report_count) {
+    report_count = report_interval;
+    report();
+    reset();
+  }
+}
+
+void StepperProfiler::loop_done(const LoopEnum l, const uint32_t us) {
+  profile_loop_t &s = loop[l];
+  s.count++;
+  s.total += us;
+  NOLESS(s.max, us);
+}
+
+/** Private Function */
+void StepperProfiler::print_phase(PGM_P const label, const profile_phase_t &s) {
+  #define TICKS_TO_US(T)  (float(T) / float(STEPPER_TIMER_TICKS_PER_US))
+  SERIAL_SM(ECHO, "  ");
+  SERIAL_STR(label);
+  SERIAL_MV(" n:", s.count);
+  SERIAL_MV(" avg:", s.count ? TICKS_TO_US(s.total) / float(s.count) : 0.0f, 2);
+  SERIAL_MV(" max:", TICKS_TO_US(s.max), 2);
+  // Histogram, the upper bound of each bucket not empty
+  for (uint8_t b = 0; b < PROFILER_BUCKETS; b++) {
+    if (s.histogram[b]) {
+      if (b < PROFILER_BUCKETS - 1)
+        SERIAL_MV(" <", TICKS_TO_US(2UL << b), 2);
+      else
+        SERIAL_MSG(" more");
+      SERIAL_MV(":", s.histogram[b]);
+    }
+  }
+  SERIAL_EOL();
+  #undef TICKS_TO_US
+}
+
+void StepperProfiler::print_loop(PGM_P const label, const profile_loop_t &s) {
+  SERIAL_SM(ECHO, "  ");
+  SERIAL_STR(label);
+  SERIAL_MV(" n:", s.count);
+  SERIAL_MV(" avg:", s.count ? float(s.total) / float(s.count) : 0.0f, 2);
+  SERIAL_EMV(" max:", s.max);
+}
+
+#endif // STEPPER_PROFILER
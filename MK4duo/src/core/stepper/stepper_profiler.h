@@ -0,0 +1,161 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * stepper_profiler.h - Stepper ISR and main loop timing
+ *
+ * The stepper ISR phases are timed with the stepper timer counter.
+ * The counter restarts when the ISR is due, so its value at the ISR
+ * entry is the latency. An event of the ISR loop that is already due
+ * when it is scheduled is a missed deadline.
+ *
+ * Printer::idle() and Temperature::spin() are timed in µs.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEPPER_PROFILER)
+
+// Histogram buckets, bucket N counts the times below 2^(N+1) ticks
+#define PROFILER_BUCKETS      16
+// Buckets of steps_per_isr, 1 to 128
+#define PROFILER_STEP_BUCKETS  8
+
+#define PROFILE_ISR_START()     const hal_timer_t profile_isr_start = HAL_timer_get_current_count(STEPPER_TIMER_NUM)
+#define PROFILE_ISR_END()       profiler.isr_done(profile_isr_start, HAL_timer_get_current_count(STEPPER_TIMER_NUM))
+#define PROFILE_PHASE(P,CALL)   do{ const hal_timer_t profile_start = HAL_timer_get_current_count(STEPPER_TIMER_NUM); CALL; profiler.phase_done(StepperProfiler::PHASE_##P, hal_timer_t(HAL_timer_get_current_count(STEPPER_TIMER_NUM) - profile_start)); }while(0)
+#define PROFILE_STEPS(N)        profiler.steps_done(N)
+#define PROFILE_DEADLINE(T,NOW) do{ if ((T) < (NOW)) profiler.deadlines_missed++; }while(0)
+#define PROFILE_LOOP(L)         StepperProfiler::Timer profile_timer_(StepperProfiler::LOOP_##L)
+
+struct profile_phase_t {
+  uint32_t  count,
+            max,
+            histogram[PROFILER_BUCKETS];
+  uint64_t  total;
+};
+
+struct profile_loop_t {
+  uint32_t  count,
+            max;
+  uint64_t  total;
+};
+
+class StepperProfiler {
+
+  public: /** Constructor */
+
+    StepperProfiler() {}
+
+  public: /** Public Parameters */
+
+    enum PhaseEnum : uint8_t {
+      PHASE_PULSE,    // Stepper::pulse_phase_step()
+      PHASE_BLOCK,    // Stepper::block_phase_step()
+      PHASE_ISR,      // Whole stepper ISR
+      PHASE_LATENCY,  // ISR entry after the due time
+      PHASE_COUNT
+    };
+
+    enum LoopEnum : uint8_t {
+      LOOP_IDLE,        // Printer::idle()
+      LOOP_TEMPERATURE, // Temperature::spin()
+      LOOP_COUNT
+    };
+
+    struct Timer {
+      const LoopEnum  loop;
+      const uint32_t  start_us;
+      Timer(const LoopEnum l) : loop(l), start_us(micros()) {}
+      ~Timer() { loop_done(loop, micros() - start_us); }
+    };
+
+    static volatile uint32_t deadlines_missed;
+
+  private: /** Private Parameters */
+
+    static profile_phase_t  phase[PHASE_COUNT];
+    static profile_loop_t   loop[LOOP_COUNT];
+    static uint32_t         steps[PROFILER_STEP_BUCKETS];
+    static millis_l         start_ms;
+
+    static uint8_t  report_interval,  // Auto report seconds, 0 off
+                    report_count;
+
+  public: /** Public Function */
+
+    static void reset();
+    static void report();
+
+    // Auto report each S seconds, called every second
+    static void set_auto_report(const uint8_t s) { report_interval = report_count = s; }
+    static void auto_report();
+
+    static inline void isr_done(const hal_timer_t start, const hal_timer_t end) {
+      phase_done(PHASE_LATENCY, start);
+      phase_done(PHASE_ISR, hal_timer_t(end - start));
+    }
+
+    static inline void phase_done(const PhaseEnum p, const uint32_t ticks) {
+      profile_phase_t &s = phase[p];
+      s.count++;
+      s.total += ticks;
+      NOLESS(s.max, ticks);
+      s.histogram[bucket(ticks, PROFILER_BUCKETS)]++;
+    }
+
+    static inline void steps_done(const uint8_t n) { steps[bucket(n, PROFILER_STEP_BUCKETS)]++; }
+
+    static void loop_done(const LoopEnum l, const uint32_t us);
+
+  private: /** Private Function */
+
+    // Bucket of the highest bit set, 0 for 0 and 1
+    static inline uint8_t bucket(uint32_t v, const uint8_t buckets) {
+      #if ENABLED(CPU_32_BIT)
+        const uint8_t b = v > 1 ? 31 - __builtin_clz(v) : 0;
+        return b < buckets ? b : buckets - 1;
+      #else
+        uint8_t b = 0;
+        while ((v >>= 1) && b < buckets - 1) b++;
+        return b;
+      #endif
+    }
+
+    static void print_phase(PGM_P const label, const profile_phase_t &s);
+    static void print_loop(PGM_P const label, const profile_loop_t &s);
+
+};
+
+extern StepperProfiler profiler;
+
+#else
+
+#define PROFILE_ISR_START()     NOOP
+#define PROFILE_ISR_END()       NOOP
+#define PROFILE_PHASE(P,CALL)   CALL
+#define PROFILE_STEPS(N)        NOOP
+#define PROFILE_DEADLINE(T,NOW) NOOP
+#define PROFILE_LOOP(L)         NOOP
+
+#endif // STEPPER_PROFILER
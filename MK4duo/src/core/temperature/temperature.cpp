@@ -119,6 +119,16 @@ void Temperature::factory_parameters() {
       pid->DriveMin         = POWER_DRIVE_MIN;
       pid->DriveMax         = POWER_DRIVE_MAX;
       pid->Max              = POWER_MAX;
+      #if ENABLED(MODEL_PREDICTIVE_CONTROL)
+        // Model
+        heat->data.model.power          = MODEL_HEATER_POWER;
+        heat->data.model.capacity       = MODEL_CAPACITY;
+        heat->data.model.loss           = MODEL_LOSS;
+        heat->data.model.fan_loss       = MODEL_FAN_LOSS;
+        heat->data.model.filament_heat  = MODEL_FILAMENT_HEAT;
+        heat->data.model.response       = MODEL_RESPONSE;
+        heat->data.model.ambient        = MODEL_AMBIENT_TEMP;
+      #endif
       // Sensor
       sens->pin             = SE_pin[h];
       sens->type            = SE_type[h];
@@ -377,7 +387,7 @@ void Temperature::set_current_temp_raw() {
 
 /**
  * Spin Manage heating activities for heaters, bed, chamber and cooler
- *  - Is called every 100ms.
+ *  - Is called every PID_SAMPLE_MS by the TASK_TEMPERATURE task of the idle loop.
  *  - Acquire updated temperature readings
  *  - Also resets the watchdog timer
  *  - Invoke thermal runaway protection
@@ -386,6 +396,21 @@ void Temperature::set_current_temp_raw() {
  */
 void Temperature::spin() {
 
+  PROFILE_LOOP(TEMPERATURE);
+
+  #if ENABLED(ADC_SCAN)
+    // Average the samples of the ADC scan
+    adcscan.update();
+  #else
+    // The tick writes the readings, they are copied at once so no
+    // 16 bit value is read half updated
+    if (HAL::Analog_is_ready) {
+      CRITICAL_SECTION_START
+        set_current_temp_raw();
+      CRITICAL_SECTION_END
+    }
+  #endif
+
   #if ENABLED(EMERGENCY_PARSER)
     if (emergency_parser.killed_by_M112) printer.kill(PSTR("M112"));
   #endif
@@ -480,6 +505,21 @@ void Temperature::spin() {
 
 }
 
+void Temperature::output_off() {
+  #if HAS_HOTENDS
+    LOOP_HOTEND() hotends[h].pwm_value = 0;
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() beds[h].pwm_value = 0;
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() chambers[h].pwm_value = 0;
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() coolers[h].pwm_value = 0;
+  #endif
+}
+
 /**
  * Switch off all heaters, set all target temperatures to 0
  */
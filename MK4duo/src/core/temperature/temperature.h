@@ -73,15 +73,20 @@ class Temperature {
     static void factory_parameters();
 
     /**
-     * Called from the Temperature ISR
+     * Copy the ADC readings to the sensors, called by spin()
      */
     static void set_current_temp_raw();
 
     /**
-     * Call periodically to HAL isr
+     * Called every PID_SAMPLE_MS from Printer::idle()
      */
     static void spin();
 
+    /**
+     * Switch off the heater outputs until the next spin(), the targets are kept
+     */
+    static void output_off();
+
     /**
      * Switch off all heaters, set all target temperatures to 0
      */
@@ -0,0 +1,145 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * binary_stream.cpp - Commands from the host in binary frames
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(BINARY_STREAM)
+
+BinaryStream binstream;
+
+/** Public Parameters */
+int8_t    BinaryStream::port  = -1;
+bool      BinaryStream::hold  = false,
+          BinaryStream::upload = false;
+uint16_t  BinaryStream::index = 0;
+PGM_P     BinaryStream::error = nullptr;
+
+/** Private Parameters */
+uint8_t   BinaryStream::frame[BINARY_FRAME_HEADER + BINARY_FRAME_SIZE + 4];
+uint16_t  BinaryStream::frame_count = 0;
+bool      BinaryStream::ready       = false,
+          BinaryStream::resend      = false,
+          BinaryStream::stream_back = false;
+millis_s  BinaryStream::frame_ms    = 0,
+          BinaryStream::ready_ms    = 0;
+
+/** Public Function */
+void BinaryStream::start(const int8_t p, const bool up/*=false*/) {
+  stream_back = up && port == p && !upload;
+  port = p;
+  upload = up;
+  resend = false;
+  ready_ms = millis();
+  release();
+}
+
+void BinaryStream::stop() {
+  port = -1;
+  upload = false;
+  resend = false;
+  release();
+}
+
+void BinaryStream::end_upload() {
+  if (stream_back) start(port);
+  else stop();
+}
+
+FrameStateEnum BinaryStream::receive(const uint32_t expected) {
+
+  if (ready) return FRAME_READY;
+
+  int c;
+  while ((c = Com::serialRead(port)) >= 0) {
+
+    // The bytes between the frames are dropped
+    if (!frame_count && c != BINARY_FRAME_SYNC) continue;
+
+    frame[frame_count++] = c;
+    frame_ms = millis();
+
+    FrameStateEnum state = FRAME_NONE;
+    if (frame_count == BINARY_FRAME_HEADER) {
+      const uint16_t len = length();
+      if ((!len && !upload) || len > BINARY_FRAME_SIZE) state = fail(PSTR(MSG_ERR_FRAME_SIZE));
+    }
+    else if (frame_count == BINARY_FRAME_HEADER + length() + 4)
+      state = check(expected);
+
+    if (state != FRAME_NONE) return state;
+  }
+
+  // The bytes lost on the wire leave the frame incomplete, ask it again
+  if (frame_count && expired(&frame_ms, millis_s(BINARY_FRAME_TIMEOUT))) {
+    resend = false;
+    return fail(PSTR(MSG_ERR_FRAME_TIMEOUT));
+  }
+
+  return FRAME_NONE;
+}
+
+/** Private Function */
+FrameStateEnum BinaryStream::check(const uint32_t expected) {
+
+  const uint16_t len = length();
+
+  uint32_t crc = 0;
+  crc32(&crc, &frame[1], BINARY_FRAME_HEADER - 1 + len);
+  if (crc != get_long(&frame[BINARY_FRAME_HEADER + len]))
+    return fail(PSTR(MSG_ERR_CHECKSUM_MISMATCH));
+
+  // The last command must be ended
+  if (!upload && frame[BINARY_FRAME_HEADER + len - 1])
+    return fail(PSTR(MSG_ERR_FRAME_SIZE));
+
+  const int32_t diff = int32_t(sequence() - expected);
+
+  if (diff > 0) return fail(PSTR(MSG_ERR_LINE_NO));
+
+  // A frame sent again, the host may have lost its "ok"
+  if (diff < 0) {
+    frame_count = 0;
+    return FRAME_STALE;
+  }
+
+  resend = false;
+  ready = true;
+  ready_ms = millis();
+  return FRAME_READY;
+}
+
+FrameStateEnum BinaryStream::fail(PGM_P const err) {
+  frame_count = 0;
+  if (resend) return FRAME_NONE;  // Already requested
+  resend = true;
+  error = err;
+  return FRAME_ERROR;
+}
+
+#endif // BINARY_STREAM
@@ -0,0 +1,134 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * binary_stream.h - Commands from the host in binary frames
+ *
+ * After M576 S1 the serial port takes frames in place of ASCII lines:
+ *
+ *   0xA5           Sync byte
+ *   uint16_t       Length of the payload, up to BINARY_FRAME_SIZE
+ *   uint32_t       Sequence, the line number of the first command
+ *   payload        The commands, each one ended by a 0, one line number each
+ *   uint32_t       CRC32 of the length, sequence and payload
+ *
+ * The values are little-endian. The host strips the comments, the line
+ * numbers and the checksums, the commands are tokenized when queued as the
+ * ASCII lines. The line numbers go on from the ASCII lines.
+ *
+ * The frame gets "ok N<last line> P<planner free> B<buffer free>" when all
+ * its commands are queued, the host can have BINARY_STREAM_WINDOW frames
+ * without it. A bad frame gets the "Resend:" of the ASCII lines and the
+ * frames up to the one requested are dropped. A frame already taken gets
+ * the last "ok" again, the host may have lost it.
+ *
+ * M576 S0 goes back to the ASCII lines, the commands after it in its frame
+ * are dropped.
+ *
+ * With SD support M28 B1 <file> uploads a file in the same frames, the
+ * sequence is the file position of the payload and "ok N<position>" follows
+ * each frame written. The frame with no payload ends the file. M28 B1 R1
+ * <file> goes on with the file on the card, "Upload:<position>" tells the
+ * host where. The file keeps the frames written when the host is gone for
+ * BINARY_UPLOAD_TIMEOUT, for a resume. The port goes back to the mode it
+ * had before the upload.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(BINARY_STREAM)
+
+#define BINARY_FRAME_SYNC     0xA5
+#define BINARY_FRAME_HEADER   7       // Sync, length and sequence
+#define BINARY_FRAME_TIMEOUT  500     // Milliseconds for the bytes of a frame
+#define BINARY_UPLOAD_TIMEOUT 10000   // Milliseconds without a frame to end an upload
+
+class BinaryStream {
+
+  public: /** Constructor */
+
+    BinaryStream() {}
+
+  public: /** Public Parameters */
+
+    static int8_t   port;         // Serial port in binary mode, -1 for none
+    static bool     hold,         // A mode switch is queued, the serial waits for it
+                    upload;       // The frames are a file for the SD
+    static uint16_t index;        // Payload offset of the next command to queue
+    static PGM_P    error;        // The error of the last FRAME_ERROR
+
+  private: /** Private Parameters */
+
+    static uint8_t  frame[BINARY_FRAME_HEADER + BINARY_FRAME_SIZE + 4];
+    static uint16_t frame_count;  // Bytes received of the frame
+    static bool     ready,        // The frame is good, until release()
+                    resend,       // A resend is requested, the other frames are dropped
+                    stream_back;  // The upload started in stream mode
+    static millis_s frame_ms,     // Time of the last byte of the frame
+                    ready_ms;     // Time of the last good frame
+
+  public: /** Public Function */
+
+    static void start(const int8_t p, const bool up=false);
+    static void stop();
+
+    /**
+     * The upload is over, back to the mode before it
+     */
+    static void end_upload();
+
+    /**
+     * No good frame for the period
+     */
+    FORCE_INLINE static bool idle(const millis_s period) { return expired(&ready_ms, period); }
+
+    /**
+     * Read the serial port until a frame is complete
+     * FRAME_READY if it is good and its sequence is the one expected,
+     * FRAME_STALE if it is good and its sequence was already taken
+     */
+    static FrameStateEnum receive(const uint32_t expected);
+
+    /**
+     * Drop the received frame, the next one can be read
+     */
+    FORCE_INLINE static void release() { ready = false; frame_count = 0; index = 0; }
+
+    FORCE_INLINE static const uint8_t* payload() { return &frame[BINARY_FRAME_HEADER]; }
+    FORCE_INLINE static uint16_t length() { return frame[1] | (uint16_t(frame[2]) << 8); }
+    FORCE_INLINE static uint32_t sequence() { return get_long(&frame[3]); }
+
+  private: /** Private Function */
+
+    static FrameStateEnum check(const uint32_t expected);
+    static FrameStateEnum fail(PGM_P const err);
+
+    FORCE_INLINE static uint32_t get_long(const uint8_t * const p) {
+      return p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+};
+
+extern BinaryStream binstream;
+
+#endif // BINARY_STREAM
@@ -0,0 +1,37 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+#if ENABLED(BINARY_STREAM)
+  #if BINARY_FRAME_SIZE < MAX_CMD_SIZE || BINARY_FRAME_SIZE > 4096
+    #error "DEPENDENCY ERROR: BINARY_FRAME_SIZE must be from MAX_CMD_SIZE to 4096."
+  #endif
+  #if BINARY_STREAM_WINDOW < 1
+    #error "DEPENDENCY ERROR: BINARY_STREAM_WINDOW must be 1 or more."
+  #endif
+#endif
@@ -71,6 +71,10 @@
   #define Z_HOME_BUMP_MM XYZ_HOME_BUMP_MM
   #define HOMING_BUMP_DIVISOR {XYZ_BUMP_DIVISOR, XYZ_BUMP_DIVISOR, XYZ_BUMP_DIVISOR}
 
+  #if DISABLED(DELTA_SEGMENT_ERROR)
+    #define DELTA_SEGMENT_ERROR 0
+  #endif
+
   // Effective horizontal distance bridged by diagonal push rods.
   #define DELTA_RADIUS (DELTA_SMOOTH_ROD_OFFSET - DELTA_EFFECTOR_OFFSET - DELTA_CARRIAGE_OFFSET)
 
@@ -192,6 +196,9 @@
 #if IS_SCARA
   #undef SLOWDOWN
   #define QUICK_HOME
+  #if ENABLED(SCARA_INCREMENTAL_SEGMENTS) && DISABLED(SCARA_RESYNC_SEGMENTS)
+    #define SCARA_RESYNC_SEGMENTS 16
+  #endif
 #endif
 
 /**
@@ -879,6 +886,95 @@
  */
 #define HAS_CLASSIC_JERK        (IS_KINEMATIC || DISABLED(JUNCTION_DEVIATION))
 
+/**
+ * Parameters with a value in a tokenized GCode line
+ */
+#if DISABLED(GCODE_TOKEN_PARAMS)
+  #define GCODE_TOKEN_PARAMS 8
+#endif
+
+/**
+ * Binary stream mode
+ */
+#if ENABLED(BINARY_STREAM)
+  #if DISABLED(BINARY_STREAM_WINDOW)
+    #define BINARY_STREAM_WINDOW 4
+  #endif
+  #if DISABLED(BINARY_FRAME_SIZE)
+    #define BINARY_FRAME_SIZE 512
+  #endif
+#endif
+
+/**
+ * Samples of a buffer of the ADC scan
+ */
+#if DISABLED(ADC_SCAN_SAMPLES)
+  #define ADC_SCAN_SAMPLES 256
+#endif
+
+/**
+ * PID control rate
+ */
+#if DISABLED(PID_FREQUENCY)
+  #define PID_FREQUENCY 10
+#endif
+#if DISABLED(PID_DTERM_FILTER)
+  #define PID_DTERM_FILTER 1.0
+#endif
+#define PID_SAMPLE_MS (1000 / (PID_FREQUENCY))
+
+/**
+ * Model predictive control
+ */
+#if ENABLED(MODEL_PREDICTIVE_CONTROL)
+  #if DISABLED(MODEL_HEATER_POWER)
+    #define MODEL_HEATER_POWER 40.0
+  #endif
+  #if DISABLED(MODEL_CAPACITY)
+    #define MODEL_CAPACITY 16.7
+  #endif
+  #if DISABLED(MODEL_LOSS)
+    #define MODEL_LOSS 0.07
+  #endif
+  #if DISABLED(MODEL_FAN_LOSS)
+    #define MODEL_FAN_LOSS 0.1
+  #endif
+  #if DISABLED(MODEL_FILAMENT_HEAT)
+    #define MODEL_FILAMENT_HEAT 0.0135
+  #endif
+  #if DISABLED(MODEL_RESPONSE)
+    #define MODEL_RESPONSE 2.0
+  #endif
+  #if DISABLED(MODEL_AMBIENT_TEMP)
+    #define MODEL_AMBIENT_TEMP 25
+  #endif
+#endif
+
+/**
+ * Blocks of the printed file buffered by SD_BLOCK_READ
+ */
+#if DISABLED(SD_READ_BUFFERS)
+  #define SD_READ_BUFFERS 2
+#endif
+
+/**
+ * Thermistor table points for each octave of the reading
+ */
+#if DISABLED(THERMISTOR_TABLE_STEPS)
+  #if ENABLED(__AVR__)
+    #define THERMISTOR_TABLE_STEPS 4
+  #else
+    #define THERMISTOR_TABLE_STEPS 8
+  #endif
+#endif
+
+/**
+ * Planner look-ahead window, the whole buffer if not set
+ */
+#if DISABLED(PLANNER_LOOKAHEAD_WINDOW)
+  #define PLANNER_LOOKAHEAD_WINDOW 0
+#endif
+
 /**
  * Set granular options based on the specific type of leveling
  */
@@ -1537,6 +1633,19 @@
   #define MAXIMUM_STEPPER_RATE (500000UL)
 #endif
 
+// Step chunk queue
+#if ENABLED(STEP_CHUNK_QUEUE)
+  #if DISABLED(STEP_CHUNK_BUFFER_SIZE)
+    #define STEP_CHUNK_BUFFER_SIZE 128
+  #endif
+  #if DISABLED(STEP_CHUNK_BLOCKS)
+    #define STEP_CHUNK_BLOCKS 4
+  #endif
+  #if DISABLED(STEP_CHUNK_MAX_ERROR)
+    #define STEP_CHUNK_MAX_ERROR 2
+  #endif
+#endif
+
 /**
  * Z STEPPER COUNT
  */
@@ -55,19 +55,44 @@ class Circular_Queue {
       if (this->isEmpty()) return T();
 
       uint8_t index = this->buffer.head;
+      this->release();
+      return this->buffer.queue[index];
+    }
+
+    bool enqueue(T const &item) {
+      if (this->isFull()) return false;
+      this->peek_back() = item;
+      return this->commit();
+    }
+
+    /**
+     * In place access, without copies of the items:
+     *  peek_front()  The oldest item, used in place by the consumer
+     *  release()     Drop the oldest item when the consumer is done
+     *  peek_back()   The free slot, written in place by the producer
+     *  commit()      Queue the item written in the free slot
+     *
+     * peek_back() is valid only when the queue is not full.
+     */
+    T& peek_front() {
+      return this->buffer.queue[this->buffer.head];
+    }
+
+    void release() {
+      if (this->isEmpty()) return;
 
       --this->buffer.count;
       if (++this->buffer.head == this->buffer.size)
         this->buffer.head = 0;
+    }
 
-      return this->buffer.queue[index];
+    T& peek_back() {
+      return this->buffer.queue[this->buffer.tail];
     }
 
-    bool enqueue(T const &item) {
+    bool commit() {
       if (this->isFull()) return false;
 
-      this->buffer.queue[this->buffer.tail] = item;
-
       ++this->buffer.count;
       if (++this->buffer.tail == this->buffer.size)
         this->buffer.tail = 0;
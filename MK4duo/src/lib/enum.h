@@ -79,6 +79,15 @@ enum InterruptEventEnum : uint8_t {
   INTERRUPT_EVENT_FIL_RUNOUT
 };
 
+/**
+ * Tasks flagged by HAL::Tick and run by Printer::idle
+ */
+enum TaskEnum : uint8_t {
+  TASK_TEMPERATURE, // Every PID_SAMPLE_MS, Temperature::spin()
+  TASK_PERIODICAL,  // Every second, Printer::check_periodical_actions()
+  TASK_COUNT
+};
+
 /**
  * States for managing MK4duo and host communication
  * MK4duo sends messages if blocked or busy
@@ -116,6 +125,17 @@ enum EmergencyStateEnum : uint8_t {
   EP_IGNORE // to '\n'
 };
 
+/**
+ * Binary Stream
+ *  State of the frame received
+ */
+enum FrameStateEnum : uint8_t {
+  FRAME_NONE,       // Incomplete, or dropped
+  FRAME_READY,      // Good and in sequence
+  FRAME_STALE,      // Good and already taken, the "ok" is sent again
+  FRAME_ERROR       // Bad, a resend is needed
+};
+
 /**
  * Prompt Reason
  *  For M876 command
@@ -141,13 +161,17 @@ enum BlockFlagBitEnum : uint8_t {
   BLOCK_BIT_NOMINAL_LENGTH,
 
   // Sync the stepper counts from the block
-  BLOCK_BIT_SYNC_POSITION
+  BLOCK_BIT_SYNC_POSITION,
+
+  // The step chunks of the block are queued for the stepper
+  BLOCK_BIT_CHUNKED
 };
 
 enum BlockFlagEnum : uint8_t {
   BLOCK_FLAG_RECALCULATE          = _BV(BLOCK_BIT_RECALCULATE),
   BLOCK_FLAG_NOMINAL_LENGTH       = _BV(BLOCK_BIT_NOMINAL_LENGTH),
-  BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION)
+  BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION),
+  BLOCK_FLAG_CHUNKED              = _BV(BLOCK_BIT_CHUNKED)
 };
 
 /**
@@ -324,8 +324,6 @@ void HAL::analogWrite(const pin_t pin, const uint8_t uValue, const uint16_t freq
 
 void HAL::Tick() {
 
-  static millis_s cycle_1s_ms   = millis(),
-                  cycle_100_ms  = millis();
   static uint8_t  channel       = 0;
 
   if (printer.isStopped()) return;
@@ -355,11 +353,8 @@ void HAL::Tick() {
   // Software PWM modulation
   softpwm.spin();
 
-  // Event 100 ms
-  if (expired(&cycle_100_ms, 100U)) thermalManager.spin();
-
-  // Event 1.0 Second
-  if (expired(&cycle_1s_ms, 1000U)) printer.check_periodical_actions();
+  // Flag the temperature and periodical tasks
+  printer.tick_tasks();
 
   if ((ADCSRA & _BV(ADSC)) == 0) {  // Conversion finished?
     channel = pgm_read_byte(&AnalogInputChannels[adcSamplePos]);
@@ -389,9 +384,6 @@ void HAL::Tick() {
     ADCSRA |= _BV(ADSC);  // start next conversion
   }
 
-  // Update the raw values if they've been read. Else we could be updating them during reading.
-  if (HAL::Analog_is_ready) thermalManager.set_current_temp_raw();
-
   // Tick endstops state, if required
   endstops.Tick();
 
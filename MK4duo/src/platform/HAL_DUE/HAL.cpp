@@ -226,6 +226,9 @@ void AnalogInStartConversion() {
 void AnalogInEnablePin(const pin_t r_pin, const bool enable) {
   adc_channel_num_t adc_ch = PinToAdcChannel(r_pin);
   if ((unsigned int)adc_ch < NUM_ANALOG_INPUTS) {
+    #if ENABLED(ADC_SCAN)
+      adcscan.set_channel(adc_ch, enable ? r_pin : NoPin);
+    #endif
     if (enable) {
       adc_enable_channel(ADC, adc_ch);
       if (r_pin == ADC_TEMPERATURE_SENSOR)
@@ -269,6 +272,10 @@ void HAL::analogStart(void) {
   ADC->ADC_WPMR = 0x41444300u;    // ADC_WPMR_WPKEY(0);
   pmc_enable_periph_clk(ID_ADC);  // enable adc clock
 
+  #if ENABLED(ADC_SCAN)
+    adcscan.init();
+  #endif
+
   #if HAS_HOTENDS
     LOOP_HOTEND() {
       if (WITHIN(hotends[h].data.sensor.pin, 0, 15)) {
@@ -333,11 +340,54 @@ void HAL::analogStart(void) {
                 ADC_MR_TRACKTIM(AD_TRACKING_CYCLES) |
                 ADC_MR_TRANSFER(AD_TRANSFER_CYCLES);
 
-  ADC->ADC_IER = 0;             // no ADC interrupts
   ADC->ADC_COR = 0;             // Single-ended, no offset
 
-  // start first conversion
-  AnalogInStartConversion();
+  #if ENABLED(ADC_SCAN)
+
+    // The rising TIOA2 starts a scan of the channels, ADC_SCAN_FREQUENCY times a second:
+    // 2 MHz ADC clock, 16 clocks of tracking, 20 of conversion, 9 of transfer for a channel
+    ADC->ADC_MR = ADC_MR_TRGEN_EN | ADC_MR_TRGSEL_ADC_TRIG3 | ADC_MR_LOWRES_BITS_12 |
+                  ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_OFF |
+                  ADC_MR_STARTUP_SUT64 | ADC_MR_SETTLING_AST17 | ADC_MR_ANACH_NONE |
+                  ADC_MR_USEQ_NUM_ORDER |
+                  ADC_MR_PRESCAL(ADC_SCAN_PRESCALE) |
+                  ADC_MR_TRACKTIM(15) |
+                  ADC_MR_TRANSFER(3);
+    ADC->ADC_EMR = ADC_EMR_TAG;   // Channel number in the bits 12 to 15 of the samples
+
+    // The PDC stores the samples, ADC_Handler queues the next buffer when one is full
+    ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+    ADC->ADC_RPR  = (uint32_t)adcscan.fill_buffer();
+    ADC->ADC_RCR  = ADC_SCAN_SAMPLES;
+    ADC->ADC_RNPR = (uint32_t)adcscan.buffer[1];
+    ADC->ADC_RNCR = ADC_SCAN_SAMPLES;
+    ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+
+    ADC->ADC_IDR = 0xFFFFFFFF;
+    ADC->ADC_IER = ADC_IER_ENDRX;
+    NVIC_SetPriority(ADC_IRQn, NvicPriorityAdc);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    // The trigger timer, wave mode with TIOA2 up from RA to RC and no interrupt
+    Tc * const tc = TimerConfig[ADC_SCAN_TIMER_NUM].pTimerRegs;
+    const uint32_t channel = TimerConfig[ADC_SCAN_TIMER_NUM].channel,
+                   period  = VARIANT_MCK / 2 / (ADC_SCAN_FREQUENCY);
+    pmc_enable_periph_clk((uint32_t)TimerConfig[ADC_SCAN_TIMER_NUM].IRQ_Id);
+    TC_Configure(tc, channel, TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC |
+                              TC_CMR_ACPA_SET | TC_CMR_ACPC_CLEAR);
+    TC_SetRA(tc, channel, period / 2);
+    TC_SetRC(tc, channel, period);
+    TC_Start(tc, channel);
+
+  #else
+
+    ADC->ADC_IER = 0;             // no ADC interrupts
+
+    // start first conversion
+    AnalogInStartConversion();
+
+  #endif
+
 }
 
 void HAL::AdcChangePin(const pin_t old_pin, const pin_t new_pin) {
@@ -571,9 +621,6 @@ void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq/*=1
  */
 void HAL::Tick() {
 
-  static millis_s cycle_1s_ms   = millis(),
-                  cycle_100_ms  = millis();
-
   if (printer.isStopped()) return;
 
   // Heaters set output PWM
@@ -601,91 +648,88 @@ void HAL::Tick() {
   // Software PWM modulation
   softpwm.spin();
 
-  // Event 100 ms
-  if (expired(&cycle_100_ms, 100U)) thermalManager.spin();
+  // Flag the temperature and periodical tasks
+  printer.tick_tasks();
 
-  // Event 1.0 Second
-  if (expired(&cycle_1s_ms, 1000U)) printer.check_periodical_actions();
+  // Read analog or SPI values, the ADC scan needs no help
+  #if DISABLED(ADC_SCAN)
 
-  // Read analog or SPI values
-  if (adc_get_status(ADC)) { // conversion finished?
+    if (adc_get_status(ADC)) { // conversion finished?
 
-    #if HAS_HOTENDS
-      LOOP_HOTEND() {
-        Heater * const act = &hotends[h];
-        if (WITHIN(act->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(sensorFilters[h]);
-          currentFilter.ProcessReading(AnalogInReadPin(act->data.sensor.pin));
-          if (currentFilter.IsValid()) {
-            AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-            Analog_is_ready = true;
+      #if HAS_HOTENDS
+        LOOP_HOTEND() {
+          Heater * const act = &hotends[h];
+          if (WITHIN(act->data.sensor.pin, 0, 15)) {
+            ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(sensorFilters[h]);
+            currentFilter.ProcessReading(AnalogInReadPin(act->data.sensor.pin));
+            if (currentFilter.IsValid()) {
+              AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+              Analog_is_ready = true;
+            }
           }
         }
-      }
-    #endif
-    #if HAS_BEDS
-      LOOP_BED() {
-        Heater * const act = &beds[h];
-        if (WITHIN(act->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(BEDsensorFilters[h]);
-          currentFilter.ProcessReading(AnalogInReadPin(act->data.sensor.pin));
-          if (currentFilter.IsValid()) {
-            AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-            Analog_is_ready = true;
+      #endif
+      #if HAS_BEDS
+        LOOP_BED() {
+          Heater * const act = &beds[h];
+          if (WITHIN(act->data.sensor.pin, 0, 15)) {
+            ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(BEDsensorFilters[h]);
+            currentFilter.ProcessReading(AnalogInReadPin(act->data.sensor.pin));
+            if (currentFilter.IsValid()) {
+              AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+              Analog_is_ready = true;
+            }
           }
         }
-      }
-    #endif
-    #if HAS_CHAMBERS
-      LOOP_CHAMBER() {
-        Heater * const act = &chambers[h];
-        if (WITHIN(act->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(CHAMBERsensorFilters[h]);
-          currentFilter.ProcessReading(AnalogInReadPin(act->data.sensor.pin));
-          if (currentFilter.IsValid()) {
-            AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-            Analog_is_ready = true;
+      #endif
+      #if HAS_CHAMBERS
+        LOOP_CHAMBER() {
+          Heater * const act = &chambers[h];
+          if (WITHIN(act->data.sensor.pin, 0, 15)) {
+            ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(CHAMBERsensorFilters[h]);
+            currentFilter.ProcessReading(AnalogInReadPin(act->data.sensor.pin));
+            if (currentFilter.IsValid()) {
+              AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+              Analog_is_ready = true;
+            }
           }
         }
-      }
-    #endif
-    #if HAS_COOLERS
-      LOOP_COOLER() {
-        if (WITHIN(coolers[h].data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(COOLERsensorFilters[h]);
-          currentFilter.ProcessReading(AnalogInReadPin(coolers[h].data.sensor.pin));
-          if (currentFilter.IsValid()) {
-            AnalogInputValues[coolers[h].data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-            Analog_is_ready = true;
+      #endif
+      #if HAS_COOLERS
+        LOOP_COOLER() {
+          if (WITHIN(coolers[h].data.sensor.pin, 0, 15)) {
+            ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(COOLERsensorFilters[h]);
+            currentFilter.ProcessReading(AnalogInReadPin(coolers[h].data.sensor.pin));
+            if (currentFilter.IsValid()) {
+              AnalogInputValues[coolers[h].data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+              Analog_is_ready = true;
+            }
           }
         }
-      }
-    #endif
-
-    #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      const_cast<ADCAveragingFilter&>(filamentFilter).ProcessReading(AnalogInReadPin(FILWIDTH_PIN));
-      if (filamentFilter.IsValid())
-        AnalogInputValues[FILWIDTH_PIN] = (filamentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-    #endif
-
-    #if HAS_POWER_CONSUMPTION_SENSOR
-      const_cast<ADCAveragingFilter&>(powerFilter).ProcessReading(AnalogInReadPin(POWER_CONSUMPTION_PIN));
-      if (powerFilter.IsValid())
-        AnalogInputValues[POWER_CONSUMPTION_PIN] = (powerFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-    #endif
-
-    #if HAS_MCU_TEMPERATURE
-      const_cast<ADCAveragingFilter&>(mcuFilter).ProcessReading(AnalogInReadPin(ADC_TEMPERATURE_SENSOR));
-      if (mcuFilter.IsValid())
-        thermalManager.mcu_current_temperature_raw = (mcuFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
-    #endif
+      #endif
+
+      #if ENABLED(FILAMENT_WIDTH_SENSOR)
+        const_cast<ADCAveragingFilter&>(filamentFilter).ProcessReading(AnalogInReadPin(FILWIDTH_PIN));
+        if (filamentFilter.IsValid())
+          AnalogInputValues[FILWIDTH_PIN] = (filamentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+      #endif
+
+      #if HAS_POWER_CONSUMPTION_SENSOR
+        const_cast<ADCAveragingFilter&>(powerFilter).ProcessReading(AnalogInReadPin(POWER_CONSUMPTION_PIN));
+        if (powerFilter.IsValid())
+          AnalogInputValues[POWER_CONSUMPTION_PIN] = (powerFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+      #endif
+
+      #if HAS_MCU_TEMPERATURE
+        const_cast<ADCAveragingFilter&>(mcuFilter).ProcessReading(AnalogInReadPin(ADC_TEMPERATURE_SENSOR));
+        if (mcuFilter.IsValid())
+          thermalManager.mcu_current_temperature_raw = (mcuFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+      #endif
 
-  }
-
-  AnalogInStartConversion();
+    }
 
-  // Update the raw values if they've been read. Else we could be updating them during reading.
-  if (HAL::Analog_is_ready) thermalManager.set_current_temp_raw();
+    AnalogInStartConversion();
+  #endif // !ADC_SCAN
 
   // Tick endstops state, if required
   endstops.Tick();
@@ -695,6 +739,16 @@ void HAL::Tick() {
 /**
  * Interrupt Service Routines
  */
+#if ENABLED(ADC_SCAN)
+  // A buffer of the ADC scan is full, the PDC goes on with the queued one
+  void ADC_Handler() {
+    if (ADC->ADC_ISR & ADC_ISR_ENDRX) {
+      ADC->ADC_RNPR = (uint32_t)adcscan.buffer_done();
+      ADC->ADC_RNCR = ADC_SCAN_SAMPLES;
+    }
+  }
+#endif
+
 HAL_TONE_TIMER_ISR() {
   static uint8_t pin_state = 0;
   HAL_timer_isr_prologue(TONE_TIMER_NUM);
@@ -77,7 +77,7 @@
 const tTimerConfig TimerConfig [NUM_HARDWARE_TIMERS] = {
   { TC0, 0, TC0_IRQn, 0 },  // 0 - Pin TC 2 - 13
   { TC0, 1, TC1_IRQn, 0 },  // 1 - Pin TC 60 - 61
-  { TC0, 2, TC2_IRQn, 0 },  // 2 - Pin TC 58 - 92
+  { TC0, 2, TC2_IRQn, 0 },  // 2 - Pin TC 58 - 92 and [ADC_SCAN trigger]
   { TC1, 0, TC3_IRQn, 14},  // 3 - [NEOPIXEL] and Tone
   { TC1, 1, TC4_IRQn, 2 },  // 4 - Stepper
   { TC1, 2, TC5_IRQn, 3 },  // 5 - [servo timer5]
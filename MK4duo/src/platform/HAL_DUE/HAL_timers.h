@@ -62,6 +62,7 @@
 #define NUM_HARDWARE_TIMERS 9
 
 #define NvicPriorityUart    1
+#define NvicPriorityAdc     14
 #define NvicPrioritySystick 15
 
 // Tone for due
@@ -85,6 +86,11 @@
 #define AD_TRACKING_CYCLES          4   // 0 - 15     + 1 adc clock cycles
 #define AD_TRANSFER_CYCLES          1   // 0 - 3      * 2 + 3 adc clock cycles
 
+// ADC scan, TC0 channel 2 starts a scan of all the inputs on its TIOA2
+#define ADC_SCAN_TIMER_NUM          2
+#define ADC_SCAN_FREQUENCY          2000  // Scans per second, 16 inputs take 360 us
+#define ADC_SCAN_PRESCALE           20    // 2 MHz ADC clock, 1 - 20 MHz in spec
+
 #define ADC_ISR_EOC(channel)        (0x1u << channel)
 
 #define ENABLE_STEPPER_INTERRUPT()  HAL_timer_enable_interrupt(STEPPER_TIMER_NUM)
@@ -182,6 +182,19 @@ FORCE_INLINE static void TOGGLE(const uint8_t pin) {
   WRITE(pin, !READ(pin));
 }
 
+/**
+ * Ports, the pins of a port written at once
+ */
+typedef Pio* fastio_port_t;
+
+FORCE_INLINE static bool PORT_VALID(const pin_t pin) { return WITHIN(pin, 0, int(COUNT(fastio)) - 1); }
+FORCE_INLINE static fastio_port_t PORT_OF(const pin_t pin) { return fastio[pin].base_address; }
+FORCE_INLINE static uint32_t PORT_MASK(const pin_t pin) { return MASK(fastio[pin].shift_count); }
+
+// Set and clear the pins of the mask
+FORCE_INLINE static void PORT_SET(const fastio_port_t port, const uint32_t mask)    { port->PIO_SODR = mask; }
+FORCE_INLINE static void PORT_CLEAR(const fastio_port_t port, const uint32_t mask)  { port->PIO_CODR = mask; }
+
 // Set pin as input
 FORCE_INLINE static void SET_INPUT(const pin_t pin) {
   #if ENABLED(PCF8574_EXPANSION_IO)
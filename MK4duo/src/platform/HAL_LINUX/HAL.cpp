@@ -0,0 +1,340 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * Description: HAL for the Linux native simulator
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "../../../MK4duo.h"
+#include <malloc.h>
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+uint8_t MCUSR;
+
+int16_t HAL::AnalogInputValues[NUM_ANALOG_INPUTS] = { 0 };
+bool    HAL::Analog_is_ready = false;
+
+uint8_t HAL::pwm_value[NUM_DIGITAL_PINS] = { 0 };
+
+uint8_t VirtualPins::level[NUM_DIGITAL_PINS] = { 0 },
+        VirtualPins::mode[NUM_DIGITAL_PINS]  = { 0 },
+        VirtualPins::watch[NUM_DIGITAL_PINS] = { 0 };
+
+void (*VirtualPins::isr[NUM_DIGITAL_PINS])() = { nullptr };
+
+void VirtualPins::changed(const uint8_t pin, const bool value) {
+  Simulator::pin_changed(pin, value);
+}
+
+#if HAS_HOTENDS
+  ADCAveragingFilter HAL::sensorFilters[HOTENDS];
+#endif
+#if HAS_BEDS
+  ADCAveragingFilter HAL::BEDsensorFilters[BEDS];
+#endif
+#if HAS_CHAMBERS
+  ADCAveragingFilter HAL::CHAMBERsensorFilters[CHAMBERS];
+#endif
+#if HAS_COOLERS
+  ADCAveragingFilter HAL::COOLERsensorFilters[COOLERS];
+#endif
+
+// disable interrupts
+void cli(void) {
+  noInterrupts();
+}
+
+// enable interrupts
+void sei(void) {
+  interrupts();
+}
+
+// Return available memory
+int freeMemory() {
+  const struct mallinfo2 mi = mallinfo2();
+  return int(mi.fordblks);
+}
+
+// Tone
+static pin_t tone_pin;
+static int32_t toggles;
+
+void tone(const pin_t _pin, const uint16_t frequency, const uint16_t duration) {
+  tone_pin = _pin;
+  toggles = 2 * frequency * duration / 1000;
+  HAL_timer_start(TONE_TIMER_NUM, 2 * frequency);
+}
+
+void noTone(const pin_t _pin) {
+  HAL_timer_disable_interrupt(TONE_TIMER_NUM);
+  HAL::digitalWrite(_pin, LOW);
+}
+
+HAL::HAL() {
+  // ctor
+}
+
+HAL::~HAL() {
+  // dtor
+}
+
+// do any hardware-specific initialization here
+void HAL::hwSetup(void) {
+  // The 1ms system tick
+  HAL_timer_start(SYSTICK_TIMER_NUM, 1000);
+}
+
+// Print apparent cause of start/restart
+void HAL::showStartReason() {
+  SERIAL_EM(MSG_POWERUP);
+}
+
+// Initialize ADC channels
+void HAL::analogStart(void) {
+
+  #if ENABLED(ADC_SCAN)
+    // The simulator converts the channels of the sensor pins
+    adcscan.init();
+    #if HAS_HOTENDS
+      LOOP_HOTEND() if (WITHIN(hotends[h].data.sensor.pin, 0, 15)) adcscan.set_channel(hotends[h].data.sensor.pin, hotends[h].data.sensor.pin);
+    #endif
+    #if HAS_BEDS
+      LOOP_BED() if (WITHIN(beds[h].data.sensor.pin, 0, 15)) adcscan.set_channel(beds[h].data.sensor.pin, beds[h].data.sensor.pin);
+    #endif
+    #if HAS_CHAMBERS
+      LOOP_CHAMBER() if (WITHIN(chambers[h].data.sensor.pin, 0, 15)) adcscan.set_channel(chambers[h].data.sensor.pin, chambers[h].data.sensor.pin);
+    #endif
+    #if HAS_COOLERS
+      LOOP_COOLER() if (WITHIN(coolers[h].data.sensor.pin, 0, 15)) adcscan.set_channel(coolers[h].data.sensor.pin, coolers[h].data.sensor.pin);
+    #endif
+  #endif
+
+  #if HAS_HOTENDS
+    LOOP_HOTEND() {
+      if (WITHIN(hotends[h].data.sensor.pin, 0, 15))
+        sensorFilters[h].Init(0);
+    }
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() {
+      if (WITHIN(beds[h].data.sensor.pin, 0, 15))
+        BEDsensorFilters[h].Init(0);
+    }
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() {
+      if (WITHIN(chambers[h].data.sensor.pin, 0, 15))
+        CHAMBERsensorFilters[h].Init(0);
+    }
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() {
+      if (WITHIN(coolers[h].data.sensor.pin, 0, 15))
+        COOLERsensorFilters[h].Init(0);
+    }
+  #endif
+
+}
+
+void HAL::AdcChangePin(const pin_t old_pin, const pin_t new_pin) {
+  #if ENABLED(ADC_SCAN)
+    if (WITHIN(old_pin, 0, 15)) adcscan.set_channel(old_pin, NoPin);
+    if (WITHIN(new_pin, 0, 15)) adcscan.set_channel(new_pin, new_pin);
+  #else
+    UNUSED(old_pin);
+    UNUSED(new_pin);
+  #endif
+}
+
+// Reset peripherals and cpu
+void HAL::resetHardware() {
+  Simulator::terminate(Simulator::EXIT_RESET);
+}
+
+bool HAL::pwm_status(const pin_t pin) {
+  return USEABLE_HARDWARE_PWM(pin);
+}
+
+bool HAL::tc_status(const pin_t pin) {
+  UNUSED(pin);
+  return false;
+}
+
+/**
+ * Every pin has PWM, the duty cycle is stored for the
+ * simulator models and for the pins debugging.
+ */
+void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq/*=1000U*/, const bool hwpwm/*=true*/) {
+  UNUSED(freq);
+  UNUSED(hwpwm);
+  if (!WITHIN(pin, 0, NUM_DIGITAL_PINS - 1)) return;
+  pwm_value[pin] = MIN(ulValue, 255UL);
+  WRITE(pin, ulValue >= 128);
+}
+
+/**
+ * Task Tick is is called 1000 timer per second.
+ * It is used to update pwm values for heater and some other frequent jobs.
+ *
+ *  - Manage PWM to all the heaters and fan
+ *  - Read the raw ADC sensor values from the simulator models
+ *  - For ENDSTOP_INTERRUPTS_FEATURE check endstops if flagged
+ *  - Run the simulator models
+ */
+void HAL::Tick() {
+
+
+  // The simulated world goes on even when the printer is stopped
+  Simulator::spin();
+
+  if (printer.isStopped()) return;
+
+  // Heaters set output PWM
+  #if HAS_HOTENDS
+    LOOP_HOTEND() hotends[h].set_output_pwm();
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() beds[h].set_output_pwm();
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() chambers[h].set_output_pwm();
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() coolers[h].set_output_pwm();
+  #endif
+
+  // Fans set output PWM
+  #if HAS_FANS
+    LOOP_FAN() {
+      if (fans[f].kickstart) fans[f].kickstart--;
+      fans[f].set_output_pwm();
+    }
+  #endif
+
+  // Flag the temperature and periodical tasks
+  printer.tick_tasks();
+
+  // Read analog values, a conversion is always ready.
+  // The simulator fills the buffers of the ADC scan.
+  #if DISABLED(ADC_SCAN)
+
+    #if HAS_HOTENDS
+      LOOP_HOTEND() {
+        Heater * const act = &hotends[h];
+        if (WITHIN(act->data.sensor.pin, 0, 15)) {
+          ADCAveragingFilter& currentFilter = sensorFilters[h];
+          currentFilter.ProcessReading(Simulator::adc_read(act->data.sensor.pin));
+          if (currentFilter.IsValid()) {
+            AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+            Analog_is_ready = true;
+          }
+        }
+      }
+    #endif
+    #if HAS_BEDS
+      LOOP_BED() {
+        Heater * const act = &beds[h];
+        if (WITHIN(act->data.sensor.pin, 0, 15)) {
+          ADCAveragingFilter& currentFilter = BEDsensorFilters[h];
+          currentFilter.ProcessReading(Simulator::adc_read(act->data.sensor.pin));
+          if (currentFilter.IsValid()) {
+            AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+            Analog_is_ready = true;
+          }
+        }
+      }
+    #endif
+    #if HAS_CHAMBERS
+      LOOP_CHAMBER() {
+        Heater * const act = &chambers[h];
+        if (WITHIN(act->data.sensor.pin, 0, 15)) {
+          ADCAveragingFilter& currentFilter = CHAMBERsensorFilters[h];
+          currentFilter.ProcessReading(Simulator::adc_read(act->data.sensor.pin));
+          if (currentFilter.IsValid()) {
+            AnalogInputValues[act->data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+            Analog_is_ready = true;
+          }
+        }
+      }
+    #endif
+    #if HAS_COOLERS
+      LOOP_COOLER() {
+        if (WITHIN(coolers[h].data.sensor.pin, 0, 15)) {
+          ADCAveragingFilter& currentFilter = COOLERsensorFilters[h];
+          currentFilter.ProcessReading(Simulator::adc_read(coolers[h].data.sensor.pin));
+          if (currentFilter.IsValid()) {
+            AnalogInputValues[coolers[h].data.sensor.pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+            Analog_is_ready = true;
+          }
+        }
+      }
+    #endif
+  #endif // !ADC_SCAN
+
+  // Tick endstops state, if required
+  endstops.Tick();
+
+}
+
+/**
+ * Interrupt Service Routines
+ */
+HAL_SYSTICK_ISR() {
+  MOTION_PROBE(SYSTICK_ISR);
+  HAL::Tick();
+}
+
+HAL_TONE_TIMER_ISR() {
+  static uint8_t pin_state = 0;
+  HAL_timer_isr_prologue(TONE_TIMER_NUM);
+
+  if (toggles) {
+    toggles--;
+    HAL::digitalWrite(tone_pin, (pin_state ^= 1));
+  }
+  else noTone(tone_pin);
+}
+
+HAL_STEPPER_TIMER_ISR() {
+  HAL_timer_isr_prologue(STEPPER_TIMER_NUM);
+  MOTION_PROBE(STEPPER_ISR);
+  // Call the Step
+  stepper.Step();
+}
+
+#endif // ARDUINO_ARCH_LINUX
@@ -0,0 +1,291 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * Description: HAL for the Linux native simulator
+ *
+ * The firmware is built with the host compiler and runs as a normal
+ * process. Time, pins, timers, ADC, SD card and EEPROM are virtual,
+ * see the simulator folder for the models and the command line options.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+#pragma once
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include <stdint.h>
+#include <Arduino.h>
+#include <Wire.h>
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+typedef uint32_t  hal_timer_t;
+typedef uintptr_t ptr_int_t;
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+// CRITICAL SECTION
+#define CRITICAL_SECTION_START  const bool primask = VirtualClock::primask; VirtualClock::disable_irq();
+#define CRITICAL_SECTION_END    if (!primask) VirtualClock::enable_irq();
+
+// ISR function
+#define ISRS_ENABLED()          (!VirtualClock::primask)
+#define ENABLE_ISRS()           VirtualClock::enable_irq()
+#define DISABLE_ISRS()          VirtualClock::disable_irq()
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "hardwareserial/HardwareSerial.h"
+#include "watchdog/watchdog.h"
+#include "fastio.h"
+#include "HAL_timers.h"
+#include "math.h"
+#include "delay.h"
+#include "simulator/simulator.h"
+#include "simulator/motion_bench.h"
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+#define WIRE  Wire
+
+// SERIAL ports
+#if !WITHIN(SERIAL_PORT_1, 0, 3)
+  #error "SERIAL_PORT_1 must be from 0 to 3"
+#endif
+#define MKSERIAL1 MKSerial1
+
+#if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1
+  #if !WITHIN(SERIAL_PORT_2, 0, 3)
+    #error "SERIAL_PORT_2 must be from 0 to 3"
+  #elif SERIAL_PORT_2 == SERIAL_PORT_1
+    #error "SERIAL_PORT_2 must be different than SERIAL_PORT_1"
+  #else
+    #define MKSERIAL2 MKSerial2
+    #define NUM_SERIAL 2
+  #endif
+#else
+  #define NUM_SERIAL 1
+#endif
+
+// Voltage
+#define HAL_VOLTAGE_PIN 3.3
+
+// Reset reason
+#define RST_POWER_ON   1
+#define RST_EXTERNAL   2
+#define RST_BROWN_OUT  4
+#define RST_WATCHDOG   8
+#define RST_JTAG      16
+#define RST_SOFTWARE  32
+#define RST_BACKUP    64
+
+#define SPR0    0
+#define SPR1    1
+
+#define PACK    __attribute__ ((packed))
+
+// Macros for stepper.cpp
+#define HAL_MULTI_ACC(A,B)  MultiU32X24toH32(A,B)
+
+#define HAL_TIMER_TYPE_MAX  0xFFFFFFFF
+
+// TEMPERATURE
+#undef analogInputToDigitalPin
+#define analogInputToDigitalPin(p) ((p < 16) ? (p) + 54 : -1)
+#undef NUM_ANALOG_INPUTS
+#define NUM_ANALOG_INPUTS       16
+// Bits of the ADC converter
+#define ANALOG_INPUT_BITS 12
+#define OVERSAMPLENR       2
+#define AD_RANGE       16384
+#define ABS_ZERO        -273.15f
+#define NUM_ADC_SAMPLES   32
+#define AD595_MAX        330.0f
+#define AD8495_MAX       660.0f
+
+#define HARDWARE_PWM true
+
+#define GET_PIN_MAP_PIN(index) index
+#define GET_PIN_MAP_INDEX(pin) pin
+#define PARSED_PIN_INDEX(code, dval) parser.intval(code, dval)
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+// reset reason
+extern uint8_t MCUSR;
+
+int freeMemory(void);
+
+typedef AveragingFilter<NUM_ADC_SAMPLES> ADCAveragingFilter;
+
+class HAL {
+
+  public: /** Constructor */
+
+    HAL();
+
+    virtual ~HAL();
+
+  public: /** Public Parameters */
+
+    static int16_t AnalogInputValues[NUM_ANALOG_INPUTS];
+    static bool Analog_is_ready;
+
+    static uint8_t pwm_value[NUM_DIGITAL_PINS];
+
+  private: /** Private Parameters */
+
+    #if HAS_HOTENDS
+      static ADCAveragingFilter sensorFilters[HOTENDS];
+    #endif
+    #if HAS_BEDS
+      static ADCAveragingFilter BEDsensorFilters[BEDS];
+    #endif
+    #if HAS_CHAMBERS
+      static ADCAveragingFilter CHAMBERsensorFilters[CHAMBERS];
+    #endif
+    #if HAS_COOLERS
+      static ADCAveragingFilter COOLERsensorFilters[COOLERS];
+    #endif
+
+  public: /** Public Function */
+
+    static void analogStart();
+    static void AdcChangePin(const pin_t old_pin, const pin_t new_pin);
+
+    static void hwSetup(void);
+
+    static bool pwm_status(const pin_t pin);
+    static bool tc_status(const pin_t pin);
+
+    static void analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq=1000U, const bool hwpwm=true);
+
+    static void Tick();
+
+    FORCE_INLINE static void pinMode(const pin_t pin, const uint8_t mode) {
+      switch (mode) {
+        case INPUT:         SET_INPUT(pin);         break;
+        case OUTPUT:        SET_OUTPUT(pin);        break;
+        case INPUT_PULLUP:  SET_INPUT_PULLUP(pin);  break;
+        case OUTPUT_LOW:    SET_OUTPUT(pin);        break;
+        case OUTPUT_HIGH:   SET_OUTPUT_HIGH(pin);   break;
+        default:                                    break;
+      }
+    }
+    FORCE_INLINE static void digitalWrite(const pin_t pin, const bool value) {
+      WRITE(pin, value);
+    }
+    FORCE_INLINE static bool digitalRead(const pin_t pin) {
+      return READ(pin);
+    }
+    FORCE_INLINE static void setInputPullup(const pin_t pin, const bool onoff) {
+      if (onoff) SET_INPUT_PULLUP(pin);
+      else SET_INPUT(pin);
+    }
+
+    FORCE_INLINE static void delayNanoseconds(const uint32_t delayNs) {
+      HAL_delay_cycles(delayNs * (CYCLES_PER_US) / 1000UL);
+    }
+    FORCE_INLINE static void delayMicroseconds(const uint32_t delayUs) {
+      HAL_delay_cycles(delayUs * (CYCLES_PER_US));
+    }
+    FORCE_INLINE static void delayMilliseconds(const uint16_t delayMs) {
+      delay(delayMs);
+    }
+    FORCE_INLINE static uint32_t timeInMilliseconds() {
+      return millis();
+    }
+
+    static void showStartReason();
+
+    static void resetHardware();
+
+    //
+    // SPI related functions
+    //
+
+    // Initialize SPI bus
+    static void spiBegin();
+
+    // Configure SPI for specified SPI speed
+    static void spiInit(uint8_t spiRate=6);
+
+    // Write single byte to SPI
+    static void spiSend(uint8_t nbyte);
+
+    // Write buffer to  SPI
+    static void spiSend(const uint8_t* buf, size_t nbyte);
+
+    // Write single byte to specified SPI channel
+    static void spiSend(uint32_t chan, uint8_t nbyte);
+
+    // Write buffer to specified SPI channel
+    static void spiSend(uint32_t chan ,const uint8_t* buf, size_t nbyte);
+
+    // Read single byte from SPI
+    static uint8_t spiReceive(void);
+
+    // Read single byte from specified SPI channel
+    static uint8_t spiReceive(uint32_t chan);
+
+    // Read from SPI into buffer
+    static void spiReadBlock(uint8_t* buf, uint16_t nbyte);
+
+    // Write token and then write from 512 byte buffer to SPI (for SD card)
+    static void spiSendBlock(uint8_t token, const uint8_t* buf);
+
+};
+
+/**
+ * Public functions
+ */
+
+// Disable interrupts
+void cli(void);
+
+// Enable interrupts
+void sei(void);
+
+// Tone
+void tone(const pin_t _pin, const uint16_t frequency, const uint16_t duration=0);
+void noTone(const pin_t _pin);
+
+// EEPROM
+uint8_t eeprom_read_byte(uint8_t* pos);
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n);
+void eeprom_write_byte(uint8_t* pos, uint8_t value);
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n);
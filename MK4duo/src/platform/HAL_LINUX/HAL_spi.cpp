@@ -0,0 +1,95 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: HAL for the Linux native simulator
+ *
+ * The only device on the SPI bus is the virtual SD card.
+ *
+ * For ARDUINO_ARCH_LINUX
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+
+#include "../../../MK4duo.h"
+#include "simulator/virtual_sdcard.h"
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+static uint8_t spiTransfer(uint8_t nbyte) {
+  return VirtualSdCard::transfer(nbyte);
+}
+
+void HAL::spiBegin() {
+  OUT_WRITE(SS_PIN, HIGH);
+}
+
+void HAL::spiInit(uint8_t spiRate/*=6*/) {
+  UNUSED(spiRate);
+}
+
+// Write single byte to SPI
+void HAL::spiSend(uint8_t nbyte) { spiTransfer(nbyte); }
+
+void HAL::spiSend(const uint8_t* buf, size_t nbyte) {
+  for (size_t i = 0; i < nbyte; i++)
+    spiTransfer(buf[i]);
+}
+
+void HAL::spiSend(uint32_t chan, uint8_t nbyte) {
+  UNUSED(chan);
+  spiTransfer(nbyte);
+}
+
+void HAL::spiSend(uint32_t chan, const uint8_t* buf, size_t nbyte) {
+  UNUSED(chan);
+  spiSend(buf, nbyte);
+}
+
+// Read single byte from SPI
+uint8_t HAL::spiReceive(void) { return spiTransfer(0xFF); }
+
+uint8_t HAL::spiReceive(uint32_t chan) {
+  UNUSED(chan);
+  return spiTransfer(0xFF);
+}
+
+// Read from SPI into buffer
+void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) {
+  for (uint16_t i = 0; i < nbyte; i++)
+    buf[i] = spiTransfer(0xFF);
+}
+
+// Write from buffer to SPI
+void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) {
+  spiTransfer(token);
+  for (uint16_t i = 0; i < 512; i++)
+    spiTransfer(buf[i]);
+}
+
+#endif // ARDUINO_ARCH_LINUX
@@ -0,0 +1,179 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * Description: HAL for the Linux native simulator
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "../../../MK4duo.h"
+#include "HAL_timers.h"
+
+// --------------------------------------------------------------------------
+// Externals
+// --------------------------------------------------------------------------
+extern HAL_SYSTICK_ISR();
+extern HAL_TONE_TIMER_ISR();
+extern HAL_STEPPER_TIMER_ISR();
+
+// --------------------------------------------------------------------------
+// Local defines
+// --------------------------------------------------------------------------
+#define TIMER_WRAP  0x100000000ULL
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+const tTimerConfig TimerConfig [NUM_HARDWARE_TIMERS] = {
+  { HAL_systick_isr,        NvicPrioritySystick },  // 0 - SysTick
+  { HAL_tone_timer_isr,     NvicPriorityTone    },  // 1 - Tone
+  { HAL_stepper_timer_isr,  NvicPriorityStepper },  // 2 - Stepper
+};
+
+uint32_t  HAL_min_pulse_cycle     = 0,
+          HAL_min_pulse_tick      = 0,
+          HAL_add_pulse_ticks     = 0,
+          HAL_frequency_limit[8]  = { 0 };
+
+uint64_t    VirtualClock::ticks         = 0;
+bool        VirtualClock::primask       = false;
+uint8_t     VirtualClock::active_level  = NvicPriorityThread;
+tTimerState VirtualClock::timer[NUM_HARDWARE_TIMERS];
+
+// --------------------------------------------------------------------------
+// Virtual clock
+// --------------------------------------------------------------------------
+
+void VirtualClock::elapse(const uint32_t delta) {
+
+  const uint64_t target = ticks + delta;
+
+  for (;;) {
+
+    // Find the first compare match not later than target
+    int8_t next = -1;
+    for (uint8_t t = 0; t < NUM_HARDWARE_TIMERS; t++) {
+      const tTimerState &tm = timer[t];
+      if (tm.running && tm.deadline <= target && (next < 0 || tm.deadline < timer[next].deadline))
+        next = t;
+    }
+    if (next < 0) break;
+
+    // Counter reset on RC compare and interrupt flagged
+    tTimerState &tm = timer[next];
+    NOLESS(ticks, tm.deadline);
+    tm.base     = tm.deadline;
+    tm.deadline = tm.base + (tm.rc ? tm.rc : TIMER_WRAP);
+    tm.pending  = true;
+
+    dispatch();
+  }
+
+  // Handlers may have consumed time beyond target
+  NOLESS(ticks, target);
+}
+
+void VirtualClock::dispatch() {
+
+  while (!primask) {
+
+    // Highest priority pending handler able to preempt the running one
+    int8_t next = -1;
+    for (uint8_t t = 0; t < NUM_HARDWARE_TIMERS; t++) {
+      if (timer[t].pending && timer[t].irq_enabled && TimerConfig[t].priority < active_level
+        && (next < 0 || TimerConfig[t].priority < TimerConfig[next].priority)
+      ) next = t;
+    }
+    if (next < 0) return;
+
+    timer[next].pending = false;
+
+    const uint8_t old_level = active_level;
+    active_level = TimerConfig[next].priority;
+    (*TimerConfig[next].handler)();
+    active_level = old_level;
+  }
+}
+
+void VirtualClock::set_compare(const uint8_t timer_num, const uint32_t rc) {
+  tTimerState &tm = timer[timer_num];
+  tm.rc = rc;
+  // If the counter is already past RC it runs up to the overflow first
+  const uint32_t cnt = counter(timer_num);
+  tm.deadline = tm.base + rc + (cnt > rc ? TIMER_WRAP : 0);
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+  tTimerState &tm = VirtualClock::timer[timer_num];
+
+  // Disable interrupt, just in case it was already enabled
+  tm.irq_enabled = false;
+  tm.pending = false;
+
+  // Reset counter, set compare value and start timer
+  tm.base = VirtualClock::ticks;
+  tm.rc = HAL_TIMER_RATE / frequency;
+  tm.deadline = tm.base + tm.rc;
+  tm.running = true;
+
+  // Finally, enable IRQ
+  HAL_timer_enable_interrupt(timer_num);
+}
+
+uint32_t HAL_isr_execuiton_cycle(const uint32_t rate) {
+  return (ISR_BASE_CYCLES + ISR_BEZIER_CYCLES + (ISR_LOOP_CYCLES) * rate + ISR_LA_BASE_CYCLES + ISR_LA_LOOP_CYCLES) / rate;
+}
+
+void HAL_calc_pulse_cycle() {
+  HAL_min_pulse_cycle = MAX((uint32_t)((F_CPU) / stepper.data.maximum_rate), ((F_CPU) / 500000UL) * MAX((uint32_t)stepper.data.minimum_pulse, 1UL));
+  HAL_min_pulse_tick  = uint32_t(stepper.data.minimum_pulse) * (STEPPER_TIMER_TICKS_PER_US);
+  HAL_add_pulse_ticks = (HAL_min_pulse_cycle / (PULSE_TIMER_PRESCALE)) - HAL_min_pulse_tick;
+
+  // The stepping frequency limits for each multistepping rate
+  HAL_frequency_limit[0] = ((F_CPU) / HAL_isr_execuiton_cycle(1))       ;
+  HAL_frequency_limit[1] = ((F_CPU) / HAL_isr_execuiton_cycle(2))   >> 1;
+  HAL_frequency_limit[2] = ((F_CPU) / HAL_isr_execuiton_cycle(4))   >> 2;
+  HAL_frequency_limit[3] = ((F_CPU) / HAL_isr_execuiton_cycle(8))   >> 3;
+  HAL_frequency_limit[4] = ((F_CPU) / HAL_isr_execuiton_cycle(16))  >> 4;
+  HAL_frequency_limit[5] = ((F_CPU) / HAL_isr_execuiton_cycle(32))  >> 5;
+  HAL_frequency_limit[6] = ((F_CPU) / HAL_isr_execuiton_cycle(64))  >> 6;
+  HAL_frequency_limit[7] = ((F_CPU) / HAL_isr_execuiton_cycle(128)) >> 7;
+}
+
+#endif // ARDUINO_ARCH_LINUX
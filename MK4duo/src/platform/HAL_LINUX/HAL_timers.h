@@ -0,0 +1,280 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * Description: HAL for the Linux native simulator
+ *
+ * The timers are emulated on a virtual clock that counts HAL_TIMER_RATE
+ * ticks. Each timer behaves like a SAM3X TC channel in UP_RC mode: the
+ * counter resets on RC compare and flags its interrupt. Handlers run
+ * synchronously, in NVIC priority order, whenever the virtual clock is
+ * advanced and interrupts are not masked.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+#pragma once
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include <stdint.h>
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+#define NUM_HARDWARE_TIMERS 3
+
+#define NvicPriorityStepper 2
+#define NvicPriorityTone    14
+#define NvicPrioritySystick 15
+
+#define NvicPriorityThread  0xFF  // Thread mode, no handler active
+
+// SysTick (HAL::Tick)
+#define SYSTICK_TIMER_NUM           0
+#define HAL_SYSTICK_ISR()           void HAL_systick_isr()
+
+// Tone
+#define TONE_TIMER_NUM              1  // index of timer to use for beeper tones
+#define HAL_TONE_TIMER_ISR()        void HAL_tone_timer_isr()
+
+#define HAL_TIMER_RATE              ((F_CPU) / 2) // 42 MHz
+
+// Stepper Timer
+#define STEPPER_TIMER_NUM           2
+#define STEPPER_TIMER_RATE          HAL_TIMER_RATE
+#define STEPPER_TIMER_TICKS_PER_US  ((STEPPER_TIMER_RATE) / 1000000)                          // 42 - stepper timer ticks per µs
+#define STEPPER_TIMER_PRESCALE      ((F_CPU / 1000000UL) / STEPPER_TIMER_TICKS_PER_US)        // 2
+#define STEPPER_TIMER_MIN_INTERVAL  1                                                         // minimum time in µs between stepper interrupts
+#define STEPPER_TIMER_MAX_INTERVAL  (STEPPER_TIMER_TICKS_PER_US * STEPPER_TIMER_MIN_INTERVAL) // maximum time in µs between stepper interrupts
+#define STEPPER_CLOCK_RATE          ((F_CPU) / 128)                                           // frequency of the clock used for stepper pulse timing
+#define PULSE_TIMER_PRESCALE        STEPPER_TIMER_PRESCALE
+#define HAL_STEPPER_TIMER_ISR()     void HAL_stepper_timer_isr()
+
+#define ENABLE_STEPPER_INTERRUPT()  HAL_timer_enable_interrupt(STEPPER_TIMER_NUM)
+#define DISABLE_STEPPER_INTERRUPT() HAL_timer_disable_interrupt(STEPPER_TIMER_NUM)
+#define STEPPER_ISR_ENABLED()       HAL_timer_interrupt_is_enabled(STEPPER_TIMER_NUM)
+
+// Virtual cost of the accesses that advance the clock, in timer ticks
+#define SIM_COUNTER_READ_TICKS      1UL   // Read of a timer counter register
+#define SIM_THREAD_CALL_TICKS       (STEPPER_TIMER_TICKS_PER_US)  // millis()/micros() from thread mode
+
+// The ISR execution estimate is the same of the Due, the simulator runs the same code
+// The base ISR takes 752 cycles
+#define ISR_BASE_CYCLES               752UL
+
+// Linear advance base time is 64 cycles
+#if ENABLED(LIN_ADVANCE)
+  #define ISR_LA_BASE_CYCLES          64UL
+#else
+  #define ISR_LA_BASE_CYCLES          0UL
+#endif
+
+// Bezier interpolation adds 40 cycles
+#if ENABLED(BEZIER_JERK_CONTROL)
+  #define ISR_BEZIER_CYCLES           40UL
+#else
+  #define ISR_BEZIER_CYCLES           0UL
+#endif
+
+// Stepper Loop base cycles
+#define ISR_LOOP_BASE_CYCLES          4UL
+
+// To start the step pulse, in the worst case takes
+#define ISR_START_STEPPER_CYCLES      13UL
+
+// And each stepper (start + stop pulse) takes in worst case
+#define ISR_STEPPER_CYCLES            16UL
+
+// For each stepper, we add its time
+#if HAS_X_STEP
+  #define ISR_START_X_STEPPER_CYCLES  ISR_START_STEPPER_CYCLES
+  #define ISR_X_STEPPER_CYCLES        ISR_STEPPER_CYCLES
+#else
+  #define ISR_START_X_STEPPER_CYCLES  0UL
+  #define ISR_X_STEPPER_CYCLES        0UL
+#endif
+#if HAS_Y_STEP
+  #define ISR_START_Y_STEPPER_CYCLES  ISR_START_STEPPER_CYCLES
+  #define ISR_Y_STEPPER_CYCLES        ISR_STEPPER_CYCLES
+#else
+  #define ISR_START_Y_STEPPER_CYCLES  0UL
+  #define ISR_Y_STEPPER_CYCLES        0UL
+#endif
+#if HAS_Z_STEP
+  #define ISR_START_Z_STEPPER_CYCLES  ISR_START_STEPPER_CYCLES
+  #define ISR_Z_STEPPER_CYCLES        ISR_STEPPER_CYCLES
+#else
+  #define ISR_START_Z_STEPPER_CYCLES  0UL
+  #define ISR_Z_STEPPER_CYCLES        0UL
+#endif
+
+// E is always interpolated
+#define ISR_START_E_STEPPER_CYCLES    ISR_START_STEPPER_CYCLES
+#define ISR_E_STEPPER_CYCLES          ISR_STEPPER_CYCLES
+
+// If linear advance is disabled, then the loop also handles them
+#if DISABLED(LIN_ADVANCE) && ENABLED(COLOR_MIXING_EXTRUDER)
+  #define ISR_START_MIXING_STEPPER_CYCLES ((MIXING_STEPPERS) * 13UL)
+  #define ISR_MIXING_STEPPER_CYCLES       ((MIXING_STEPPERS) * 16UL)
+#else
+  #define ISR_START_MIXING_STEPPER_CYCLES 0UL
+  #define ISR_MIXING_STEPPER_CYCLES       0UL
+#endif
+
+// Calculate the minimum time to start all stepper pulses in the ISR loop
+#define MIN_ISR_START_LOOP_CYCLES     (ISR_START_X_STEPPER_CYCLES + ISR_START_Y_STEPPER_CYCLES + ISR_START_Z_STEPPER_CYCLES + ISR_START_E_STEPPER_CYCLES + ISR_START_MIXING_STEPPER_CYCLES)
+
+// And the total minimum loop time is, without including the base
+#define MIN_ISR_LOOP_CYCLES           (ISR_X_STEPPER_CYCLES + ISR_Y_STEPPER_CYCLES + ISR_Z_STEPPER_CYCLES + ISR_E_STEPPER_CYCLES + ISR_MIXING_STEPPER_CYCLES)
+
+// But the user could be enforcing a minimum time, so the loop time is
+#define ISR_LOOP_CYCLES               (ISR_LOOP_BASE_CYCLES + MAX(HAL_min_pulse_cycle, MIN_ISR_LOOP_CYCLES))
+
+// If linear advance is enabled, then it is handled separately
+#if ENABLED(LIN_ADVANCE)
+
+  // Estimate the minimum LA loop time
+  #if ENABLED(COLOR_MIXING_EXTRUDER)
+    #define MIN_ISR_LA_LOOP_CYCLES  ((MIXING_STEPPERS) * 16UL)
+  #else
+    #define MIN_ISR_LA_LOOP_CYCLES  16UL
+  #endif
+
+  // And the real loop time
+  #define ISR_LA_LOOP_CYCLES  MAX(HAL_min_pulse_cycle, MIN_ISR_LA_LOOP_CYCLES)
+
+#else
+  #define ISR_LA_LOOP_CYCLES  0UL
+#endif
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+
+// ISR handler type
+using pfnISR_Handler = void(*)(void);
+
+typedef struct {
+  pfnISR_Handler  handler;
+  uint8_t         priority;
+} tTimerConfig;
+
+typedef struct {
+  uint64_t  base,         // Virtual clock at the last counter reset
+            deadline;     // Virtual clock of the next RC compare
+  uint32_t  rc;           // Compare register
+  bool      running,      // Counter clock enabled
+            irq_enabled,  // NVIC enable
+            pending;      // NVIC pending
+} tTimerState;
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+extern const tTimerConfig TimerConfig[];
+
+extern uint32_t HAL_min_pulse_cycle,
+                HAL_min_pulse_tick,
+                HAL_add_pulse_ticks,
+                HAL_frequency_limit[8];
+
+// --------------------------------------------------------------------------
+// Virtual clock and interrupt controller
+// --------------------------------------------------------------------------
+
+class VirtualClock {
+
+  public: /** Public Parameters */
+
+    static uint64_t     ticks;        // HAL_TIMER_RATE ticks since power on
+    static bool         primask;      // Global interrupt mask
+    static uint8_t      active_level; // Priority of the running handler
+    static tTimerState  timer[NUM_HARDWARE_TIMERS];
+
+  public: /** Public Function */
+
+    // Advance the clock, running every handler that becomes due
+    static void elapse(const uint32_t delta);
+
+    // Run the pending handlers allowed at the current priority level
+    static void dispatch();
+
+    FORCE_INLINE static bool in_isr() { return active_level != NvicPriorityThread; }
+
+    FORCE_INLINE static void disable_irq() { primask = true; }
+    FORCE_INLINE static void enable_irq() { primask = false; dispatch(); }
+
+    // Counter value as read from the TC_CV register
+    FORCE_INLINE static uint32_t counter(const uint8_t timer_num) {
+      return uint32_t(ticks - timer[timer_num].base);
+    }
+
+    // Program RC, the next compare follows the UP_RC counter semantics
+    static void set_compare(const uint8_t timer_num, const uint32_t rc);
+
+};
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency);
+
+void HAL_calc_pulse_cycle();
+
+FORCE_INLINE static void HAL_timer_enable_interrupt(const uint8_t timer_num) {
+  VirtualClock::timer[timer_num].irq_enabled = true;
+  VirtualClock::dispatch();
+}
+
+FORCE_INLINE static void HAL_timer_disable_interrupt(const uint8_t timer_num) {
+  VirtualClock::timer[timer_num].irq_enabled = false;
+}
+
+FORCE_INLINE static bool HAL_timer_interrupt_is_enabled(const uint8_t timer_num) {
+  return VirtualClock::timer[timer_num].irq_enabled;
+}
+
+FORCE_INLINE static uint32_t HAL_timer_get_count(const uint8_t timer_num) {
+  return VirtualClock::timer[timer_num].rc;
+}
+
+FORCE_INLINE static void HAL_timer_set_count(const uint8_t timer_num, const uint32_t count) {
+  VirtualClock::set_compare(timer_num, count);
+}
+
+FORCE_INLINE static uint32_t HAL_timer_get_current_count(const uint8_t timer_num) {
+  VirtualClock::elapse(SIM_COUNTER_READ_TICKS);
+  return VirtualClock::counter(timer_num);
+}
+
+FORCE_INLINE static void HAL_timer_isr_prologue(const uint8_t timer_num) {
+  UNUSED(timer_num);
+}
@@ -0,0 +1,160 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Minimal Arduino core for the Linux native simulator.
+ *
+ * Only the part of the Arduino API used by MK4duo is provided.
+ * Time is virtual: millis() and micros() are derived from the
+ * simulator clock, not from the host wall clock.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <ctype.h>
+
+#ifndef F_CPU
+  #define F_CPU 84000000UL  // Virtual CPU, same clock as Arduino Due
+#endif
+
+#define ARDUINO 10809
+
+typedef bool      boolean;
+typedef uint8_t   byte;
+typedef uint16_t  word;
+
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+
+#define LOW           0x0
+#define HIGH          0x1
+
+#define CHANGE        2
+#define FALLING       3
+#define RISING        4
+
+#define LSBFIRST      0
+#define MSBFIRST      1
+
+#define PI            3.1415926535897932384626433832795
+#define HALF_PI       1.5707963267948966192313216916398
+#define TWO_PI        6.283185307179586476925286766559
+#define DEG_TO_RAD    0.017453292519943295769236907684886
+#define RAD_TO_DEG    57.295779513082320876798154814105
+
+#ifndef constrain
+  #define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#endif
+#define radians(deg)  ((deg)*DEG_TO_RAD)
+#define degrees(rad)  ((rad)*RAD_TO_DEG)
+#define sq(x)         ((x)*(x))
+
+#define lowByte(w)    ((uint8_t) ((w) & 0xFF))
+#define highByte(w)   ((uint8_t) ((w) >> 8))
+
+#define bitRead(value, bit)   (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)    ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)  ((value) &= ~(1UL << (bit)))
+
+#define digitalPinToInterrupt(p)  (p)
+#define NOT_AN_INTERRUPT          -1
+
+// Program memory is plain memory on the host
+#define PROGMEM
+#define PGM_P             const char *
+#define PSTR(s)           (s)
+#define F(s)              (reinterpret_cast<const __FlashStringHelper *>(s))
+#define pgm_read_byte(a)        (*(const uint8_t*)(a))
+#define pgm_read_byte_near(a)   pgm_read_byte(a)
+#define pgm_read_word(a)        (*(a))
+#define pgm_read_word_near(a)   pgm_read_word(a)
+#define pgm_read_dword(a)       (*(a))
+#define pgm_read_dword_near(a)  pgm_read_dword(a)
+#define pgm_read_float(a)       (*(const float*)(a))
+#define pgm_read_ptr(a)         (*(a))
+#define strcpy_P          strcpy
+#define strncpy_P         strncpy
+#define strcat_P          strcat
+#define strncat_P         strncat
+#define strcmp_P          strcmp
+#define strncmp_P         strncmp
+#define strcasecmp_P      strcasecmp
+#define strchr_P          strchr
+#define strrchr_P         strrchr
+#define strstr_P          strstr
+#define strlen_P          strlen
+#define memcpy_P          memcpy
+#define sprintf_P         sprintf
+#define snprintf_P        snprintf
+#define vsnprintf_P       vsnprintf
+
+class __FlashStringHelper;
+
+// Sketch
+void setup();
+void loop();
+
+// Time
+uint32_t millis();
+uint32_t micros();
+void delay(const uint32_t ms);
+void delayMicroseconds(const uint32_t us);
+void yield();
+
+// Interrupts
+void noInterrupts();
+void interrupts();
+void attachInterrupt(const uint8_t pin, void (*isr)(void), const int mode);
+void detachInterrupt(const uint8_t pin);
+
+// I/O
+void pinMode(const uint8_t pin, const uint8_t mode);
+void digitalWrite(const uint8_t pin, const uint8_t value);
+int  digitalRead(const uint8_t pin);
+int  analogRead(const uint8_t pin);
+void analogWrite(const uint8_t pin, const int value);
+
+// Misc
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+char* itoa(int value, char *str, int radix);
+char* ltoa(long value, char *str, int radix);
+char* utoa(unsigned value, char *str, int radix);
+char* ultoa(unsigned long value, char *str, int radix);
+char* dtostrf(double val, signed char width, unsigned char prec, char *sout);
+
+inline bool isDigit(const int c) { return c >= '0' && c <= '9'; }
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
@@ -0,0 +1,96 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Print base class for the Linux native simulator.
+ */
+
+#define DEC 10
+#define HEX 16
+#define OCT  8
+#define BIN  2
+
+class Print {
+
+  public: /** Constructor */
+
+    Print() {}
+
+    virtual ~Print() {}
+
+  public: /** Public Function */
+
+    virtual size_t write(uint8_t) = 0;
+
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+      size_t n = 0;
+      while (size--) n += write(*buffer++);
+      return n;
+    }
+
+    size_t write(const char *str) {
+      return str ? write((const uint8_t *)str, strlen(str)) : 0;
+    }
+
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    size_t print(const char str[])        { return write(str); }
+    size_t print(const String &s)         { return write(s.c_str()); }
+    size_t print(const __FlashStringHelper *ifsh) { return write(reinterpret_cast<const char *>(ifsh)); }
+    size_t print(char c)                  { return write((uint8_t)c); }
+    size_t print(unsigned char b, int base=DEC) { return print((unsigned long)b, base); }
+    size_t print(int n, int base=DEC)           { return print((long)n, base); }
+    size_t print(unsigned int n, int base=DEC)  { return print((unsigned long)n, base); }
+    size_t print(long n, int base=DEC) {
+      if (base == 10 && n < 0) return write('-') + printNumber((unsigned long)-n, 10);
+      return printNumber((unsigned long)n, base);
+    }
+    size_t print(unsigned long n, int base=DEC) { return printNumber(n, base); }
+    size_t print(double n, int digits=2) {
+      char buf[40];
+      snprintf(buf, sizeof(buf), "%.*f", digits, n);
+      return write(buf);
+    }
+
+    size_t println()                      { return write("\r\n"); }
+    template<typename T> size_t println(const T &v)           { return print(v) + println(); }
+    template<typename T> size_t println(const T &v, int base) { return print(v, base) + println(); }
+
+    virtual void flush() {}
+
+  private: /** Private Function */
+
+    size_t printNumber(unsigned long n, const uint8_t base) {
+      char buf[8 * sizeof(long) + 1];
+      char *str = &buf[sizeof(buf) - 1];
+      *str = '\0';
+      const uint8_t b = base < 2 ? 10 : base;
+      do {
+        const char c = n % b;
+        n /= b;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+      } while (n);
+      return write(str);
+    }
+
+};
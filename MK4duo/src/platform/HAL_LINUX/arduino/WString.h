@@ -0,0 +1,53 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Tiny String class for the Linux native simulator.
+ * Only what MK4duo needs: construction, length and indexing.
+ */
+
+class String {
+
+  public: /** Constructor */
+
+    String(const char* cstr="") : buffer(strdup(cstr ? cstr : "")) {}
+    String(const String &s) : buffer(strdup(s.buffer)) {}
+
+    ~String() { free(buffer); }
+
+  private: /** Private Parameters */
+
+    char* buffer;
+
+  public: /** Public Function */
+
+    String& operator=(const String &s) {
+      if (this != &s) { free(buffer); buffer = strdup(s.buffer); }
+      return *this;
+    }
+
+    unsigned int length() const             { return strlen(buffer); }
+    char operator[](unsigned int index) const { return buffer[index]; }
+    const char* c_str() const               { return buffer; }
+
+};
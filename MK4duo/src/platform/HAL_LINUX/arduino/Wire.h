@@ -0,0 +1,43 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * I2C stub for the Linux native simulator. Nothing answers on the bus.
+ */
+
+class TwoWire : public Stream {
+  public:
+    void begin() {}
+    void begin(uint8_t) {}
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission(bool=true) { return 2; } // NACK on address
+    uint8_t requestFrom(uint8_t, uint8_t, bool=true) { return 0; }
+    size_t write(uint8_t) { return 1; }
+    size_t write(const uint8_t*, size_t size) { return size; }
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,149 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Minimal Arduino core for the Linux native simulator.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+#include "../simulator/virtual_sdcard.h"
+
+SPIClass  SPI;
+TwoWire   Wire;
+
+
+// Time
+uint32_t millis() {
+  if (!VirtualClock::in_isr()) VirtualClock::elapse(SIM_THREAD_CALL_TICKS);
+  return uint32_t(VirtualClock::ticks / ((HAL_TIMER_RATE) / 1000UL));
+}
+
+uint32_t micros() {
+  if (!VirtualClock::in_isr()) VirtualClock::elapse(SIM_THREAD_CALL_TICKS);
+  return uint32_t(VirtualClock::ticks / ((HAL_TIMER_RATE) / 1000000UL));
+}
+
+void delay(const uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    VirtualClock::elapse((HAL_TIMER_RATE) / 1000UL);
+    yield();
+  }
+}
+
+void delayMicroseconds(const uint32_t us) {
+  VirtualClock::elapse(us * ((HAL_TIMER_RATE) / 1000000UL));
+}
+
+void yield() {}
+
+// Interrupts
+void noInterrupts() { VirtualClock::disable_irq(); }
+void interrupts()   { VirtualClock::enable_irq(); }
+
+void attachInterrupt(const uint8_t pin, void (*isr)(void), const int mode) {
+  UNUSED(mode);
+  if (pin < NUM_DIGITAL_PINS) VirtualPins::isr[pin] = isr;
+}
+
+void detachInterrupt(const uint8_t pin) {
+  if (pin < NUM_DIGITAL_PINS) VirtualPins::isr[pin] = nullptr;
+}
+
+// I/O
+void pinMode(const uint8_t pin, const uint8_t mode)       { HAL::pinMode(pin, mode); }
+void digitalWrite(const uint8_t pin, const uint8_t value) { HAL::digitalWrite(pin, value); }
+int  digitalRead(const uint8_t pin)                       { return HAL::digitalRead(pin); }
+
+int analogRead(const uint8_t pin) {
+  return Simulator::adc_read(pin >= A0 ? pin - A0 : pin);
+}
+
+void analogWrite(const uint8_t pin, const int value) {
+  HAL::analogWrite(pin, value);
+}
+
+// SPI
+uint8_t SPIClass::transfer(uint8_t data) {
+  return VirtualSdCard::transfer(data);
+}
+
+uint16_t SPIClass::transfer16(uint16_t data) {
+  const uint8_t hi = transfer(data >> 8);
+  return (hi << 8) | transfer(data & 0xFF);
+}
+
+void SPIClass::transfer(void* buf, size_t count) {
+  uint8_t *p = (uint8_t*)buf;
+  while (count--) { *p = transfer(*p); p++; }
+}
+
+// Misc
+long random(long max) {
+  return max > 0 ? ::random() % max : 0;
+}
+
+long random(long min, long max) {
+  return min < max ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed) srandom(seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+char* ultoa(unsigned long value, char *str, int radix) {
+  char buf[8 * sizeof(long) + 1], *p = &buf[sizeof(buf) - 1];
+  *p = '\0';
+  if (radix < 2 || radix > 36) radix = 10;
+  do {
+    const int d = value % radix;
+    *--p = d < 10 ? '0' + d : 'a' + d - 10;
+    value /= radix;
+  } while (value);
+  return strcpy(str, p);
+}
+
+char* ltoa(long value, char *str, int radix) {
+  if (radix == 10 && value < 0) {
+    *str = '-';
+    ultoa(-(unsigned long)value, str + 1, radix);
+    return str;
+  }
+  return ultoa((unsigned long)value, str, radix);
+}
+
+char* itoa(int value, char *str, int radix)       { return ltoa(value, str, radix); }
+char* utoa(unsigned value, char *str, int radix)  { return ultoa(value, str, radix); }
+
+char* dtostrf(double val, signed char width, unsigned char prec, char *sout) {
+  sprintf(sout, "%*.*f", width, prec, val);
+  return sout;
+}
+
+#endif // ARDUINO_ARCH_LINUX
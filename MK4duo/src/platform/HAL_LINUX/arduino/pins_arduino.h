@@ -0,0 +1,52 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Virtual pin map for the Linux native simulator.
+ * Pins 0-127 are plain digital lines, A0-A15 map onto 54-69 like Due/Mega.
+ */
+
+#define NUM_DIGITAL_PINS  128
+
+#define A0    54
+#define A1    55
+#define A2    56
+#define A3    57
+#define A4    58
+#define A5    59
+#define A6    60
+#define A7    61
+#define A8    62
+#define A9    63
+#define A10   64
+#define A11   65
+#define A12   66
+#define A13   67
+#define A14   68
+#define A15   69
+
+// Default SPI pins, as on the Due SPI header
+static const uint8_t SS   = 53;
+static const uint8_t MOSI = 51;
+static const uint8_t MISO = 50;
+static const uint8_t SCK  = 52;
@@ -0,0 +1,37 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Processor-level delays for hardware interfaces
+ *
+ * On the simulator a busy wait is just virtual time passing,
+ * so the delay advances the clock by the requested cycles.
+ */
+
+FORCE_INLINE static void HAL_delay_cycles(const uint32_t cycles) {
+  VirtualClock::elapse(cycles / (STEPPER_TIMER_PRESCALE));
+}
+
+FORCE_INLINE static void HAL_delay_4cycles(const uint32_t cy) {
+  HAL_delay_cycles(cy << 2);
+}
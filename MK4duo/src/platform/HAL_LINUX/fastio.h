@@ -0,0 +1,222 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Description: Fast IO functions for the Linux native simulator
+ *
+ * Pins are virtual: an array of levels and modes. Inputs are driven by the
+ * simulator models (endstops), outputs the simulator cares about (step and
+ * dir pins) are watched and every edge is reported with its virtual time.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+// **************************************************************************
+//
+// Description: Fast IO functions for the Linux native simulator
+//
+// ARDUINO_ARCH_LINUX
+// **************************************************************************
+
+#include "../../feature/pcf8574/pcf8574.h"
+
+/**
+ * Types
+ */
+
+enum VirtualPinWatch : uint8_t {
+  PIN_WATCH_NONE    = 0,
+  PIN_WATCH_TRACE   = _BV(0),   // Edges go to the step trace
+  PIN_WATCH_MODEL   = _BV(1),   // Edges move the simulated axes
+  PIN_DRIVEN        = _BV(2)    // Input level set by a simulator model
+};
+
+class VirtualPins {
+
+  public: /** Public Parameters */
+
+    static uint8_t  level[NUM_DIGITAL_PINS],
+                    mode[NUM_DIGITAL_PINS],
+                    watch[NUM_DIGITAL_PINS];
+
+    // Handlers of attachInterrupt(), called on the changes of driven inputs
+    static void (*isr[NUM_DIGITAL_PINS])();
+
+  public: /** Public Function */
+
+    // Called on every level change of a watched pin
+    static void changed(const uint8_t pin, const bool value);
+
+    // A simulator model changed the level of a driven input
+    static void drive(const uint8_t pin, const bool value) {
+      if (pin >= NUM_DIGITAL_PINS || level[pin] == value) return;
+      level[pin] = value;
+      if (isr[pin]) isr[pin]();
+    }
+
+};
+
+/**
+ * utility functions
+ */
+
+#ifndef MASK
+  #define MASK(PIN) (1 << PIN)
+#endif
+
+#define OUTPUT_LOW  0x3
+#define OUTPUT_HIGH 0x4
+
+/**
+ * magic I/O routines
+ * now you can simply SET_OUTPUT(STEP); WRITE(STEP, 1); WRITE(STEP, 0);
+ */
+
+// NOT CHANGE uint8_t in pin_t!
+// Read a pin
+FORCE_INLINE static bool READ(const uint8_t pin) {
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    if (pin >= PIN_START_FOR_PCF8574) {
+      return pcf8574.digitalRead(pin - PIN_START_FOR_PCF8574);
+    }
+    else
+  #endif
+  {
+    return pin < NUM_DIGITAL_PINS && VirtualPins::level[pin];
+  }
+}
+
+// Write to a pin
+FORCE_INLINE static void WRITE(const uint8_t pin, const bool flag) {
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    if (pin >= PIN_START_FOR_PCF8574) {
+      pcf8574.digitalWrite(pin - PIN_START_FOR_PCF8574, flag);
+    }
+    else
+  #endif
+  {
+    if (pin >= NUM_DIGITAL_PINS || VirtualPins::level[pin] == flag) return;
+    VirtualPins::level[pin] = flag;
+    if (VirtualPins::watch[pin] & (PIN_WATCH_TRACE | PIN_WATCH_MODEL)) VirtualPins::changed(pin, flag);
+  }
+}
+
+// Toogle pin
+FORCE_INLINE static void TOGGLE(const uint8_t pin) {
+  WRITE(pin, !READ(pin));
+}
+
+/**
+ * Ports, the pins of a port written at once
+ *
+ * A port is 32 virtual pins. The pins of a mask are written one
+ * after the other at the same virtual time, so the watched pins
+ * still report every edge.
+ */
+typedef uint8_t fastio_port_t;
+
+FORCE_INLINE static bool PORT_VALID(const pin_t pin) { return WITHIN(pin, 0, NUM_DIGITAL_PINS - 1); }
+FORCE_INLINE static fastio_port_t PORT_OF(const pin_t pin) { return pin >> 5; }
+FORCE_INLINE static uint32_t PORT_MASK(const pin_t pin) { return 1UL << (pin & 0x1F); }
+
+// Set and clear the pins of the mask
+FORCE_INLINE static void PORT_WRITE(const fastio_port_t port, uint32_t mask, const bool flag) {
+  for (; mask; mask &= mask - 1) WRITE((port << 5) + __builtin_ctz(mask), flag);
+}
+FORCE_INLINE static void PORT_SET(const fastio_port_t port, const uint32_t mask)    { PORT_WRITE(port, mask, HIGH); }
+FORCE_INLINE static void PORT_CLEAR(const fastio_port_t port, const uint32_t mask)  { PORT_WRITE(port, mask, LOW); }
+
+// Set pin as input
+FORCE_INLINE static void SET_INPUT(const pin_t pin) {
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    if (pin >= PIN_START_FOR_PCF8574) {
+      pcf8574.pinMode(pin - PIN_START_FOR_PCF8574, INPUT);
+    }
+    else
+  #endif
+  {
+    if (WITHIN(pin, 0, NUM_DIGITAL_PINS - 1)) VirtualPins::mode[pin] = INPUT;
+  }
+}
+
+// Set pin as output
+FORCE_INLINE static void SET_OUTPUT(const pin_t pin) {
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    if (pin >= PIN_START_FOR_PCF8574) {
+      pcf8574.pinMode(pin - PIN_START_FOR_PCF8574, OUTPUT);
+    }
+    else
+  #endif
+  {
+    if (WITHIN(pin, 0, NUM_DIGITAL_PINS - 1)) {
+      VirtualPins::mode[pin] = OUTPUT;
+      WRITE(pin, LOW);
+    }
+  }
+}
+FORCE_INLINE static void SET_OUTPUT_HIGH(const pin_t pin) {
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    if (pin >= PIN_START_FOR_PCF8574) {
+      pcf8574.pinMode(pin - PIN_START_FOR_PCF8574, OUTPUT);
+      pcf8574.digitalWrite(pin - PIN_START_FOR_PCF8574, HIGH);
+    }
+    else
+  #endif
+  {
+    if (WITHIN(pin, 0, NUM_DIGITAL_PINS - 1)) {
+      VirtualPins::mode[pin] = OUTPUT;
+      WRITE(pin, HIGH);
+    }
+  }
+}
+
+// Set pin as input with pullup
+FORCE_INLINE static void SET_INPUT_PULLUP(const pin_t pin) {
+  if (WITHIN(pin, 0, NUM_DIGITAL_PINS - 1)) {
+    VirtualPins::mode[pin] = INPUT_PULLUP;
+    // Nothing else drives this input, the pullup does
+    if (!(VirtualPins::watch[pin] & PIN_DRIVEN)) VirtualPins::level[pin] = HIGH;
+  }
+}
+
+// Shorthand
+FORCE_INLINE static void OUT_WRITE(const pin_t pin, const uint8_t flag) {
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    if (pin >= PIN_START_FOR_PCF8574) {
+      pcf8574.pinMode(pin - PIN_START_FOR_PCF8574, OUTPUT);
+      pcf8574.digitalWrite(pin - PIN_START_FOR_PCF8574, flag);
+    }
+    else
+  #endif
+  {
+    if (flag)
+      SET_OUTPUT_HIGH(pin);
+    else
+      SET_OUTPUT(pin);
+  }
+}
+
+// Every pin of the simulator can do PWM
+FORCE_INLINE static bool USEABLE_HARDWARE_PWM(const pin_t pin) {
+  return WITHIN(pin, 0, NUM_DIGITAL_PINS - 1);
+}
@@ -0,0 +1,295 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * HardwareSerial.cpp - Serial port of the Linux native simulator
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+
+/** Protected Parameters */
+template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_r MKHardwareSerial<Cfg>::rx_buffer = { 0, 0, { 0 } };
+template<typename Cfg> uint32_t MKHardwareSerial<Cfg>::char_ticks = 0;
+template<typename Cfg> uint64_t MKHardwareSerial<Cfg>::next_char_ticks = 0;
+template<typename Cfg> bool     MKHardwareSerial<Cfg>::line_stalled = true;
+template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_dropped_bytes = 0;
+template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::rx_max_enqueued = 0;
+
+/** Protected Function */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::receive(void) {
+
+  static EmergencyStateEnum emergency_state; // = EP_RESET
+
+  if (Cfg::PORT != 0) return;
+
+  ring_buffer_pos_t h = rx_buffer.head;
+  const ring_buffer_pos_t t = rx_buffer.tail;
+
+  // After a stall the next character starts when the line is ready again
+  if (line_stalled) {
+    if ((ring_buffer_pos_t)((h + 1) & (Cfg::RX_SIZE - 1)) == t || !Simulator::host_available()) return;
+    next_char_ticks = VirtualClock::ticks + char_ticks;
+    line_stalled = false;
+  }
+
+  // Only the characters already arrived on the wire
+  while (Simulator::unlimited_line_speed() || VirtualClock::ticks >= next_char_ticks) {
+
+    const ring_buffer_pos_t i = (ring_buffer_pos_t)(h + 1) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
+
+    // The host does not overrun the buffer, it waits as with a flow control
+    if (i == t) { line_stalled = true; break; }
+
+    const int c = Simulator::host_read();
+    if (c < 0) { line_stalled = true; break; }
+
+    if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+
+    rx_buffer.buffer[h] = c;
+    h = i;
+
+    next_char_ticks += char_ticks;
+  }
+
+  rx_buffer.head = h;
+
+  if (Cfg::MAX_RX_QUEUED) {
+    const ring_buffer_pos_t rx_count = (ring_buffer_pos_t)(h - t) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
+    NOLESS(rx_max_enqueued, rx_count);
+  }
+
+}
+
+/** Public Function */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::begin(const long baud_setting) {
+  // 10 bits per character, 8N1
+  char_ticks = (HAL_TIMER_RATE) / (baud_setting / 10);
+  line_stalled = true;
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::end() {
+  flushTX();
+}
+
+template<typename Cfg>
+int MKHardwareSerial<Cfg>::peek(void) {
+  receive();
+  const int v = rx_buffer.head == rx_buffer.tail ? -1 : rx_buffer.buffer[rx_buffer.tail];
+  return v;
+}
+
+template<typename Cfg>
+int MKHardwareSerial<Cfg>::read(void) {
+
+  receive();
+
+  const ring_buffer_pos_t h = rx_buffer.head;
+  ring_buffer_pos_t t = rx_buffer.tail;
+
+  if (h == t) return -1;
+
+  int v = rx_buffer.buffer[t];
+  t = (ring_buffer_pos_t)(t + 1) & (Cfg::RX_SIZE - 1);
+
+  // Advance tail
+  rx_buffer.tail = t;
+
+  return v;
+
+}
+
+template<typename Cfg>
+typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::available(void) {
+  receive();
+  const ring_buffer_pos_t h = rx_buffer.head, t = rx_buffer.tail;
+  return (ring_buffer_pos_t)(Cfg::RX_SIZE + h - t) & (Cfg::RX_SIZE - 1);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::flush(void) {
+  rx_buffer.tail = rx_buffer.head;
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::write(const uint8_t c) {
+  if (Cfg::PORT == 0) Simulator::host_write(c);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::flushTX(void) {
+  if (Cfg::PORT == 0) Simulator::host_flush();
+}
+
+template<typename Cfg>
+size_t MKHardwareSerial<Cfg>::readBytes(char* buffer, size_t size) {
+
+  int c;
+  size_t count = 0;
+  const millis_l timeout = millis() + 1000UL;
+
+  while (count < size) {
+
+    do {
+      c = read();
+      if (c >= 0) break;
+    } while (PENDING(millis(), timeout));
+
+    if (c < 0) break;
+    *buffer++ = (char)c;
+    count++;
+  }
+
+  return count;
+
+}
+
+/**
+ * Imports from print.h
+ */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(char c, int base) {
+  print((long)c, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(unsigned char b, int base) {
+  print((unsigned long)b, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(int n, int base) {
+  print((long)n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(unsigned int n, int base) {
+  print((unsigned long)n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(long n, int base) {
+  if (base == 0) write(n);
+  else if (base == 10) {
+    if (n < 0) { print('-'); n = -n; }
+    printNumber(n, 10);
+  }
+  else
+    printNumber(n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(unsigned long n, int base) {
+  if (base == 0) write(n);
+  else printNumber(n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(double n, int digits) {
+  printFloat(n, digits);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::println(void) {
+  print('\r');
+  print('\n');
+}
+
+/** Private Function */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::printNumber(unsigned long n, uint8_t base) {
+
+  if (n) {
+    unsigned char buf[8 * sizeof(long)]; // Enough space for base 2
+    int8_t i = 0;
+    while (n) {
+      buf[i++] = n % base;
+      n /= base;
+    }
+    while (i--)
+      print((char)(buf[i] + (buf[i] < 10 ? '0' : 'A' - 10)));
+  }
+  else
+    print('0');
+
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::printFloat(double number, uint8_t digits) {
+
+  // Handle negative numbers
+  if (number < 0.0) {
+    print('-');
+    number = -number;
+  }
+
+  // Round correctly so that print(1.999, 2) prints as "2.00"
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i) rounding *= 0.1;
+  number += rounding;
+
+  // Extract the integer part of the number and print it
+  unsigned long int_part = (unsigned long)number;
+  double remainder = number - (double)int_part;
+  print(int_part);
+
+  // Print the decimal point, but only if there are digits beyond
+  if (digits) {
+    print('.');
+    // Extract digits from the remainder one at a time
+    while (digits--) {
+      remainder *= 10.0;
+      int toPrint = int(remainder);
+      print(toPrint);
+      remainder -= toPrint;
+    }
+  }
+
+}
+
+// Instantiate Class
+#if SERIAL_PORT_1 >= 0
+  template class MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>>;
+  MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>> MKSerial1;
+#endif
+
+#if SERIAL_PORT_2 >= 0
+  template class MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_2>>;
+  MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_2>> MKSerial2;
+#endif
+
+#if ENABLED(NEXTION) && NEXTION_SERIAL > 0
+  template class MKHardwareSerial<MK4duoSerialCfg<NEXTION_SERIAL>>;
+  MKHardwareSerial<MK4duoSerialCfg<NEXTION_SERIAL>> nexSerial;
+#endif
+
+#if HAS_MMU2 && MMU2_SERIAL > 0
+  template class MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>>;
+  MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
+#endif
+
+#endif // ARDUINO_ARCH_LINUX
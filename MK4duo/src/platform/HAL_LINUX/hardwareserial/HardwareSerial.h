@@ -0,0 +1,121 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Serial port of the Linux native simulator
+ *
+ * The wire of port 0 is the host connection of the simulator (a file, or
+ * the standard input and output). Characters are received at the pace
+ * of the configured baudrate in virtual time, unless the simulator runs
+ * with an unlimited line speed. Any other port is left unconnected.
+ */
+
+template<typename Cfg>
+class MKHardwareSerial {
+
+  public: /** Constructor */
+
+    MKHardwareSerial() {}
+
+  protected: /** Protected Parameters */
+
+    // Base size of type on buffer size
+    typedef typename TypeSelector<(Cfg::RX_SIZE>256), uint16_t, uint8_t>::type ring_buffer_pos_t;
+
+    struct ring_buffer_r {
+      ring_buffer_pos_t head, tail;
+      unsigned char buffer[Cfg::RX_SIZE];
+    };
+
+    static ring_buffer_r rx_buffer;
+
+    static uint32_t char_ticks;       // Virtual ticks to receive a character
+    static uint64_t next_char_ticks;  // Arrival of the next character
+    static bool     line_stalled;     // Host waiting for data or buffer space
+
+    static uint8_t  rx_dropped_bytes;
+
+    static ring_buffer_pos_t rx_max_enqueued;
+
+  protected: /** Protected Function */
+
+    // Move the characters arrived on the wire into the RX buffer
+    static void receive(void);
+
+  public: /** Public Function */
+
+    static void begin(const long);
+    static void end();
+    static int peek(void);
+    static int read(void);
+    static void flush(void);
+    static ring_buffer_pos_t available(void);
+    static void write(const uint8_t c);
+    static void flushTX(void);
+    static size_t readBytes(char* buffer, size_t size);
+
+    FORCE_INLINE static uint8_t dropped() { return Cfg::DROPPED_RX ? rx_dropped_bytes : 0; }
+    FORCE_INLINE static uint8_t buffer_overruns() { return 0; }
+    FORCE_INLINE static uint8_t framing_errors() { return 0; }
+    FORCE_INLINE static ring_buffer_pos_t rxMaxEnqueued() { return Cfg::MAX_RX_QUEUED ? rx_max_enqueued : 0; }
+
+    FORCE_INLINE static void write(const char* str) { while (*str) write(*str++); }
+    FORCE_INLINE static void write(const uint8_t* buffer, size_t size) { while (size--) write(*buffer++); }
+    FORCE_INLINE static void print(const String& s) { for (int i = 0; i < (int)s.length(); i++) write(s[i]); }
+    FORCE_INLINE static void print(const char* str) { write(str); }
+    FORCE_INLINE static void print(const __FlashStringHelper* str) { write(reinterpret_cast<const char*>(str)); }
+
+    static void print(char, int=BYTE);
+    static void print(unsigned char, int=DEC);
+    static void print(int, int=DEC);
+    static void print(unsigned int, int=DEC);
+    static void print(long, int=DEC);
+    static void print(unsigned long, int=DEC);
+    static void print(double, int=2);
+
+    static void println(void);
+
+    operator bool() { return true; }
+
+  private: /** Private Function */
+
+    static void printNumber(unsigned long, const uint8_t);
+    static void printFloat(double, uint8_t);
+
+};
+
+#if SERIAL_PORT_1 >= 0
+  extern MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>> MKSerial1;
+#endif
+
+#if SERIAL_PORT_2 >= 0
+  extern MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_2>> MKSerial2;
+#endif
+
+#if ENABLED(NEXTION) && NEXTION_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<NEXTION_SERIAL>> nexSerial;
+#endif
+
+#if HAS_MMU2 && MMU2_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
+#endif
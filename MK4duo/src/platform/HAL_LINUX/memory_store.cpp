@@ -0,0 +1,148 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../MK4duo.h"
+
+/**
+ * EEPROM of the simulator
+ *
+ * The image is kept in RAM, loaded from the eeprom file at the first
+ * access and saved back to it by access_write(). Without an eeprom
+ * file the settings last until the simulator exits.
+ */
+static uint8_t  eeprom_image[EEPROM_SIZE + 1];
+static bool     eeprom_loaded = false;
+
+static void eeprom_load() {
+  if (eeprom_loaded) return;
+  eeprom_loaded = true;
+  memset(eeprom_image, 0xFF, sizeof(eeprom_image));
+  if (Simulator::eeprom_file) {
+    FILE * const fp = fopen(Simulator::eeprom_file, "rb");
+    if (fp) {
+      if (fread(eeprom_image, 1, sizeof(eeprom_image), fp) == 0) memset(eeprom_image, 0xFF, sizeof(eeprom_image));
+      fclose(fp);
+    }
+  }
+}
+
+uint8_t eeprom_read_byte(uint8_t* pos) {
+  eeprom_load();
+  const ptr_int_t addr = (ptr_int_t)pos;
+  return addr <= EEPROM_SIZE ? eeprom_image[addr] : 0xFF;
+}
+
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
+  uint8_t *dst = (uint8_t*)pos;
+  ptr_int_t addr = (ptr_int_t)eeprom_address;
+  while (n--) *dst++ = eeprom_read_byte((uint8_t*)addr++);
+}
+
+void eeprom_write_byte(uint8_t* pos, uint8_t value) {
+  eeprom_load();
+  const ptr_int_t addr = (ptr_int_t)pos;
+  if (addr <= EEPROM_SIZE) eeprom_image[addr] = value;
+}
+
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
+  const uint8_t *src = (const uint8_t*)pos;
+  ptr_int_t addr = (ptr_int_t)eeprom_address;
+  while (n--) eeprom_write_byte((uint8_t*)addr++, *src++);
+}
+
+#if HAS_EEPROM
+
+#if !HAS_EEPROM_SD
+  static bool eeprom_save() {
+    if (!Simulator::eeprom_file) return false;
+    FILE * const fp = fopen(Simulator::eeprom_file, "wb");
+    if (!fp) return true;
+    const bool error = fwrite(eeprom_image, 1, sizeof(eeprom_image), fp) != sizeof(eeprom_image);
+    return fclose(fp) != 0 || error;
+  }
+#endif
+
+MemoryStore memorystore;
+
+/** Public Parameters */
+#if HAS_EEPROM_SD
+  char MemoryStore::eeprom_data[EEPROM_SIZE];
+#endif
+
+/** Public Function */
+bool MemoryStore::access_write() {
+  #if HAS_EEPROM_SD
+    card.write_eeprom();
+    return false;
+  #else
+    return eeprom_save();
+  #endif
+}
+
+bool MemoryStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+
+  while(size--) {
+    uint8_t v = *value;
+    #if HAS_EEPROM_SD
+      eeprom_data[pos] = v;
+    #else
+      uint8_t * const p = (uint8_t * const)(ptr_int_t)pos;
+      if (v != eeprom_read_byte(p)) {
+        eeprom_write_byte(p, v);
+        if (eeprom_read_byte(p) != v) {
+          SERIAL_LM(ECHO, MSG_ERR_EEPROM_WRITE);
+          return true;
+        }
+      }
+    #endif
+    crc16(crc, &v, 1);
+    pos++;
+    value++;
+  };
+
+  return false;
+}
+
+bool MemoryStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
+
+  while(size--) {
+    #if HAS_EEPROM_SD
+      uint8_t c = eeprom_data[pos];
+    #else
+      uint8_t c = eeprom_read_byte((uint8_t*)(ptr_int_t)pos);
+    #endif
+    if (writing) *value = c;
+    crc16(crc, &c, 1);
+    pos++;
+    value++;
+  };
+
+  return false;
+}
+
+size_t MemoryStore::capacity() { return EEPROM_SIZE + 1; }
+
+#endif // HAS_EEPROM
+
+#endif // ARDUINO_ARCH_LINUX
@@ -0,0 +1,56 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Support routines for the Linux native simulator
+ */
+
+/**
+ * Translation of routines & variables used by pinsDebug.h
+ */
+
+#include "Arduino.h"
+
+#define NUMBER_PINS_TOTAL NUM_DIGITAL_PINS
+
+#define digitalRead_mod(p)  digitalRead(p)
+#define PRINT_PORT(p)       SERIAL_SP(12);
+#define NAME_FORMAT(p)      PSTR("%-##p##s")
+#define PRINT_ARRAY_NAME(x) do {sprintf_P(buffer, PSTR("%-" STRINGIFY(MAX_NAME_LENGTH) "s"), pin_array[x].name); SERIAL_STR(buffer);} while (0)
+#define PRINT_PIN(p)        do {sprintf_P(buffer, PSTR("%02d  mode:  %02d"), p, VirtualPins::mode[p]); SERIAL_STR(buffer);} while (0)
+#define GET_ARRAY_PIN(p)    pin_array[p].pin
+#define VALID_PIN(pin)      (pin >= 0 && pin < (uint8_t)NUMBER_PINS_TOTAL ? 1 : 0)
+#define DIGITAL_PIN_TO_ANALOG_PIN(p) int(p - analogInputToDigitalPin(0))
+#define IS_ANALOG(P)        (((P) >= analogInputToDigitalPin(0)) && ((P) <= analogInputToDigitalPin(NUM_ANALOG_INPUTS - 1)))
+
+bool GET_PINMODE(const pin_t pin) {  // 1: output, 0: input
+  return VirtualPins::mode[pin] == OUTPUT;
+}
+
+bool GET_ARRAY_IS_DIGITAL(const pin_t pin) {
+  return !IS_ANALOG(pin);
+}
+
+void pwm_details(int32_t pin) {
+  if (HAL::pwm_status(pin))
+    SERIAL_MV("PWM = ", HAL::pwm_value[pin]);
+}
@@ -0,0 +1,209 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * motion_bench.cpp - Motion core benchmark of the Linux native simulator
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+
+#include <time.h>
+
+#define PROBE_CALIBRATION_LOOPS 10000
+
+/** Public Parameters */
+bool MotionBench::enabled = false;
+
+/** Private Parameters */
+FILE *MotionBench::file = nullptr;
+
+probe_stats_t MotionBench::stats[PROBE_COUNT] = { { 0, 0, 0 } };
+
+uint64_t  MotionBench::excluded_ns      = 0,
+          MotionBench::probe_cost_ns    = 0,
+          MotionBench::wall_start_ns    = 0,
+          MotionBench::step_events      = 0,
+          MotionBench::starved_since    = 0,
+          MotionBench::starvation_ticks = 0;
+
+uint32_t  MotionBench::blocks_queued    = 0,
+          MotionBench::blocks_started   = 0,
+          MotionBench::starvations      = 0;
+
+uint8_t   MotionBench::recalculate_max_depth  = 0,
+          MotionBench::synchronize_depth      = 0;
+
+bool      MotionBench::running = false;
+
+// Interrupts and waits are not charged to the scopes they interrupt
+static constexpr bool probe_excluded[MotionBench::PROBE_COUNT] = {
+  false,  // PROBE_BUFFER_LINE
+  false,  // PROBE_BUFFER_SEGMENTS
+  false,  // PROBE_BUFFER_STEPS
+  false,  // PROBE_RECALCULATE
+  false,  // PROBE_TRAPEZOID
+  false,  // PROBE_BLOCK_PHASE
+  true,   // PROBE_STEPPER_ISR
+  true,   // PROBE_SYSTICK_ISR
+  true,   // PROBE_PLANNER_WAIT
+  true    // PROBE_SYNCHRONIZE
+};
+
+/** Public Function */
+bool MotionBench::open(const char * const filename) {
+
+  file = strcmp(filename, "-") ? fopen(filename, "w") : stderr;
+  if (!file) return false;
+
+  // A probe reads the clock twice, measure it to take it out of the figures
+  const uint64_t start = now_ns();
+  for (uint16_t i = 0; i < PROBE_CALIBRATION_LOOPS; i++) now_ns();
+  probe_cost_ns = (now_ns() - start) / PROBE_CALIBRATION_LOOPS;
+
+  wall_start_ns = now_ns();
+  enabled = true;
+  return true;
+}
+
+void MotionBench::close() {
+  if (!file) return;
+  report();
+  if (file != stderr) fclose(file);
+  file = nullptr;
+  enabled = false;
+}
+
+void MotionBench::enter(Probe &p) {
+  if (p.probe == PROBE_SYNCHRONIZE) synchronize_depth++;
+  p.excluded_ns = excluded_ns;
+  p.start_ns = now_ns();
+}
+
+void MotionBench::leave(Probe &p) {
+
+  const uint64_t  end = now_ns(),
+                  elapsed = end - p.start_ns - (excluded_ns - p.excluded_ns);
+  const uint64_t  net = elapsed > probe_cost_ns ? elapsed - probe_cost_ns : 0;
+
+  probe_stats_t &s = stats[p.probe];
+  s.count++;
+  s.total_ns += net;
+  if (net > s.max_ns) {
+    s.max_ns = net;
+    if (p.probe == PROBE_RECALCULATE) recalculate_max_depth = planner.moves_planned();
+  }
+
+  // The enclosing scopes see the whole elapsed time of an excluded one,
+  // plus the clock reads of its probe
+  if (probe_excluded[p.probe]) excluded_ns += elapsed + 2 * probe_cost_ns;
+
+  switch (p.probe) {
+
+    case PROBE_SYNCHRONIZE: synchronize_depth--; break;
+
+    // The queue ran dry under the stepper
+    case PROBE_BLOCK_PHASE:
+      if (running && !planner.has_blocks_queued()) {
+        running = false;
+        if (!synchronize_depth && Simulator::input_pending()) {
+          starvations++;
+          starved_since = VirtualClock::ticks;
+        }
+      }
+      break;
+
+    default: break;
+  }
+
+}
+
+void MotionBench::block_started(const uint32_t step_event_count) {
+  if (!enabled) return;
+  blocks_started++;
+  step_events += step_event_count;
+  running = true;
+  if (starved_since) {
+    starvation_ticks += VirtualClock::ticks - starved_since;
+    starved_since = 0;
+  }
+}
+
+void MotionBench::report() {
+
+  #define PRINT_KEY(K, F, V)  fprintf(file, "%-32s " F "\n", K, V)
+  #define MEAN_NS(P)          (stats[P].count ? double(stats[P].total_ns) / double(stats[P].count) : 0.0)
+
+  const double  virtual_s = double(VirtualClock::ticks) / double(HAL_TIMER_RATE),
+                wall_s    = double(now_ns() - wall_start_ns) * 1e-9,
+                plan_s    = double(stats[PROBE_BUFFER_LINE].total_ns + stats[PROBE_BUFFER_SEGMENTS].total_ns) * 1e-9;
+
+  const probe_stats_t &isr = stats[PROBE_STEPPER_ISR];
+
+  PRINT_KEY("virtual_time_s",                 "%.6f", virtual_s);
+  PRINT_KEY("wall_time_s",                    "%.6f", wall_s);
+  PRINT_KEY("probe_cost_ns",                  "%llu", (unsigned long long)probe_cost_ns);
+
+  PRINT_KEY("buffer_line_calls",              "%llu", (unsigned long long)stats[PROBE_BUFFER_LINE].count);
+  PRINT_KEY("buffer_segments_calls",          "%llu", (unsigned long long)stats[PROBE_BUFFER_SEGMENTS].count);
+  PRINT_KEY("blocks_planned",                 "%u",   blocks_queued);
+  PRINT_KEY("blocks_planned_per_s",           "%.0f", plan_s > 0.0 ? double(blocks_queued) / plan_s : 0.0);
+  PRINT_KEY("buffer_line_mean_ns",            "%.1f", MEAN_NS(PROBE_BUFFER_LINE));
+  PRINT_KEY("buffer_line_max_ns",             "%llu", (unsigned long long)stats[PROBE_BUFFER_LINE].max_ns);
+  PRINT_KEY("buffer_segments_mean_ns",        "%.1f", MEAN_NS(PROBE_BUFFER_SEGMENTS));
+  PRINT_KEY("buffer_segments_max_ns",         "%llu", (unsigned long long)stats[PROBE_BUFFER_SEGMENTS].max_ns);
+  PRINT_KEY("recalculate_mean_ns",            "%.1f", MEAN_NS(PROBE_RECALCULATE));
+  PRINT_KEY("recalculate_max_ns",             "%llu", (unsigned long long)stats[PROBE_RECALCULATE].max_ns);
+  PRINT_KEY("recalculate_max_depth",          "%u",   recalculate_max_depth);
+  PRINT_KEY("trapezoid_calls",                "%llu", (unsigned long long)stats[PROBE_TRAPEZOID].count);
+  PRINT_KEY("trapezoid_mean_ns",              "%.1f", MEAN_NS(PROBE_TRAPEZOID));
+
+  PRINT_KEY("blocks_executed",                "%u",   blocks_started);
+  PRINT_KEY("blocks_executed_per_virtual_s",  "%.1f", virtual_s > 0.0 ? double(blocks_started) / virtual_s : 0.0);
+  PRINT_KEY("step_events",                    "%llu", (unsigned long long)step_events);
+  PRINT_KEY("stepper_isr_calls",              "%llu", (unsigned long long)isr.count);
+  PRINT_KEY("stepper_isr_per_step_event",     "%.4f", step_events ? double(isr.count) / double(step_events) : 0.0);
+  PRINT_KEY("stepper_isr_ns_per_step_event",  "%.1f", step_events ? double(isr.total_ns) / double(step_events) : 0.0);
+  PRINT_KEY("stepper_isr_mean_ns",            "%.1f", MEAN_NS(PROBE_STEPPER_ISR));
+  PRINT_KEY("stepper_isr_max_ns",             "%llu", (unsigned long long)isr.max_ns);
+  PRINT_KEY("block_phase_mean_ns",            "%.1f", MEAN_NS(PROBE_BLOCK_PHASE));
+  PRINT_KEY("block_phase_max_ns",             "%llu", (unsigned long long)stats[PROBE_BLOCK_PHASE].max_ns);
+
+  PRINT_KEY("planner_starvations",            "%u",   starvations);
+  PRINT_KEY("planner_starved_s",              "%.6f", double(starvation_ticks) / double(HAL_TIMER_RATE));
+
+  #undef PRINT_KEY
+  #undef MEAN_NS
+
+}
+
+/** Private Function */
+uint64_t MotionBench::now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+}
+
+#endif // ARDUINO_ARCH_LINUX
@@ -0,0 +1,127 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * motion_bench.h - Motion core benchmark of the Linux native simulator
+ *
+ * The planner and the stepper mark their hot paths with MOTION_PROBE().
+ * Each probe measures the host CPU time of its scope. The time spent in
+ * the interrupts and in the waits nested inside a scope is subtracted,
+ * so buffer_line() is not charged for the stepper ISR that runs while
+ * it waits for a free block.
+ *
+ * The stepper also reports every block it starts. When the block queue
+ * runs dry while G-code is still waiting to be planned, and the main
+ * loop is not in a synchronize(), it counts as a planner starvation.
+ *
+ * The report is written at exit, one "key value" line per figure.
+ * buildroot/bin/motion_bench runs the corpora and collects the reports.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#define MOTION_PROBE(P)         MotionBench::Probe motion_probe_(MotionBench::PROBE_##P)
+#define MOTION_BLOCK_START(B)   MotionBench::block_started((B)->step_event_count)
+#define MOTION_BLOCK_QUEUED()   MotionBench::block_queued()
+
+struct probe_stats_t {
+  uint64_t  count,
+            total_ns,
+            max_ns;
+};
+
+class MotionBench {
+
+  public: /** Constructor */
+
+    MotionBench() {}
+
+  public: /** Public Parameters */
+
+    enum ProbeEnum : uint8_t {
+      PROBE_BUFFER_LINE,      // Planner::buffer_line()
+      PROBE_BUFFER_SEGMENTS,  // Planner::buffer_segments()
+      PROBE_BUFFER_STEPS,     // Planner::buffer_steps()
+      PROBE_RECALCULATE,      // Planner::recalculate(), once for each planned block or batch
+      PROBE_TRAPEZOID,        // Planner::calculate_trapezoid_for_block(), once for each replanned block
+      PROBE_BLOCK_PHASE,      // Stepper::block_phase_step()
+      PROBE_STEPPER_ISR,      // Stepper timer interrupt
+      PROBE_SYSTICK_ISR,      // SysTick interrupt
+      PROBE_PLANNER_WAIT,     // Wait for a free block
+      PROBE_SYNCHRONIZE,      // Planner::synchronize()
+      PROBE_COUNT
+    };
+
+    struct Probe {
+      const ProbeEnum probe;
+      uint64_t        start_ns,
+                      excluded_ns;
+      Probe(const ProbeEnum p) : probe(p) { if (enabled) enter(*this); }
+      ~Probe() { if (enabled) leave(*this); }
+    };
+
+    static bool enabled;
+
+  private: /** Private Parameters */
+
+    static FILE *file;
+
+    static probe_stats_t stats[PROBE_COUNT];
+
+    static uint64_t excluded_ns,      // Time of the excluded scopes, always growing
+                    probe_cost_ns,    // Cost of a probe, calibrated at start
+                    wall_start_ns,
+                    step_events,
+                    starved_since,    // Virtual time of the last starvation
+                    starvation_ticks;
+
+    static uint32_t blocks_queued,
+                    blocks_started,
+                    starvations;
+
+    static uint8_t  recalculate_max_depth,
+                    synchronize_depth;
+
+    static bool     running;          // The stepper has a block to run
+
+  public: /** Public Function */
+
+    static bool open(const char * const filename);
+    static void close();
+
+    static void enter(Probe &p);
+    static void leave(Probe &p);
+
+    // The planner queued a block
+    static inline void block_queued() { if (enabled) blocks_queued++; }
+
+    // The stepper starts a block of step_event_count events
+    static void block_started(const uint32_t step_event_count);
+
+    static void report();
+
+  private: /** Private Function */
+
+    static uint64_t now_ns();
+
+};
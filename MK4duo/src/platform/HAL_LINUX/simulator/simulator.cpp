@@ -0,0 +1,530 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * simulator.cpp - Linux native simulator
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+#include "steptrace.h"
+#include "virtual_sdcard.h"
+
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define SIM_TICKS_PER_MS    ((HAL_TIMER_RATE) / 1000UL)
+#define SIM_AMBIENT_TEMP    25.0f
+
+/** Public Parameters */
+const char  *Simulator::eeprom_file = nullptr,
+            *Simulator::sdcard_file = nullptr;
+
+/** Private Parameters */
+FILE  *Simulator::input   = nullptr,
+      *Simulator::output  = nullptr;
+
+bool  Simulator::unlimited_speed  = false,
+      Simulator::real_time        = false,
+      Simulator::quiet            = false,
+      Simulator::input_eof        = false;
+
+uint64_t Simulator::time_limit_ticks = 0;
+
+/**
+ * Host input buffer
+ */
+static uint8_t  input_buffer[4096];
+static size_t   input_pos = 0,
+                input_len = 0;
+static bool     input_is_file = false;
+
+// Like a host after the reset of the board, wait for the boot to complete
+#define SIM_HOST_CONNECT_MS   500UL
+static uint64_t host_connect_ticks = UINT64_MAX;
+
+/**
+ * Thermal model: a lumped heat capacity heated by the PWM power
+ * and losing heat to the ambient, more with the part cooling fan on,
+ * and to the extruded filament, integrated every millisecond.
+ * The sensor follows the block with a first order lag.
+ */
+struct thermal_model_t {
+  float temperature,    // °C
+        sensor,         // °C read by the sensor
+        power,          // W at full PWM
+        capacity,       // J/K
+        loss,           // W/K
+        fan_loss,       // W/K more at full fan
+        filament_heat,  // J/K of a mm of filament
+        response;       // s, time constant of the sensor
+  void init(const float p, const float c, const float l, const float fl=0.0f, const float fh=0.0f, const float r=0.0f) {
+    temperature = sensor = SIM_AMBIENT_TEMP; power = p; capacity = c; loss = l;
+    fan_loss = fl; filament_heat = fh; response = r;
+  }
+  void update(const uint8_t pwm, const float fan=0.0f, const float e_mm=0.0f) {
+    const float delta = temperature - SIM_AMBIENT_TEMP,
+                heat  = (power * pwm * (1.0f / 255.0f) - (loss + fan_loss * fan) * delta) * 0.001f - filament_heat * e_mm * delta;
+    temperature += heat / capacity;
+    sensor += (temperature - sensor) * 0.001f / (response + 0.001f);
+  }
+};
+
+#if HAS_HOTENDS
+  static thermal_model_t hotend_model[HOTENDS];
+  // Extruder steps of the hotends in the last millisecond
+  static pin_t    hotend_step_pin[HOTENDS];
+  static int32_t  hotend_e_steps[HOTENDS];
+#endif
+#if HAS_BEDS
+  static thermal_model_t bed_model[BEDS];
+#endif
+#if HAS_CHAMBERS
+  static thermal_model_t chamber_model[CHAMBERS];
+#endif
+
+/**
+ * Axis model: position of the X, Y and Z motors in steps, from the step
+ * and dir edges. The motors start at the middle of the travel and the
+ * endstops trigger at the ends of it.
+ */
+struct axis_model_t {
+  pin_t   step_pin,
+          dir_pin;
+  int32_t position,
+          half_travel;
+};
+
+static axis_model_t axis_model[XYZ];
+
+static struct timespec wall_start;
+
+/** Public Function */
+void Simulator::init(int argc, char** argv) {
+
+  const char  *input_file   = nullptr,
+              *output_file  = nullptr,
+              *trace_file   = nullptr,
+              *bench_file   = nullptr;
+
+  bool real_time_set = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "i:o:t:s:e:b:l:urqh")) != -1) {
+    switch (opt) {
+      case 'i': input_file = optarg; break;
+      case 'o': output_file = optarg; break;
+      case 't': trace_file = optarg; break;
+      case 's': sdcard_file = optarg; break;
+      case 'e': eeprom_file = optarg; break;
+      case 'b': bench_file = optarg; break;
+      case 'l': time_limit_ticks = uint64_t(atof(optarg) * (HAL_TIMER_RATE)); break;
+      case 'u': unlimited_speed = true; break;
+      case 'r': real_time = real_time_set = true; break;
+      case 'q': quiet = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-i input] [-o output] [-t trace] [-s sdcard.img] [-e eeprom.bin] [-b report] [-l seconds] [-u] [-r] [-q]\n", argv[0]);
+        exit(EXIT_ERROR);
+    }
+  }
+
+  input = input_file ? fopen(input_file, "rb") : stdin;
+  if (!input) {
+    fprintf(stderr, "Cannot open input %s\n", input_file);
+    exit(EXIT_ERROR);
+  }
+
+  output = output_file ? fopen(output_file, "wb") : stdout;
+  if (!output) {
+    fprintf(stderr, "Cannot open output %s\n", output_file);
+    exit(EXIT_ERROR);
+  }
+  if (isatty(fileno(output))) setvbuf(output, nullptr, _IOLBF, 0);
+
+  struct stat st;
+  input_is_file = fstat(fileno(input), &st) == 0 && S_ISREG(st.st_mode);
+
+  // An interactive host talks in wall clock time
+  if (!input_is_file && !real_time_set) real_time = true;
+
+  if (trace_file && !StepTrace::open(trace_file)) {
+    fprintf(stderr, "Cannot create trace %s\n", trace_file);
+    exit(EXIT_ERROR);
+  }
+
+  if (bench_file && !MotionBench::open(bench_file)) {
+    fprintf(stderr, "Cannot create benchmark report %s\n", bench_file);
+    exit(EXIT_ERROR);
+  }
+
+  if (sdcard_file && !VirtualSdCard::open(sdcard_file)) {
+    fprintf(stderr, "Cannot open SD card image %s\n", sdcard_file);
+    exit(EXIT_ERROR);
+  }
+
+  // The thermal models run from the first tick, before setup() is over
+  #if HAS_HOTENDS
+    LOOP_HOTEND() hotend_model[h].init(40.0f, 12.0f, 0.12f, 0.08f, 0.0135f, 1.5f);
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() bed_model[h].init(200.0f, 500.0f, 1.5f);
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() chamber_model[h].init(100.0f, 4000.0f, 4.0f);
+  #endif
+
+  clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+}
+
+void Simulator::start() {
+
+  // Every driver goes to the trace and to the pulses count
+  LOOP_DRV() if (driver[d]) StepTrace::add_channel(driver[d]);
+  StepTrace::start();
+
+  // X, Y and Z motors move the axis model
+  #if MECH(DELTA)
+    const float travel_mm[XYZ] = { mechanics.data.height, mechanics.data.height, mechanics.data.height };
+  #else
+    const float travel_mm[XYZ] = { X_MAX_POS - X_MIN_POS, Y_MAX_POS - Y_MIN_POS, Z_MAX_POS - Z_MIN_POS };
+  #endif
+  LOOP_XYZ(axis) {
+    axis_model_t &am = axis_model[axis];
+    Driver * const drv = driver[X_DRV + axis];
+    am.step_pin = drv ? drv->data.pin.step : -1;
+    am.dir_pin  = drv ? drv->data.pin.dir : -1;
+    am.position = 0;
+    am.half_travel = int32_t(travel_mm[axis] * mechanics.data.axis_steps_per_mm[axis] * 0.5f);
+    if (am.step_pin >= 0) VirtualPins::watch[am.step_pin] |= PIN_WATCH_MODEL;
+  }
+
+  // The extruder motors feed the filament to the hotend models
+  #if HAS_HOTENDS
+    LOOP_HOTEND() {
+      Driver * const drv = driver[E0_DRV + h];
+      hotend_step_pin[h] = drv ? drv->data.pin.step : -1;
+      hotend_e_steps[h] = 0;
+      if (hotend_step_pin[h] >= 0) VirtualPins::watch[hotend_step_pin[h]] |= PIN_WATCH_MODEL;
+    }
+  #endif
+
+  #define DRIVEN_PIN(P) VirtualPins::watch[P] |= PIN_DRIVEN
+  #if HAS_X_MIN
+    DRIVEN_PIN(X_MIN_PIN);
+  #endif
+  #if HAS_X_MAX
+    DRIVEN_PIN(X_MAX_PIN);
+  #endif
+  #if HAS_Y_MIN
+    DRIVEN_PIN(Y_MIN_PIN);
+  #endif
+  #if HAS_Y_MAX
+    DRIVEN_PIN(Y_MAX_PIN);
+  #endif
+  #if HAS_Z_MIN
+    DRIVEN_PIN(Z_MIN_PIN);
+  #endif
+  #if HAS_Z_MAX
+    DRIVEN_PIN(Z_MAX_PIN);
+  #endif
+  #if HAS_Z_PROBE_PIN
+    DRIVEN_PIN(Z_PROBE_PIN);
+  #endif
+  #undef DRIVEN_PIN
+
+  endstops_update();
+
+  host_connect_ticks = VirtualClock::ticks + SIM_HOST_CONNECT_MS * SIM_TICKS_PER_MS;
+
+}
+
+bool Simulator::finished() {
+  return !input_pending() && !planner.has_blocks_queued();
+}
+
+bool Simulator::input_pending() {
+  return !(input_eof && input_pos >= input_len)
+      || MKSERIAL1.available()
+      #if HAS_SD_SUPPORT
+        || IS_SD_PRINTING()
+      #endif
+      || !commands.buffer_ring.isEmpty();
+}
+
+void Simulator::spin() {
+
+  #if HAS_HOTENDS
+    #if HAS_FANS
+      const float fan = fans[0].actual_speed() * (1.0f / 255.0f);
+    #else
+      constexpr float fan = 0.0f;
+    #endif
+    LOOP_HOTEND() {
+      const float e_mm = MAX(hotend_e_steps[h], 0) * mechanics.steps_to_mm[E_AXIS_N(h)];
+      hotend_e_steps[h] = 0;
+      hotend_model[h].update(hotends[h].pwm_value, fan, e_mm);
+    }
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() bed_model[h].update(beds[h].pwm_value);
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() chamber_model[h].update(chambers[h].pwm_value);
+  #endif
+
+  #if ENABLED(ADC_SCAN)
+    adc_scan();
+  #endif
+
+  watchdog.check();
+
+  if (time_limit_ticks && VirtualClock::ticks >= time_limit_ticks)
+    terminate(EXIT_TIME_LIMIT);
+
+  // Wait for the wall clock to reach the virtual one
+  if (real_time) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const int64_t wall_us     = int64_t(now.tv_sec - wall_start.tv_sec) * 1000000LL + (now.tv_nsec - wall_start.tv_nsec) / 1000,
+                  virtual_us  = int64_t(VirtualClock::ticks / (STEPPER_TIMER_TICKS_PER_US));
+    if (virtual_us > wall_us + 1000) usleep(virtual_us - wall_us);
+  }
+
+}
+
+void Simulator::terminate(const ExitEnum code) {
+
+  static PGM_P const reason[] = { "done", "time limit", "killed", "watchdog", "reset", "error" };
+
+  host_flush();
+  if (output != stdout) fclose(output);
+
+  if (!quiet) {
+    fprintf(stderr, "Simulation %s after %.6f s\n", reason[code], double(VirtualClock::ticks) / double(HAL_TIMER_RATE));
+    StepTrace::print_summary(stderr);
+  }
+
+  StepTrace::close();
+  MotionBench::close();
+  VirtualSdCard::close();
+
+  exit(code == EXIT_TIME_LIMIT ? EXIT_DONE : code);
+
+}
+
+/**
+ * Host side of the serial port
+ */
+bool Simulator::host_available() {
+
+  if (VirtualClock::ticks < host_connect_ticks) return false;
+  if (input_pos < input_len) return true;
+  if (input_eof) return false;
+
+  // Never block on an interactive host
+  if (!input_is_file) {
+    struct pollfd pfd = { fileno(input), POLLIN, 0 };
+    if (poll(&pfd, 1, 0) <= 0) return false;
+  }
+
+  const ssize_t n = read(fileno(input), input_buffer, sizeof(input_buffer));
+  if (n <= 0) {
+    input_eof = true;
+    return false;
+  }
+
+  input_pos = 0;
+  input_len = size_t(n);
+  return true;
+}
+
+int Simulator::host_read() {
+  return host_available() ? input_buffer[input_pos++] : -1;
+}
+
+void Simulator::host_write(const uint8_t c) {
+  fputc(c, output);
+}
+
+void Simulator::host_flush() {
+  fflush(output);
+}
+
+/**
+ * ADC reading of an analog pin, 12 bits
+ */
+static uint16_t sensor_adc_value(const sensor_data_t &sensor, const float temperature) {
+
+  float raw = 0;
+
+  if (WITHIN(sensor.type, 1, 9)) {
+    // Invert Steinhart-Hart for the log of the resistance, with Newton steps
+    const float recipT = 1.0f / (temperature - (ABS_ZERO));
+    float lnR = (recipT - sensor.shA) / sensor.shB;
+    for (uint8_t i = 0; i < 4; i++)
+      lnR -= (sensor.shA + sensor.shB * lnR + sensor.shC * lnR * lnR * lnR - recipT) / (sensor.shB + 3.0f * sensor.shC * lnR * lnR);
+    const float resistance = expf(lnR),
+                vss = 2 * sensor.adcLowOffset,
+                vref = AD_RANGE + 2 * sensor.adcHighOffset;
+    // Inverse of the resistance calculation of sensor_data_t::getTemperature()
+    raw = (resistance * (vref - 0.5f) + sensor.pullup_res * (vss - 0.5f)) / (resistance + sensor.pullup_res);
+  }
+  #if HAS_AD595 || HAS_AD8495
+    else if (sensor.type == -1 || sensor.type == -2) {
+      const float amp_max = sensor.type == -1 ? AD595_MAX : AD8495_MAX;
+      raw = (temperature - sensor.ad595_offset) / sensor.ad595_gain * float(AD_RANGE) / amp_max;
+    }
+  #endif
+  else
+    return 0;
+
+  // From the oversampled range to the 12 bits of the converter
+  return uint16_t(constrain(raw, 0.0f, float(AD_RANGE - 1))) >> (OVERSAMPLENR);
+}
+
+uint16_t Simulator::adc_read(const pin_t pin) {
+  #if HAS_HOTENDS
+    LOOP_HOTEND() if (hotends[h].data.sensor.pin == pin) return sensor_adc_value(hotends[h].data.sensor, hotend_model[h].sensor);
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() if (beds[h].data.sensor.pin == pin) return sensor_adc_value(beds[h].data.sensor, bed_model[h].sensor);
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() if (chambers[h].data.sensor.pin == pin) return sensor_adc_value(chambers[h].data.sensor, chamber_model[h].sensor);
+  #endif
+  return 0;
+}
+
+#if ENABLED(ADC_SCAN)
+
+  /**
+   * Like the converter of the DUE started by its timer: 2 scans each ms,
+   * the enabled channels in numeric order, with up to 2 LSB of noise.
+   */
+  void Simulator::adc_scan() {
+
+    static uint16_t pos     = 0;
+    static uint32_t noise   = 1;
+
+    for (uint8_t s = 0; s < 2; s++) for (uint8_t c = 0; c < ADC_SCAN_CHANNELS; c++) {
+      if (adcscan.channel_to_pin(c) == NoPin) continue;
+
+      noise = noise * 1103515245UL + 12345UL;
+      const int16_t value = int16_t(adc_read(adcscan.channel_to_pin(c))) + int16_t((noise >> 16) % 5) - 2;
+      adcscan.fill_buffer()[pos] = (uint16_t(c) << 12) | uint16_t(constrain(value, 0, 4095));
+
+      if (++pos == ADC_SCAN_SAMPLES) {
+        pos = 0;
+        adcscan.buffer_done();
+      }
+    }
+
+  }
+
+#endif // ADC_SCAN
+
+void Simulator::pin_changed(const uint8_t pin, const bool level) {
+
+  if (VirtualPins::watch[pin] & PIN_WATCH_TRACE) StepTrace::record(pin, level);
+
+  if (VirtualPins::watch[pin] & PIN_WATCH_MODEL) {
+    LOOP_XYZ(axis) {
+      axis_model_t &am = axis_model[axis];
+      Driver * const drv = driver[X_DRV + axis];
+      if (am.step_pin == pin && level != drv->isStep()) {
+        am.position += (READ(am.dir_pin) == drv->isDir()) ? -1 : 1;
+        endstops_update();
+      }
+    }
+    #if HAS_HOTENDS
+      LOOP_HOTEND() {
+        Driver * const drv = driver[E0_DRV + h];
+        if (hotend_step_pin[h] == pin && level != drv->isStep())
+          hotend_e_steps[h] += (READ(drv->data.pin.dir) == drv->isDir()) ? -1 : 1;
+      }
+    #endif
+  }
+
+}
+
+/** Private Function */
+void Simulator::endstops_update() {
+
+  #define SET_ENDSTOP(ES, TRIGGERED) do{                            \
+    const bool triggered = (TRIGGERED);                             \
+    VirtualPins::drive(ES##_PIN, triggered != endstops.isLogic(ES)); \
+  }while(0)
+
+  #define AT_MIN(A) (axis_model[A##_AXIS].position <= -axis_model[A##_AXIS].half_travel)
+  #define AT_MAX(A) (axis_model[A##_AXIS].position >=  axis_model[A##_AXIS].half_travel)
+
+  #if HAS_X_MIN
+    SET_ENDSTOP(X_MIN, AT_MIN(X));
+  #endif
+  #if HAS_X_MAX
+    SET_ENDSTOP(X_MAX, AT_MAX(X));
+  #endif
+  #if HAS_Y_MIN
+    SET_ENDSTOP(Y_MIN, AT_MIN(Y));
+  #endif
+  #if HAS_Y_MAX
+    SET_ENDSTOP(Y_MAX, AT_MAX(Y));
+  #endif
+  #if HAS_Z_MIN
+    SET_ENDSTOP(Z_MIN, AT_MIN(Z));
+  #endif
+  #if HAS_Z_MAX
+    SET_ENDSTOP(Z_MAX, AT_MAX(Z));
+  #endif
+  #if HAS_Z_PROBE_PIN
+    SET_ENDSTOP(Z_PROBE, AT_MIN(Z));
+  #endif
+
+  #undef SET_ENDSTOP
+  #undef AT_MIN
+  #undef AT_MAX
+}
+
+/**
+ * Entry point of the simulator
+ */
+int main(int argc, char** argv) {
+
+  Simulator::init(argc, argv);
+
+  setup();
+
+  Simulator::start();
+
+  // Printer::loop() never returns, it checks Simulator::finished()
+  for (;;) loop();
+
+  return 0;
+}
+
+#endif // ARDUINO_ARCH_LINUX
@@ -0,0 +1,124 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * simulator.h - Linux native simulator
+ *
+ * The firmware runs as a host process on a virtual clock. Command line:
+ *
+ *   MK4duo [-i input] [-o output] [-t trace] [-s sdcard.img] [-e eeprom.bin]
+ *          [-b report] [-l seconds] [-u] [-r] [-q]
+ *
+ *   -i  G-code received on the serial port (default standard input)
+ *   -o  Serial output of the firmware (default standard output)
+ *   -t  Binary trace of every step and dir edge, see steptrace.h
+ *   -s  Raw image of the SD card (FAT16/FAT32, with or without partition table)
+ *   -e  EEPROM image, loaded at start and written by M500
+ *   -b  Motion benchmark report, see motion_bench.h ("-" for standard error)
+ *   -l  Stop after this amount of virtual seconds
+ *   -u  Unlimited serial line speed, the input is never the bottleneck
+ *   -r  Real time, the virtual clock does not run ahead of the wall clock
+ *   -q  Quiet, no summary on the standard error at exit
+ *
+ * The simulator exits when the input is over and every command has been
+ * executed and every move has been stepped.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+class Simulator {
+
+  public: /** Constructor */
+
+    Simulator() {}
+
+  public: /** Public Parameters */
+
+    enum ExitEnum : uint8_t {
+      EXIT_DONE,
+      EXIT_TIME_LIMIT,
+      EXIT_KILLED,
+      EXIT_WATCHDOG,
+      EXIT_RESET,
+      EXIT_ERROR
+    };
+
+    static const char *eeprom_file,
+                      *sdcard_file;
+
+  private: /** Private Parameters */
+
+    static FILE *input,
+                *output;
+
+    static bool unlimited_speed,
+                real_time,
+                quiet,
+                input_eof;
+
+    static uint64_t time_limit_ticks;
+
+  public: /** Public Function */
+
+    // Parse the command line and open the files
+    static void init(int argc, char** argv);
+
+    // Firmware is set up, attach the models to the pins
+    static void start();
+
+    // Check if the job is complete, called by the main loop
+    static bool finished();
+
+    // G-code still waiting to be executed
+    static bool input_pending();
+
+    // Models update, called by HAL::Tick every millisecond
+    static void spin();
+
+    // Close everything and exit the process
+    static void terminate(const ExitEnum code);
+
+    // Host side of the serial port
+    static bool host_available();
+    static int  host_read();
+    static void host_write(const uint8_t c);
+    static void host_flush();
+
+    FORCE_INLINE static bool unlimited_line_speed() { return unlimited_speed; }
+
+    // ADC reading of an analog pin, from the thermal models
+    static uint16_t adc_read(const pin_t pin);
+
+    #if ENABLED(ADC_SCAN)
+      // Converter of the ADC scan, called by spin()
+      static void adc_scan();
+    #endif
+
+    // A watched output pin changed level
+    static void pin_changed(const uint8_t pin, const bool level);
+
+  private: /** Private Function */
+
+    static void endstops_update();
+
+};
@@ -0,0 +1,117 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * steptrace.cpp - Step and dir edges timeline of the Linux native simulator
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+#include "steptrace.h"
+
+struct __attribute__((packed)) trace_record_t {
+  uint64_t  tick;
+  uint8_t   pin,
+            level;
+};
+
+FILE            *StepTrace::file      = nullptr;
+uint8_t         StepTrace::channels   = 0;
+trace_channel_t StepTrace::channel[STEPTRACE_MAX_CHANNELS];
+uint64_t        StepTrace::records    = 0;
+
+bool StepTrace::open(const char * const filename) {
+  file = fopen(filename, "wb");
+  if (file) setvbuf(file, nullptr, _IOFBF, 1 << 20);
+  return file != nullptr;
+}
+
+void StepTrace::close() {
+  if (file) {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+void StepTrace::add_channel(Driver * const drv) {
+  const pin_t step_pin = drv->data.pin.step,
+              dir_pin  = drv->data.pin.dir;
+  if (channels >= STEPTRACE_MAX_CHANNELS || !WITHIN(step_pin, 0, NUM_DIGITAL_PINS - 1) || !WITHIN(dir_pin, 0, NUM_DIGITAL_PINS - 1)) return;
+  trace_channel_t &ch = channel[channels++];
+  ch.drv      = drv;
+  ch.step_pin = step_pin;
+  ch.dir_pin  = dir_pin;
+  ch.pulses   = 0;
+}
+
+void StepTrace::start() {
+
+  for (uint8_t c = 0; c < channels; c++) {
+    VirtualPins::watch[channel[c].step_pin] |= PIN_WATCH_TRACE;
+    VirtualPins::watch[channel[c].dir_pin]  |= PIN_WATCH_TRACE;
+  }
+
+  if (!file) return;
+
+  const uint32_t timer_rate = HAL_TIMER_RATE;
+  fwrite("MK4DTRC1", 1, 8, file);
+  fwrite(&timer_rate, sizeof(timer_rate), 1, file);
+  fwrite(&channels, sizeof(channels), 1, file);
+
+  for (uint8_t c = 0; c < channels; c++) {
+    const trace_channel_t &ch = channel[c];
+    char name[4] = { 0 };
+    strncpy(name, ch.drv->axis_letter, sizeof(name) - 1);
+    const uint8_t pins[4] = { ch.step_pin, ch.dir_pin, VirtualPins::level[ch.step_pin], VirtualPins::level[ch.dir_pin] };
+    fwrite(name, 1, sizeof(name), file);
+    fwrite(pins, 1, sizeof(pins), file);
+  }
+}
+
+void StepTrace::record(const uint8_t pin, const bool level) {
+
+  // Count the active edges of the step pins
+  for (uint8_t c = 0; c < channels; c++) {
+    if (channel[c].step_pin == pin && level != channel[c].drv->isStep()) {
+      channel[c].pulses++;
+      break;
+    }
+  }
+
+  if (!file) return;
+  const trace_record_t rec = { VirtualClock::ticks, pin, level };
+  fwrite(&rec, sizeof(rec), 1, file);
+  records++;
+}
+
+void StepTrace::print_summary(FILE * const out) {
+  if (!channels) return;
+  fprintf(out, "Step pulses:");
+  for (uint8_t c = 0; c < channels; c++)
+    fprintf(out, " %s:%u", channel[c].drv->axis_letter, channel[c].pulses);
+  fprintf(out, "\nTrace records: %llu\n", (unsigned long long)records);
+}
+
+#endif // ARDUINO_ARCH_LINUX
@@ -0,0 +1,90 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * steptrace.h - Step and dir edges timeline of the Linux native simulator
+ *
+ * File format, little endian:
+ *
+ *   Header:
+ *     char     magic[8]      "MK4DTRC1"
+ *     uint32   timer_rate    Ticks per second of the time stamps
+ *     uint8    channels      Number of channels
+ *   For every channel:
+ *     char     name[4]       Axis letter of the driver, zero padded
+ *     uint8    step_pin
+ *     uint8    dir_pin
+ *     uint8    step_level    Level of the pins when the trace starts
+ *     uint8    dir_level
+ *   Records, until the end of the file:
+ *     uint64   tick          Virtual time of the edge
+ *     uint8    pin
+ *     uint8    level
+ *
+ * buildroot/bin/steptrace decodes the file.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#define STEPTRACE_MAX_CHANNELS  MAX_DRIVER
+
+struct trace_channel_t {
+  Driver      *drv;
+  uint8_t     step_pin,
+              dir_pin;
+  uint32_t    pulses;
+};
+
+class StepTrace {
+
+  public: /** Constructor */
+
+    StepTrace() {}
+
+  private: /** Private Parameters */
+
+    static FILE *file;
+
+    static uint8_t channels;
+
+    static trace_channel_t channel[STEPTRACE_MAX_CHANNELS];
+
+    static uint64_t records;
+
+  public: /** Public Function */
+
+    static bool open(const char * const filename);
+    static void close();
+
+    FORCE_INLINE static bool is_open() { return file != nullptr; }
+
+    // Register a driver, then write the header once every driver is known
+    static void add_channel(Driver * const drv);
+    static void start();
+
+    // Edge of a traced pin, step pulses are counted even without a file
+    static void record(const uint8_t pin, const bool level);
+
+    static void print_summary(FILE * const out);
+
+};
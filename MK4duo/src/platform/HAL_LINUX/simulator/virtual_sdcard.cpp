@@ -0,0 +1,291 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * virtual_sdcard.cpp - SD card of the Linux native simulator
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+#include "virtual_sdcard.h"
+
+#define SD_BLOCK_SIZE   512
+
+// R1 response
+#define R1_READY        0x00
+#define R1_IDLE         0x01
+#define R1_ILLEGAL      0x04
+#define R1_PARAM_ERROR  0x40
+
+// Data tokens
+#define TOKEN_START_BLOCK     0xFE
+#define TOKEN_WRITE_MULTIPLE  0xFC
+#define TOKEN_STOP_TRAN       0xFD
+#define DATA_RES_ACCEPTED     0x05
+
+FILE                        *VirtualSdCard::image         = nullptr;
+uint32_t                    VirtualSdCard::blocks         = 0;
+VirtualSdCard::SdStateEnum  VirtualSdCard::state          = SD_IDLE;
+bool                        VirtualSdCard::app_command    = false,
+                            VirtualSdCard::write_multiple = false,
+                            VirtualSdCard::read_gap       = false;
+uint32_t                    VirtualSdCard::block_number   = 0;
+uint8_t                     VirtualSdCard::command[6],
+                            VirtualSdCard::command_len    = 0;
+uint8_t                     VirtualSdCard::data[512 + 2];
+uint16_t                    VirtualSdCard::data_len       = 0;
+uint8_t                     VirtualSdCard::queue[1 + 4 + 1 + 512 + 2],
+                            *VirtualSdCard::queue_pos     = VirtualSdCard::queue,
+                            *VirtualSdCard::queue_end     = VirtualSdCard::queue;
+
+bool VirtualSdCard::open(const char * const filename) {
+  image = fopen(filename, "r+b");
+  if (!image) return false;
+  fseek(image, 0, SEEK_END);
+  blocks = uint32_t(ftell(image) / SD_BLOCK_SIZE);
+  // The CSD counts the capacity in units of 512 KB
+  if (blocks < 1024) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void VirtualSdCard::close() {
+  if (image) {
+    fclose(image);
+    image = nullptr;
+  }
+}
+
+uint8_t VirtualSdCard::transfer(const uint8_t in) {
+
+  if (!image) return 0xFF;
+
+  // Next block of a multiple read, after a busy byte like a real card
+  if (state == SD_READ_MULTIPLE && queue_pos == queue_end) {
+    if ((read_gap = !read_gap)) {
+      queue_pos = queue_end = queue;
+      if (block_number < blocks && read_block(block_number++, data)) {
+        push(TOKEN_START_BLOCK);
+        push_block(data, SD_BLOCK_SIZE + 2);
+      }
+      else
+        push(0x09); // Data error token: out of range
+    }
+  }
+
+  const uint8_t out = queue_pos < queue_end ? *queue_pos++ : 0xFF;
+
+  switch (state) {
+
+    case SD_WRITE_TOKEN:
+      if (in == TOKEN_START_BLOCK || (write_multiple && in == TOKEN_WRITE_MULTIPLE)) {
+        state = SD_WRITE_DATA;
+        data_len = 0;
+      }
+      else if (write_multiple && in == TOKEN_STOP_TRAN) {
+        state = SD_IDLE;
+        response(R1_READY); // busy byte, then ready
+      }
+      break;
+
+    case SD_WRITE_DATA:
+      data[data_len++] = in;
+      if (data_len == SD_BLOCK_SIZE + 2) {
+        const bool ok = block_number < blocks && write_block(block_number++, data);
+        queue_pos = queue_end = queue;
+        push(ok ? DATA_RES_ACCEPTED : 0x0D);  // Accepted or write error
+        push(0x00);                           // Busy
+        state = (ok && write_multiple) ? SD_WRITE_TOKEN : SD_IDLE;
+      }
+      break;
+
+    default:
+      // Command frame: 01xxxxxx, 4 bytes of argument, CRC
+      if (command_len || (in & 0xC0) == 0x40) {
+        command[command_len++] = in;
+        if (command_len == sizeof(command)) {
+          command_len = 0;
+          execute();
+        }
+      }
+      break;
+  }
+
+  return out;
+}
+
+/** Private Function */
+void VirtualSdCard::execute() {
+
+  const uint8_t   cmd = command[0] & 0x3F;
+  const uint32_t  arg = (uint32_t(command[1]) << 24) | (uint32_t(command[2]) << 16) | (uint32_t(command[3]) << 8) | command[4];
+  const bool      acmd = app_command;
+
+  app_command = false;
+  queue_pos = queue_end = queue;
+
+  if (acmd) {
+    switch (cmd) {
+      case 41:  // SD_SEND_OP_COND
+      case 23:  // SET_WR_BLK_ERASE_COUNT
+        response(R1_READY);
+        return;
+      case 13:  // SD_STATUS is not supported
+      default:
+        response(R1_ILLEGAL);
+        return;
+    }
+  }
+
+  switch (cmd) {
+
+    case 0:   // GO_IDLE_STATE
+      state = SD_IDLE;
+      response(R1_IDLE);
+      break;
+
+    case 8:   // SEND_IF_COND, echo of the check pattern
+      response(R1_IDLE);
+      push(0x00); push(0x00); push(0x01); push(arg & 0xFF);
+      break;
+
+    case 9: { // SEND_CSD, version 2.0
+      uint8_t csd[16 + 2] = { 0 };
+      const uint32_t c_size = blocks / 1024 - 1;
+      csd[0]  = 0x40;
+      csd[3]  = 0x32;   // 25 MHz
+      csd[4]  = 0x5B;
+      csd[5]  = 0x59;   // Read block length 512
+      csd[7]  = (c_size >> 16) & 0x3F;
+      csd[8]  = (c_size >> 8) & 0xFF;
+      csd[9]  = c_size & 0xFF;
+      csd[10] = 0x7F;   // Erase single block enable, sector size
+      csd[11] = 0x80;
+      csd[12] = 0x0A;   // Write block length 512
+      csd[13] = 0x40;
+      csd[15] = 0x01;
+      response(R1_READY);
+      push(TOKEN_START_BLOCK);
+      push_block(csd, sizeof(csd));
+    } break;
+
+    case 10: { // SEND_CID
+      uint8_t cid[16 + 2] = { 0x03, 'M', 'K', 'M', 'K', '4', 'D', 'U', 0x10, 0, 0, 0, 1, 0x01, 0x3C, 0x01 };
+      response(R1_READY);
+      push(TOKEN_START_BLOCK);
+      push_block(cid, sizeof(cid));
+    } break;
+
+    case 12:  // STOP_TRANSMISSION
+      state = SD_IDLE;
+      response(R1_READY);
+      break;
+
+    case 13:  // SEND_STATUS, R2
+      response(R1_READY);
+      push(0x00);
+      break;
+
+    case 16:  // SET_BLOCKLEN
+    case 59:  // CRC_ON_OFF
+      response(R1_READY);
+      break;
+
+    case 17:  // READ_SINGLE_BLOCK
+      if (arg < blocks && read_block(arg, data)) {
+        response(R1_READY);
+        push(TOKEN_START_BLOCK);
+        push_block(data, SD_BLOCK_SIZE + 2);
+      }
+      else
+        response(R1_PARAM_ERROR);
+      break;
+
+    case 18:  // READ_MULTIPLE_BLOCK
+      if (arg < blocks) {
+        response(R1_READY);
+        state = SD_READ_MULTIPLE;
+        block_number = arg;
+        read_gap = true;
+      }
+      else
+        response(R1_PARAM_ERROR);
+      break;
+
+    case 24:  // WRITE_BLOCK
+    case 25:  // WRITE_MULTIPLE_BLOCK
+      if (arg < blocks) {
+        response(R1_READY);
+        state = SD_WRITE_TOKEN;
+        write_multiple = cmd == 25;
+        block_number = arg;
+      }
+      else
+        response(R1_PARAM_ERROR);
+      break;
+
+    case 55:  // APP_CMD
+      app_command = true;
+      response(R1_READY);
+      break;
+
+    case 58:  // READ_OCR, powered up and high capacity
+      response(R1_READY);
+      push(0xC0); push(0xFF); push(0x80); push(0x00);
+      break;
+
+    default:
+      response(R1_ILLEGAL);
+      break;
+  }
+
+}
+
+// The first byte after a command is a fill byte
+void VirtualSdCard::response(const uint8_t r1) {
+  push(0xFF);
+  push(r1);
+}
+
+void VirtualSdCard::push_block(const uint8_t * const buf, const uint16_t len) {
+  memcpy(queue_end, buf, len);
+  queue_end += len;
+}
+
+bool VirtualSdCard::read_block(const uint32_t block, uint8_t * const buf) {
+  if (fseek(image, long(block) * SD_BLOCK_SIZE, SEEK_SET)) return false;
+  if (fread(buf, SD_BLOCK_SIZE, 1, image) != 1) return false;
+  buf[SD_BLOCK_SIZE] = buf[SD_BLOCK_SIZE + 1] = 0;  // CRC is not checked
+  return true;
+}
+
+bool VirtualSdCard::write_block(const uint32_t block, const uint8_t * const buf) {
+  if (fseek(image, long(block) * SD_BLOCK_SIZE, SEEK_SET)) return false;
+  return fwrite(buf, SD_BLOCK_SIZE, 1, image) == 1 && fflush(image) == 0;
+}
+
+#endif // ARDUINO_ARCH_LINUX
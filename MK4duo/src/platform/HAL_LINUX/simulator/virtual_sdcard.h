@@ -0,0 +1,89 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * virtual_sdcard.h - SD card of the Linux native simulator
+ *
+ * A raw image file seen as an SDHC card on the SPI bus. The card speaks
+ * the SPI mode protocol byte by byte, so SdFat runs unchanged on top of it.
+ * Without an image the card never answers, like an empty socket.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+class VirtualSdCard {
+
+  public: /** Constructor */
+
+    VirtualSdCard() {}
+
+  private: /** Private Parameters */
+
+    enum SdStateEnum : uint8_t {
+      SD_IDLE,
+      SD_READ_MULTIPLE,
+      SD_WRITE_TOKEN,
+      SD_WRITE_DATA
+    };
+
+    static FILE *image;
+
+    static uint32_t blocks;
+
+    static SdStateEnum state;
+
+    static bool app_command,
+                write_multiple,
+                read_gap;
+
+    static uint32_t block_number;
+
+    static uint8_t  command[6],
+                    command_len;
+
+    static uint8_t  data[512 + 2];
+    static uint16_t data_len;
+
+    // Bytes the card sends out on the next transfers
+    static uint8_t  queue[1 + 4 + 1 + 512 + 2],
+                    *queue_pos,
+                    *queue_end;
+
+  public: /** Public Function */
+
+    static bool open(const char * const filename);
+    static void close();
+
+    // Exchange a byte on the SPI bus
+    static uint8_t transfer(const uint8_t in);
+
+  private: /** Private Function */
+
+    static void execute();
+    static void response(const uint8_t r1);
+    static void push(const uint8_t b) { *queue_end++ = b; }
+    static void push_block(const uint8_t * const buf, const uint16_t len);
+    static bool read_block(const uint32_t block, uint8_t * const buf);
+    static bool write_block(const uint32_t block, const uint8_t * const buf);
+
+};
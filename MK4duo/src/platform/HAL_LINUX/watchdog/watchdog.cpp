@@ -0,0 +1,70 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_LINUX
+
+#include "../../../../MK4duo.h"
+#include "watchdog.h"
+
+millis_l  Watchdog::timeout_ms    = 0,
+          Watchdog::last_reset_ms = 0;
+
+void Watchdog::init(void) {
+  #if ENABLED(USE_WATCHDOG)
+    timeout_ms = 4000;
+    reset();
+  #endif
+}
+
+void Watchdog::reset(void) {
+  // The kill loop feeds the watchdog forever with the interrupts disabled
+  static uint32_t masked_resets = 0;
+  if (!ISRS_ENABLED()) {
+    if (++masked_resets > 100000UL) Simulator::terminate(Simulator::EXIT_KILLED);
+  }
+  else
+    masked_resets = 0;
+  last_reset_ms = millis();
+}
+
+void Watchdog::enable(uint32_t timeout) {
+  #if ENABLED(USE_WATCHDOG)
+    timeout_ms = MAX(timeout, 1UL);
+    reset();
+  #else
+    UNUSED(timeout);
+    HAL::resetHardware();
+  #endif
+}
+
+void Watchdog::check(void) {
+  if (timeout_ms && millis() - last_reset_ms > timeout_ms) {
+    #if ENABLED(WATCHDOG_RESET_MANUAL)
+      SERIAL_LM(ER, "Watchdog timeout!");
+    #endif
+    Simulator::terminate(Simulator::EXIT_WATCHDOG);
+  }
+}
+
+Watchdog watchdog;
+
+#endif // ARDUINO_ARCH_LINUX
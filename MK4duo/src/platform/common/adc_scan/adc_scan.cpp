@@ -0,0 +1,97 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * adc_scan.cpp
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(ADC_SCAN)
+
+AdcScan adcscan;
+
+/** Public Parameters */
+uint16_t AdcScan::buffer[ADC_SCAN_BUFFERS][ADC_SCAN_SAMPLES];
+
+/** Private Parameters */
+volatile uint8_t AdcScan::filled = 0;
+uint8_t AdcScan::averaged = 0;
+
+pin_t AdcScan::channel_pin[ADC_SCAN_CHANNELS];
+
+/** Public Function */
+void AdcScan::init() {
+  for (uint8_t c = 0; c < ADC_SCAN_CHANNELS; c++) channel_pin[c] = NoPin;
+  filled = averaged = 0;
+}
+
+void AdcScan::set_channel(const uint8_t channel, const pin_t pin) {
+  if (channel < ADC_SCAN_CHANNELS) channel_pin[channel] = pin;
+}
+
+bool AdcScan::update() {
+
+  const uint8_t last = filled;
+  uint8_t count = last - averaged;
+  if (!count) return false;
+
+  // The older buffers may be filled again already
+  NOMORE(count, ADC_SCAN_BUFFERS - 2);
+
+  uint32_t  sum[ADC_SCAN_CHANNELS]  = { 0 };
+  uint16_t  n[ADC_SCAN_CHANNELS]    = { 0 };
+
+  const uint8_t first = last - count;
+  for (uint8_t b = first; b != last; b++) {
+    const uint16_t * const samples = buffer[b % ADC_SCAN_BUFFERS];
+    for (uint16_t i = 0; i < ADC_SCAN_SAMPLES; i++) {
+      const uint16_t s = samples[i];
+      const uint8_t c = ADC_SCAN_CHANNEL(s);
+      sum[c] += ADC_SCAN_VALUE(s);
+      n[c]++;
+    }
+  }
+
+  averaged = last;
+
+  // The hardware came back to the first buffer while it was read, the next call reads newer ones
+  if (uint8_t(filled - first) >= ADC_SCAN_BUFFERS) return false;
+
+  // The mean keeps the bits below the converter resolution
+  for (uint8_t c = 0; c < ADC_SCAN_CHANNELS; c++)
+    if (n[c] && channel_pin[c] != NoPin)
+      HAL::AnalogInputValues[channel_pin[c]] = (sum[c] << (OVERSAMPLENR)) / n[c];
+
+  #if HAS_MCU_TEMPERATURE
+    thermalManager.mcu_current_temperature_raw = HAL::AnalogInputValues[ADC_TEMPERATURE_SENSOR];
+  #endif
+
+  HAL::Analog_is_ready = true;
+  thermalManager.set_current_temp_raw();
+
+  return true;
+}
+
+#endif // ADC_SCAN
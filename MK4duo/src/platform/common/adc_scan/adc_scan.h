@@ -0,0 +1,91 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * adc_scan.h
+ *
+ * The converter scans the analog inputs without stop and stores the
+ * samples in a ring of buffers, each sample with its channel in the bits
+ * 12 to 15. The HAL fills the buffers, on Arduino DUE with the PDC, on
+ * the native simulator from the thermal models.
+ *
+ * update() runs in the temperature task: it averages the buffers filled
+ * since the last call, all together, and sets the raw sensor values.
+ * The averages are dropped if the hardware came back to one of those
+ * buffers while they were read.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(ADC_SCAN)
+
+// Buffers of the ring: one is filled, one is queued, the others can be read
+#define ADC_SCAN_BUFFERS  4
+#define ADC_SCAN_CHANNELS 16
+
+// Sample of the converter, with its channel tag
+#define ADC_SCAN_CHANNEL(S) ((S) >> 12)
+#define ADC_SCAN_VALUE(S)   ((S) & 0x0FFF)
+
+class AdcScan {
+
+  public: /** Constructor */
+
+    AdcScan() {}
+
+  public: /** Public Parameters */
+
+    static uint16_t buffer[ADC_SCAN_BUFFERS][ADC_SCAN_SAMPLES];
+
+  private: /** Private Parameters */
+
+    static volatile uint8_t filled;       // Buffers filled, modulo 256
+    static uint8_t          averaged;     // Buffers averaged, modulo 256
+
+    static pin_t            channel_pin[ADC_SCAN_CHANNELS];
+
+  public: /** Public Function */
+
+    static void init();
+
+    // The analog pin of a channel, NoPin to ignore its samples
+    static void set_channel(const uint8_t channel, const pin_t pin);
+    FORCE_INLINE static pin_t channel_to_pin(const uint8_t channel) { return channel_pin[channel]; }
+
+    // The buffer the hardware fills now
+    FORCE_INLINE static uint16_t* fill_buffer() { return buffer[filled % ADC_SCAN_BUFFERS]; }
+
+    // Called by the hardware when a buffer is full, returns the buffer to queue after the next one
+    FORCE_INLINE static uint16_t* buffer_done() {
+      filled++;
+      return buffer[uint8_t(filled + 1) % ADC_SCAN_BUFFERS];
+    }
+
+    // Average the buffers filled since the last call, false if there was none
+    static bool update();
+
+};
+
+extern AdcScan adcscan;
+
+#endif // ADC_SCAN
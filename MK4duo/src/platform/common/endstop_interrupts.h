@@ -30,6 +30,8 @@ void endstop_ISR(void) { endstops.update(); }
   #include "../HAL_AVR/endstop_interrupts.h"
 #elif ENABLED(ARDUINO_ARCH_SAM)
   #include "../HAL_DUE/endstop_interrupts.h"
+#elif ENABLED(ARDUINO_ARCH_LINUX)
+  #include "../HAL_LINUX/endstop_interrupts.h"
 #else
   #error "Unsupported Platform!"
 #endif
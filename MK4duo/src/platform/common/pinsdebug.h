@@ -27,6 +27,8 @@
   #include "../HAL_DUE/pinsdebug.h"
 #elif ENABLED(__AVR__)
   #include "../HAL_AVR/pinsdebug.h"
+#elif ENABLED(ARDUINO_ARCH_LINUX)
+  #include "../HAL_LINUX/pinsdebug.h"
 #else
   #error "Unsupported Platform!"
 #endif
@@ -28,6 +28,7 @@
  *    __AVR__           : For all Atmel AVR boards
  *    ARDUINO_ARCH_SAM  : For Arduino Due and other boards based on Atmel SAM3X8E
  *    ARDUINO_ARCH_SAMD : For Arduino Due and other boards based on Atmel SAMD21J18
+ *    ARDUINO_ARCH_LINUX: For the native simulator, built with the host compiler
  *
  */
 
@@ -50,6 +51,19 @@
   #define CPU_32_BIT
   #include "HAL_SAMD/spi_pins.h"
   #include "HAL_SAMD/HAL.h"
+#elif ENABLED(ARDUINO_ARCH_LINUX)
+  #define CPU_32_BIT
+  #include "HAL_LINUX/spi_pins.h"
+  #include "HAL_LINUX/HAL.h"
 #else
   #error "Unsupported Platform!"
 #endif
+
+#include "common/adc_scan/adc_scan.h"
+
+// Motion benchmark probes, only the native simulator measures them
+#ifndef MOTION_PROBE
+  #define MOTION_PROBE(P)       NOOP
+  #define MOTION_BLOCK_START(B) NOOP
+  #define MOTION_BLOCK_QUEUED() NOOP
+#endif
@@ -41,6 +41,10 @@ int SDCard::autostart_index = -1;
 uint32_t  SDCard::fileSize  = 0,
           SDCard::sdpos     = 0;
 
+#if ENABLED(BINARY_STREAM)
+  uint32_t SDCard::upload_pos = 0;
+#endif
+
 float SDCard::objectHeight      = 0.0,
       SDCard::firstlayerHeight  = 0.0,
       SDCard::layerHeight       = 0.0,
@@ -105,6 +109,21 @@ LsActionEnum SDCard::lsAction   = LS_Count;
 
 #endif // SDCARD_SORT_ALPHA
 
+#if ENABLED(SD_BLOCK_READ)
+  uint8_t   SDCard::read_buffer[SD_READ_BUFFERS][SD_READ_BLOCK_SIZE];
+  uint16_t  SDCard::read_len[SD_READ_BUFFERS] = { 0 },
+            SDCard::read_index    = 0;
+  uint32_t  SDCard::read_pos[SD_READ_BUFFERS] = { 0 },
+            SDCard::read_next     = 0;
+  uint8_t   SDCard::read_active   = 0,
+            SDCard::read_loaded   = 0;
+#endif
+
+#if ENABLED(BINARY_STREAM)
+  uint8_t   SDCard::write_buffer[SD_WRITE_BLOCK_SIZE];
+  uint16_t  SDCard::write_start = 0;
+#endif
+
 #if ENABLED(ADVANCED_SD_COMMAND)
 
   Sd2Card   SDCard::sd;
@@ -330,6 +349,67 @@ void SDCard::finishWrite() {
   SERIAL_EM(MSG_SD_FILE_SAVED);
 }
 
+#if ENABLED(BINARY_STREAM)
+
+  bool SDCard::startUpload(char * filename, const bool resume) {
+    if (!isDetected()) return false;
+
+    fat.chdir();
+    if (!gcode_file.open(filename, O_WRITE | O_CREAT | (resume ? O_AT_END : O_TRUNC))) {
+      SERIAL_LMT(ER, MSG_SD_OPEN_FILE_FAIL, filename);
+      return false;
+    }
+
+    // The raw data could look as an emergency command
+    #if ENABLED(EMERGENCY_PARSER)
+      emergency_parser.disable();
+    #endif
+
+    upload_pos = gcode_file.fileSize();
+    write_start = upload_pos % SD_WRITE_BLOCK_SIZE;
+    SERIAL_EMT(MSG_SD_WRITE_TO_FILE, filename);
+    lcdui.set_status(filename);
+    return true;
+  }
+
+  bool SDCard::upload(const uint8_t * data, uint16_t nbyte) {
+    gcode_file.clearWriteError();
+    while (nbyte) {
+      const uint16_t index = upload_pos % SD_WRITE_BLOCK_SIZE,
+                     count = MIN(nbyte, uint16_t(SD_WRITE_BLOCK_SIZE - index));
+      memcpy(&write_buffer[index], data, count);
+      data += count;
+      nbyte -= count;
+      upload_pos += count;
+      // A whole block goes straight to its sector, not through the cache
+      if (index + count == SD_WRITE_BLOCK_SIZE) {
+        gcode_file.write(&write_buffer[write_start], SD_WRITE_BLOCK_SIZE - write_start);
+        write_start = 0;
+        if (gcode_file.getWriteError()) {
+          SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void SDCard::finishUpload() {
+    const uint16_t index = upload_pos % SD_WRITE_BLOCK_SIZE;
+    gcode_file.clearWriteError();
+    if (index > write_start) gcode_file.write(&write_buffer[write_start], index - write_start);
+    write_start = index;
+    if (gcode_file.getWriteError()) SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+    gcode_file.sync();
+    gcode_file.close();
+    #if ENABLED(EMERGENCY_PARSER)
+      emergency_parser.enable();
+    #endif
+    SERIAL_EM(MSG_SD_FILE_SAVED);
+  }
+
+#endif // BINARY_STREAM
+
 void SDCard::makeDirectory(char * filename) {
   if (!isDetected()) return;
   setPrinting(false);
@@ -470,6 +550,9 @@ bool SDCard::selectFile(PGM_P filename, const bool silent/*=false*/) {
 
     fileSize = gcode_file.fileSize();
     sdpos = 0;
+    #if ENABLED(SD_BLOCK_READ)
+      reset_read(0);
+    #endif
 
     if (!silent) {
       SERIAL_MT(MSG_SD_FILE_OPENED, fname);
@@ -788,6 +871,78 @@ uint16_t SDCard::get_num_Files() {
 
 #endif // SDCARD_SORT_ALPHA
 
+#if ENABLED(SD_BLOCK_READ)
+
+  uint16_t SDCard::get_run(const char* &run) {
+
+    if ((!read_loaded || read_index >= read_len[read_active]) && !next_buffer()) return 0;
+
+    const uint8_t * const start = &read_buffer[read_active][read_index],
+                  * const end   = &read_buffer[read_active][read_len[read_active]];
+    const uint8_t *p = start;
+
+    #define SD_RUN_END(C) ((C) == '\0' || (C) == '\n' || (C) == '\r' || (C) == '#' || (C) == ':' || (C) == ';')
+
+    #if ENABLED(CPU_32_BIT)
+
+      // A word at a time: a byte equal to C makes a zero byte in W ^ C
+      #define SD_ZERO_BYTE(W)   (((W) - 0x01010101UL) & ~(W) & 0x80808080UL)
+      #define SD_HAS_BYTE(W,C)  SD_ZERO_BYTE((W) ^ (0x01010101UL * uint8_t(C)))
+
+      while (p < end && (uintptr_t(p) & 3) && !SD_RUN_END(*p)) p++;
+      if (p < end && !(uintptr_t(p) & 3)) {
+        for (; p + 4 <= end; p += 4) {
+          uint32_t w;
+          memcpy(&w, p, sizeof(w));
+          if (SD_ZERO_BYTE(w) || SD_HAS_BYTE(w, '\n') || SD_HAS_BYTE(w, '\r') || SD_HAS_BYTE(w, '#') || SD_HAS_BYTE(w, ':') || SD_HAS_BYTE(w, ';')) break;
+        }
+      }
+
+      #undef SD_ZERO_BYTE
+      #undef SD_HAS_BYTE
+
+    #endif
+
+    while (p < end && !SD_RUN_END(*p)) p++;
+
+    #undef SD_RUN_END
+
+    run = (const char*)start;
+    return p - start;
+  }
+
+  void SDCard::reset_read(const uint32_t pos) {
+    read_loaded = read_index = 0;
+    read_next = pos;
+  }
+
+  // Load the block after the last loaded one, the first block after a seek ends at a block boundary
+  bool SDCard::fill_buffer() {
+    if (!gcode_file.isOpen()) return false;
+    if (gcode_file.curPosition() != read_next && !gcode_file.seekSet(read_next)) return false;
+    const uint8_t b = (read_active + read_loaded) % SD_READ_BUFFERS;
+    const int16_t n = gcode_file.read(read_buffer[b], SD_READ_BLOCK_SIZE - uint16_t(read_next % SD_READ_BLOCK_SIZE));
+    if (n <= 0) return false;
+    read_pos[b] = read_next;
+    read_len[b] = n;
+    read_next += n;
+    read_loaded++;
+    return true;
+  }
+
+  // The active buffer is done, move to the next loaded one or load it now
+  bool SDCard::next_buffer() {
+    if (read_loaded) {
+      read_active = (read_active + 1) % SD_READ_BUFFERS;
+      read_loaded--;
+    }
+    if (!read_loaded && !fill_buffer()) return false;
+    read_index = 0;
+    return true;
+  }
+
+#endif // SD_BLOCK_READ
+
 #if ENABLED(ADVANCED_SD_COMMAND)
 
   void SDCard::formatSD() {
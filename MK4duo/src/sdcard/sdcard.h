@@ -61,6 +61,10 @@ class SDCard {
     static uint32_t fileSize,
                     sdpos;
 
+    #if ENABLED(BINARY_STREAM)
+      static uint32_t upload_pos;         // File position of the next byte uploaded
+    #endif
+
     static float  objectHeight,
                   firstlayerHeight,
                   layerHeight,
@@ -132,6 +136,25 @@ class SDCard {
 
     #endif // SDCARD_SORT_ALPHA
 
+    #if ENABLED(SD_BLOCK_READ)
+      // Ring of blocks of the printed file, the active one is read while the next are loaded ahead
+      #define SD_READ_BLOCK_SIZE 512
+      static uint8_t  read_buffer[SD_READ_BUFFERS][SD_READ_BLOCK_SIZE];
+      static uint16_t read_len[SD_READ_BUFFERS],  // Bytes in each buffer
+                      read_index;                 // Next byte of the active buffer
+      static uint32_t read_pos[SD_READ_BUFFERS],  // File position of each buffer
+                      read_next;                  // File position of the next block to load
+      static uint8_t  read_active,                // Buffer being read
+                      read_loaded;                // Buffers loaded, the active one included
+    #endif
+
+    #if ENABLED(BINARY_STREAM)
+      // Block of the uploaded file, the card gets whole aligned blocks
+      #define SD_WRITE_BLOCK_SIZE 512
+      static uint8_t  write_buffer[SD_WRITE_BLOCK_SIZE];
+      static uint16_t write_start;        // First byte of the buffer not on the card
+    #endif
+
     #if ENABLED(ADVANCED_SD_COMMAND)
 
       static Sd2Card  sd;
@@ -181,6 +204,16 @@ class SDCard {
     static void startWrite(char * filename, const bool silent=false);
     static void deleteFile(char * filename);
     static void finishWrite();
+
+    #if ENABLED(BINARY_STREAM)
+      /**
+       * Upload of a file in binary frames, not through the command buffer.
+       * With resume the data goes after the one already on the card.
+       */
+      static bool startUpload(char * filename, const bool resume);
+      static bool upload(const uint8_t * data, uint16_t nbyte);
+      static void finishUpload();
+    #endif
     static void makeDirectory(char * filename);
     static void closeFile();
     static void printingHasFinished();
@@ -249,10 +282,46 @@ class SDCard {
     static inline void pauseSDPrint() { setPrinting(false); }
     static inline bool isFileOpen()   { return isDetected() && gcode_file.isOpen(); }
     static inline bool isPaused()     { return isFileOpen() && !isPrinting(); }
-    static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
     static inline uint32_t getIndex() { return sdpos; }
     static inline bool eof() { return sdpos >= fileSize; }
-    static inline int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+
+    #if ENABLED(SD_BLOCK_READ)
+
+      static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); reset_read(newpos); }
+
+      static inline int16_t get() {
+        if ((!read_loaded || read_index >= read_len[read_active]) && !next_buffer()) {
+          sdpos = read_next;
+          return -1;
+        }
+        sdpos = read_pos[read_active] + read_index;
+        return read_buffer[read_active][read_index++];
+      }
+
+      /**
+       * Plain characters ahead in the read buffer, up to the next line end,
+       * comment, buffering stop or NUL. Return their count, 0 if get() must be used.
+       */
+      static uint16_t get_run(const char* &run);
+
+      // Consume a run, sdpos is the last character as after get()
+      static inline void skip(const uint16_t count) {
+        read_index += count;
+        sdpos = read_pos[read_active] + read_index - 1;
+      }
+
+      // Load one more block ahead of the reader, call it when there is time to spare
+      static inline void prefetch() {
+        if (read_loaded < SD_READ_BUFFERS && isPrinting()) fill_buffer();
+      }
+
+    #else
+
+      static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
+      static inline int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+
+    #endif
+
     static inline uint8_t percentDone() { return (isFileOpen() && fileSize) ? sdpos / ((fileSize + 99) / 100) : 0; }
     static inline void getWorkDirName() { workDir.getName(fileName, LONG_FILENAME_LENGTH); }
     static inline size_t read(void* buf, uint16_t nbyte) { return gcode_file.isOpen() ? gcode_file.read(buf, nbyte) : -1; }
@@ -267,6 +336,12 @@ class SDCard {
 
   private: /** Private Function */
 
+    #if ENABLED(SD_BLOCK_READ)
+      static void reset_read(const uint32_t pos);
+      static bool fill_buffer();
+      static bool next_buffer();
+    #endif
+
     static void lsDive(SdFile parent, PGM_P const match = NULL);
     static void parsejson(SdFile &parser_file);
     static bool findGeneratedBy(char* buf, char* genBy);
@@ -34,6 +34,8 @@
   #define MIN_STEP 0.002
   #define MAX_STEP 0.1
   #define SIGMA 0.1
+  // The first step, a power of two
+  #define FIRST_STEP 0.125
 
   /**
    * The algorithm for computing the step is loosely based on the one in Kig
@@ -41,29 +43,28 @@
    * However, we do not use the stack.
    *
    * The algorithm goes as it follows: the parameters t runs from 0.0 to
-   * 1.0 describing the curve, which is evaluated by eval_bezier(). At
-   * each iteration we have to choose a step, i.e., the increment of the
-   * t variable. By default the step of the previous iteration is taken,
-   * and then it is enlarged or reduced depending on how straight the
-   * curve locally is. The step is always clamped between MIN_STEP/2 and
-   * 2*MAX_STEP. MAX_STEP is taken at the first iteration.
+   * 1.0 describing the curve, which is followed with the forward
+   * differences of bezier_diff_t. At each iteration we have to choose a
+   * step, i.e., the increment of the t variable. By default the step of
+   * the previous iteration is taken, and then it is enlarged or reduced
+   * depending on how straight the curve locally is. The step is always a
+   * power of two between MIN_STEP/2 and 2*MAX_STEP, FIRST_STEP is taken
+   * at the first iteration, so t reaches 1.0 exactly.
    *
    * For some t, the step value is considered acceptable if the curve in
    * the interval [t, t+step] is sufficiently straight, i.e.,
    * sufficiently close to linear interpolation. In practice the
-   * following test is performed: the distance between eval_bezier(...,
-   * t+step/2) is evaluated and compared with 0.5*(eval_bezier(...,
-   * t)+eval_bezier(..., t+step)). If it is smaller than SIGMA, then the
-   * step value is considered acceptable, otherwise it is not. The code
-   * seeks to find the larger step value which is considered acceptable.
+   * distance between the curve at t+step/2 and the middle of the chord
+   * from t to t+step is compared with SIGMA. With the forward
+   * differences this distance comes from the second and third
+   * differences, without evaluating the curve. The code seeks to find
+   * the larger step value which is considered acceptable.
    *
    * At every iteration the recorded step value is considered and then
-   * iteratively halved until it becomes acceptable. If it was already
-   * acceptable in the beginning (i.e., no halving were done), then
-   * maybe it was necessary to enlarge it; then it is iteratively
-   * doubled while it remains acceptable. The last acceptable value
-   * found is taken, provided that it is between MIN_STEP and MAX_STEP
-   * and does not bring t over 1.0.
+   * iteratively halved until it becomes acceptable and does not bring t
+   * over 1.0. If it was already acceptable in the beginning (i.e., no
+   * halving were done), then maybe it was necessary to enlarge it; then
+   * it is iteratively doubled while it remains acceptable.
    *
    * Caveat: this algorithm is not perfect, since it can happen that a
    * step is considered acceptable even when the curve is not linear at
@@ -73,20 +74,39 @@
    * estimates; however, given the improbability of such configurations,
    * the mitigation offered by MIN_STEP and the small computational
    * power available on Arduino, I think it is not wise to implement it.
+   *
+   * With G5_BEZIER_CURVE the chords are queued as a curve. They join at
+   * full speed and the radius of curvature limits the speed on each of
+   * them. At the speed allowed by the radius a chord deviating s from
+   * the curve turns the speed by sqrt(8 * acceleration * s), as much as
+   * a junction deviation of s, so the deviation is kept within the
+   * junction deviation or within the jerk.
    */
   void Bezier::cubic_b_spline(const float position[NUM_AXIS], const float target[NUM_AXIS], const float offset[4], float fr_mm_s, uint8_t extruder) {
 
-    // Absolute first and second control points are recovered.
-    const float first0 = position[X_AXIS] + offset[0],
-                first1 = position[Y_AXIS] + offset[1],
-                second0 = target[X_AXIS] + offset[2],
-                second1 = target[Y_AXIS] + offset[3];
-    float t = 0.0;
+    // Absolute control points are recovered.
+    const float start[2]  = { position[X_AXIS], position[Y_AXIS] },
+                first[2]  = { position[X_AXIS] + offset[0], position[Y_AXIS] + offset[1] },
+                second[2] = { target[X_AXIS] + offset[2], target[Y_AXIS] + offset[3] },
+                end[2]    = { target[X_AXIS], target[Y_AXIS] };
+
+    #if ENABLED(G5_BEZIER_CURVE)
+      #if ENABLED(JUNCTION_DEVIATION)
+        const float sigma = MIN(SIGMA, mechanics.data.junction_deviation_mm);
+      #else
+        const float sigma = MIN(SIGMA, sq(MIN(mechanics.data.max_jerk[X_AXIS], mechanics.data.max_jerk[Y_AXIS])) / (8.0f * mechanics.data.acceleration));
+      #endif
+      planner.curve.joined = false;
+    #else
+      constexpr float sigma = SIGMA;
+    #endif
 
-    float bez_target[4];
-    bez_target[X_AXIS] = position[X_AXIS];
-    bez_target[Y_AXIS] = position[Y_AXIS];
-    float step = MAX_STEP;
+    float t = 0.0, step = FIRST_STEP;
+
+    bezier_diff_t diff;
+    diff.start(start, first, second, end, step);
+
+    float bez_target[XYZE];
 
     millis_s next_idle_ms = millis();
 
@@ -97,45 +117,30 @@
       // First try to reduce the step in order to make it sufficiently
       // close to a linear interpolation.
       bool did_reduce = false;
-      float new_t = t + step;
-      NOMORE(new_t, 1.0);
-      float new_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], new_t);
-      float new_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], new_t);
-      for (;;) {
-        if (new_t - t < (MIN_STEP)) break;
-        const float candidate_t = 0.5 * (t + new_t),
-                    candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                    candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                    interp_pos0 = 0.5 * (bez_target[X_AXIS] + new_pos0),
-                    interp_pos1 = 0.5 * (bez_target[Y_AXIS] + new_pos1);
-        if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
-        new_t = candidate_t;
-        new_pos0 = candidate_pos0;
-        new_pos1 = candidate_pos1;
+      while (step > (MIN_STEP) && (t + step > 1.0 || diff.flatness() > sigma)) {
+        diff.halve();
+        step *= 0.5;
         did_reduce = true;
       }
 
       // If we did not reduce the step, maybe we should enlarge it.
-      if (!did_reduce) for (;;) {
-        if (new_t - t > MAX_STEP) break;
-        const float candidate_t = t + 2.0 * (new_t - t);
-        if (candidate_t >= 1.0) break;
-        const float candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                    candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                    interp_pos0 = 0.5 * (bez_target[X_AXIS] + candidate_pos0),
-                    interp_pos1 = 0.5 * (bez_target[Y_AXIS] + candidate_pos1);
-        if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
-        new_t = candidate_t;
-        new_pos0 = candidate_pos0;
-        new_pos1 = candidate_pos1;
+      if (!did_reduce) {
+        while (step <= (MAX_STEP) && t + 2.0 * step <= 1.0 && diff.flatness_twice() <= sigma) {
+          diff.twice();
+          step *= 2.0;
+        }
       }
 
-      step = new_t - t;
-      t = new_t;
+      #if ENABLED(G5_BEZIER_CURVE)
+        const float start_radius = diff.radius();
+      #endif
 
-      // Compute and send new position
-      bez_target[X_AXIS] = new_pos0;
-      bez_target[Y_AXIS] = new_pos1;
+      diff.advance();
+      t += step;
+
+      // Compute and send new position, the end exactly
+      bez_target[X_AXIS] = t < 1.0 ? diff.p[0] : target[X_AXIS];
+      bez_target[Y_AXIS] = t < 1.0 ? diff.p[1] : target[Y_AXIS];
       // FIXME. The following two are wrong, since the parameter t is
       // not linear in the distance.
       bez_target[Z_AXIS] = interp(position[Z_AXIS], target[Z_AXIS], t);
@@ -149,9 +154,24 @@
         const float (&pos)[XYZE] = bez_target;
       #endif
 
+      #if ENABLED(G5_BEZIER_CURVE)
+        // The smaller radius of the ends of the chord
+        const float end_radius = diff.radius();
+        planner.curve.radius = !start_radius ? end_radius : !end_radius ? start_radius : MIN(start_radius, end_radius);
+      #endif
+
       if (!planner.buffer_line(bez_target, fr_mm_s, extruder))
         break;
+
+      #if ENABLED(G5_BEZIER_CURVE)
+        planner.curve.joined = true;
+      #endif
     }
+
+    #if ENABLED(G5_BEZIER_CURVE)
+      planner.curve.radius = 0.0f;
+      planner.curve.joined = false;
+    #endif
   }
 
 #endif // G5_BEZIER
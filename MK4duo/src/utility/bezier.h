@@ -30,6 +30,78 @@
 
 #if ENABLED(G5_BEZIER)
 
+  /**
+   * struct bezier_diff_t
+   *
+   * Forward differences of the cubic on X and Y at a step of the parameter.
+   * A step along the curve takes three additions and the step is halved
+   * or doubled rescaling the differences, so the curve is never evaluated.
+   */
+  struct bezier_diff_t {
+
+    float p[2],   // Point of the curve
+          d1[2],  // First, second and third differences
+          d2[2],
+          d3[2];
+
+    // Start at the first control point with a step
+    void start(const float p0[2], const float p1[2], const float p2[2], const float p3[2], const float step) {
+      LOOP_L_N(i, 2) {
+        const float a = 3.0f * (p1[i] - p0[i]) * step,
+                    b = 3.0f * (p0[i] - 2.0f * p1[i] + p2[i]) * sq(step),
+                    c = (p3[i] - p0[i] + 3.0f * (p1[i] - p2[i])) * sq(step) * step;
+        p[i]  = p0[i];
+        d1[i] = a + b + c;
+        d2[i] = 2.0f * b + 6.0f * c;
+        d3[i] = 6.0f * c;
+      }
+    }
+
+    FORCE_INLINE void advance() {
+      LOOP_L_N(i, 2) {
+        p[i]  += d1[i];
+        d1[i] += d2[i];
+        d2[i] += d3[i];
+      }
+    }
+
+    FORCE_INLINE void halve() {
+      LOOP_L_N(i, 2) {
+        d3[i] *= 0.125f;
+        d2[i]  = d2[i] * 0.25f - d3[i];
+        d1[i]  = (d1[i] - d2[i]) * 0.5f;
+      }
+    }
+
+    FORCE_INLINE void twice() {
+      LOOP_L_N(i, 2) {
+        d1[i]  = 2.0f * d1[i] + d2[i];
+        d2[i]  = 4.0f * (d2[i] + d3[i]);
+        d3[i] *= 8.0f;
+      }
+    }
+
+    // Distance (norm 1) of the curve from the chord at the middle of the step
+    FORCE_INLINE float flatness() const {
+      return ABS(d2[0] * 0.125f - d3[0] * 0.0625f) + ABS(d2[1] * 0.125f - d3[1] * 0.0625f);
+    }
+
+    // The same with a step twice as long
+    FORCE_INLINE float flatness_twice() const { return 0.5f * (ABS(d2[0]) + ABS(d2[1])); }
+
+    // Radius of curvature at the point, 0 on a straight curve
+    float radius() const {
+      // First and second derivatives, times the step and the step squared
+      const float v[2] = { d1[0] - d2[0] * 0.5f + d3[0] * (1.0f / 3.0f), d1[1] - d2[1] * 0.5f + d3[1] * (1.0f / 3.0f) },
+                  w[2] = { d2[0] - d3[0], d2[1] - d3[1] },
+                  cross = ABS(v[0] * w[1] - v[1] * w[0]);
+      if (cross == 0) return 0;
+      const float speed = HYPOT(v[0], v[1]);
+      return speed * speed * speed / cross;
+    }
+
+  };
+
   class Bezier {
 
     public: /** Public Parameters */
@@ -52,21 +124,6 @@
       */
       static inline float interp(float a, float b, float t) { return (1.0 - t) * a + t * b; }
 
-      static inline float eval_bezier(float a, float b, float c, float d, float t) {
-        float iab = interp(a, b, t);
-        float ibc = interp(b, c, t);
-        float icd = interp(c, d, t);
-        float iabc = interp(iab, ibc, t);
-        float ibcd = interp(ibc, icd, t);
-        float iabcd = interp(iabc, ibcd, t);
-        return iabcd;
-      }
-
-      /**
-       * We approximate Euclidean distance with the sum of the coordinates
-       * offset (so-called "norm 1"), which is quicker to compute.
-       */
-      static inline float dist1(float x1, float y1, float x2, float y2) { return ABS(x1 - x2) + ABS(y1 - y2); }
   };
 
 #endif // ENABLED(G5_BEZIER)
@@ -89,7 +89,7 @@ char* hex_word(const uint16_t w) {
 
 char* hex_address(const void * const w) {
   #if ENABLED(CPU_32_BIT)
-    (void)hex_long((uint32_t)w);
+    (void)hex_long((uint32_t)(ptr_int_t)w);
   #else
     (void)hex_word((uint16_t)w);
   #endif
@@ -119,6 +119,22 @@ void crc16(uint16_t *crc, const void * const data, uint16_t cnt) {
   }
 }
 
+void crc32(uint32_t *crc, const void * const data, uint16_t cnt) {
+  // Reflected polynomial 0xEDB88320, four bits at a time
+  static const uint32_t crc32_table[16] PROGMEM = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+  const uint8_t *ptr = (const uint8_t *)data;
+  uint32_t c = ~*crc;
+  while (cnt--) {
+    c ^= *ptr++;
+    c = (c >> 4) ^ pgm_read_dword(&crc32_table[c & 0x0F]);
+    c = (c >> 4) ^ pgm_read_dword(&crc32_table[c & 0x0F]);
+  }
+  *crc = ~c;
+}
+
 char conv[8] = { 0 };
 
 #define DIGIT(n)        ('0' + (n))
@@ -67,6 +67,9 @@ void print_hex_long(const uint32_t w, const char delimiter);
 // Crc 16 bit for eeprom check
 void crc16(uint16_t *crc, const void * const data, uint16_t cnt);
 
+// Crc 32 bit for host frames, the one of zlib. Start with 0, call again to go on.
+void crc32(uint32_t *crc, const void * const data, uint16_t cnt);
+
 // Convert uint8_t to string percentage
 char* ui8tostr4pct(const uint8_t i);
 